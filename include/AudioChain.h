@@ -0,0 +1,18 @@
+#pragma once
+
+// The firmware's audio processing chain: owns the stage instances and their
+// order. Shared by read_data_stream() and the host tools so both run exactly
+// the same processing.
+
+#include "AudioPipeline.h"
+
+class EqStage;
+
+void audioChainBegin(uint32_t sampleRate);
+AudioPipeline& audioChain();
+// Preset equalizer, for its preset bank (EqControl)
+EqStage& audioChainEq();
+
+// Electrical power into both speakers, about a one second average (0 with
+// speaker protection off); feeds the battery load estimate
+float audioChainSpeakerWatts();
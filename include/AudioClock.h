@@ -0,0 +1,56 @@
+#pragma once
+
+// I2S master clock planning. By default the ESP32 derives MCLK from the
+// 160 MHz PLL_D2 clock through an N + b/a divider (a <= 63), which cannot
+// hit 256 x 44.1 kHz exactly: the stream plays 5.5 ppm slow (33 ppm fast at
+// 96 kHz) on top of the phone's own clock drift. The audio PLL (APLL) instead has a 16-bit
+// fractional multiplier on the 40 MHz crystal:
+//   f_out = xtal * (4 + sdm2 + sdm1 / 2^8 + sdm0 / 2^16) / (2 * (oDiv + 2))
+// with the VCO (xtal times the multiplier) between 350 and 500 MHz. Used as
+// MCLK this reaches every common rate to well under 1 ppm. Revision 0
+// chips ignore sdm0 and sdm1, so there only the integer part counts. The
+// I2S driver picks its own APLL setting for the same MCLK; the firmware
+// programs these coefficients over it once the driver has started.
+// No Arduino dependencies (host-buildable).
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define AUDIO_CLOCK_XTAL_HZ         40000000.0
+#define AUDIO_CLOCK_D2_HZ           160000000.0     // PLL_D2, the default I2S source
+#define AUDIO_CLOCK_MCLK_RATIO      256             // MCLK per sample, doubled until the APLL reaches it
+#define AUDIO_CLOCK_VCO_MIN_HZ      350000000.0
+#define AUDIO_CLOCK_VCO_MAX_HZ      500000000.0
+#define AUDIO_CLOCK_MAX_ODIV        31
+#define AUDIO_CLOCK_MAX_SDM2        63
+#define AUDIO_CLOCK_DIVIDER_MAX_A   63
+
+struct ApllCoeffs {
+    uint8_t oDiv;
+    uint8_t sdm2;
+    uint8_t sdm1;
+    uint8_t sdm0;
+    double outputHz;
+};
+
+struct AudioClock {
+    uint32_t sampleRate;
+    bool apll;                  // false: PLL_D2 divider
+    uint16_t mclkRatio;         // MCLK / sample rate
+    ApllCoeffs coeffs;          // when apll
+    double errorPpm;            // rate of this setting against nominal, for an exact 40 MHz crystal
+};
+
+// Best APLL setting for the target output frequency; fractional false for
+// revision 0 chips. False if no setting keeps the VCO in range.
+bool apllCoefficients(double targetHz, ApllCoeffs& out, bool fractional = true,
+                      double xtalHz = AUDIO_CLOCK_XTAL_HZ);
+double apllOutputHz(const ApllCoeffs& coeffs, double xtalHz = AUDIO_CLOCK_XTAL_HZ);
+
+// Rate error of the default clock, MCLK = 256 x rate from the PLL_D2 divider, ppm
+double dividerErrorPpm(uint32_t sampleRate);
+
+// Picks the clock for a rate (the APLL if asked for and reachable, else the
+// divider) and keeps it for audioClock()
+const AudioClock& audioClockSelect(uint32_t sampleRate, bool useApll, bool fractional = true);
+const AudioClock& audioClock();
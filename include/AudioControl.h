@@ -0,0 +1,10 @@
+#pragma once
+
+// "dsp" serial command over the AudioChain stages:
+//   dsp                          list stages, state and parameters, and the I2S clock
+//   dsp <stage> on|off           enable or bypass a stage
+//   dsp <stage> <param> <value>  set a parameter (clamped to its range)
+// Changes to persistent stages (align) are saved in the "dsp" Preferences
+// namespace and restored by audioControlBegin().
+
+void audioControlBegin();
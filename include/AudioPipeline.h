@@ -0,0 +1,110 @@
+#pragma once
+
+// Audio processing chain between the A2DP data callback and I2S. Stages work
+// in place on planar float blocks (left/right, nominal range [-1, 1)) of at
+// most AUDIO_BLOCK_FRAMES; the pipeline converts from and to interleaved
+// 16-bit stereo around them and saturates the result. With no stage enabled
+// the data passes through untouched. No Arduino dependencies, so the same
+// chain runs in the host tools (tools/sim/audio_sim.cpp).
+//
+// process() runs on the audio task. Other tasks change stages only through
+// postParam() / postEnabled(): the new value is stored at once, and the
+// stage is reconfigured or reset by process() at the next block boundary,
+// never under a running block.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#define AUDIO_BLOCK_FRAMES      128     // frames per stage call
+#define AUDIO_MAX_STAGES        12
+
+#define AUDIO_PENDING_CONFIGURE 0x1     // parameters changed
+#define AUDIO_PENDING_RESET     0x2     // enabled: start from clean state
+
+// Tunable stage setting, changed at runtime from the "dsp" console command
+struct AudioParam {
+    const char* name;
+    float value;
+    float min;
+    float max;
+};
+
+class AudioStage {
+public:
+    virtual ~AudioStage() {}
+    virtual const char* name() const = 0;
+    // Called with the stream rate before the first block and on rate changes
+    virtual void begin(uint32_t sampleRate) { rate = sampleRate; configure(); }
+    // Clear filter state, e.g. when a new stream starts
+    virtual void reset() {}
+    virtual void process(float* left, float* right, size_t frames) = 0;
+
+    // Allocate what process() needs; called off the audio path before the stage is enabled
+    virtual void prepare() {}
+
+    int paramCount() const { return paramTotal; }
+    const AudioParam& param(int index) const { return paramTable[index]; }
+    // Clamps to the parameter's range and reconfigures; false if there is no such parameter.
+    // On the audio task, or before streaming starts; AudioPipeline::postParam() otherwise
+    bool setParam(const char* param, float value);
+    // Optional one-line runtime state for the "dsp" listing; returns the length written
+    virtual int status(char*, size_t) const { return 0; }
+
+    bool enabled = true;
+    // Parameters and on/off state changed with "dsp" are saved and restored at boot
+    bool persistent = false;
+
+protected:
+    // Recompute coefficients from the parameters and rate
+    virtual void configure() {}
+
+    AudioParam* paramTable = nullptr;
+    int paramTotal = 0;
+    uint32_t rate = 44100;
+
+    // Have the pipeline call configure() before the next block, for stage
+    // specific requests from other tasks
+    void postConfigure() { pending.fetch_or(AUDIO_PENDING_CONFIGURE); }
+
+private:
+    friend class AudioPipeline;
+    // Clamps and stores without reconfiguring
+    bool storeParam(const char* param, float value);
+
+    std::atomic<uint32_t> pending{0};   // AUDIO_PENDING_* posted for the next block
+};
+
+class AudioPipeline {
+public:
+    bool add(AudioStage& stage);
+    void begin(uint32_t sampleRate);
+    void reset();
+
+    // Interleaved 16-bit stereo; out may be the same buffer as in
+    void process(const int16_t* in, int16_t* out, size_t frames);
+
+    // From another task than process(); false if there is no such parameter
+    bool postParam(AudioStage& stage, const char* param, float value);
+    // Enabling prepares the stage here and resets it before its first block
+    void postEnabled(AudioStage& stage, bool on);
+
+    // True if any stage would touch the samples
+    bool active() const;
+
+    int count() const { return stageCount; }
+    AudioStage* stage(int index) { return index >= 0 && index < stageCount ? stages[index] : nullptr; }
+    AudioStage* find(const char* name);
+    uint32_t sampleRate() const { return rate; }
+    uint32_t clippedSamples() const { return clipped; }
+
+private:
+    void applyPending();
+
+    AudioStage* stages[AUDIO_MAX_STAGES] = {};
+    int stageCount = 0;
+    uint32_t rate = 44100;
+    uint32_t clipped = 0;
+    float left[AUDIO_BLOCK_FRAMES];
+    float right[AUDIO_BLOCK_FRAMES];
+};
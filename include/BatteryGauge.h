@@ -0,0 +1,66 @@
+#pragma once
+
+// State-of-charge estimator for the Li-ion pack behind the UPS boost module.
+// Each sample is the pack voltage plus the power drawn at that moment. The
+// voltage is corrected for the drop across the pack resistance at that load,
+// smoothed, and looked up in an 18650 rest-voltage curve. The percentage
+// only goes down while discharging and only jumps up when a charger lifts
+// the estimate clearly above it, so music dynamics do not make it flicker.
+// Levels with hysteresis drive the low-battery behaviour (volume limit,
+// warning, shutdown). No Arduino dependencies (host-buildable,
+// tools/sim/battery_sim.cpp).
+
+#include <stdint.h>
+
+#define BATTERY_LOW_PERCENT         20
+#define BATTERY_CRITICAL_PERCENT    10
+#define BATTERY_HYSTERESIS          5       // percent above a threshold before its level clears
+#define BATTERY_RISE_PERCENT        3       // estimate above the shown value that counts as charging
+#define BATTERY_LOW_VOLUME          70      // volume limit at BATTERY_LOW, percent
+#define BATTERY_CRITICAL_VOLUME     50
+
+enum BatteryLevel : uint8_t {
+    BATTERY_OK,
+    BATTERY_LOW,
+    BATTERY_CRITICAL,
+    BATTERY_EMPTY,          // latched: shut down
+};
+
+struct BatteryConfig {
+    int cells = 1;                  // in series
+    float ohms = 0.12f;             // pack and wiring resistance
+    float boostEfficiency = 0.85f;  // load watts to battery watts
+    float cutoffVolts = 3.30f;      // per cell at rest: empty
+    float brownoutVolts = 3.00f;    // per cell under load: empty regardless of the estimate
+    uint8_t emptySamples = 5;       // consecutive samples below a cutoff
+    float filterSeconds = 10;       // smoothing of the rest voltage
+};
+
+// Charge of one cell at rest, 0-100 percent
+float batteryPercentAtRest(float cellVolts);
+
+class BatteryGauge {
+public:
+    void begin(const BatteryConfig& config = BatteryConfig());
+    // True when the level changed
+    bool update(uint32_t nowMs, float packVolts, float loadWatts);
+
+    float packVolts() const { return pack; }
+    float restVolts() const { return rest; }        // per cell, load compensated and smoothed
+    float loadAmps() const { return amps; }
+    int percent() const { return shown; }
+    BatteryLevel level() const { return current; }
+    const char* levelName() const;
+    int volumeLimit() const;
+
+private:
+    BatteryConfig cfg;
+    bool started = false;
+    uint32_t lastMs = 0;
+    float pack = 0;
+    float rest = 0;
+    float amps = 0;
+    int shown = 0;
+    uint8_t belowCutoff = 0;
+    BatteryLevel current = BATTERY_OK;
+};
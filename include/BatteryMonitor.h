@@ -0,0 +1,22 @@
+#pragma once
+
+// Battery monitoring on the board's ADC pin: every BATTERY_SAMPLE_INTERVAL
+// the pack voltage is oversampled (calibrated millivolts) and fed to the
+// BatteryGauge together with the current load (system draw plus speaker
+// power from the audio chain). "battery" on the serial console prints the
+// estimate; "battery log on" streams samples for tools/sim/battery_sim.cpp.
+
+#include "BatteryGauge.h"
+
+class Adafruit_GFX;
+
+#define BATTERY_SAMPLE_INTERVAL 1000    // ms between samples
+#define BATTERY_OVERSAMPLE      64      // ADC reads averaged per sample
+#define BATTERY_WARNING_TIME    5000    // ms the low-battery notice stays on screen
+
+void batteryMonitorBegin();
+// True when the battery level changed; the caller applies the consequences
+bool batteryMonitorUpdate(unsigned long now);
+const BatteryGauge& batteryGauge();
+// 14x7 pixel battery symbol with its top-left corner at x, y; blinks when critical
+void batteryMonitorDrawIcon(Adafruit_GFX& gfx, int x, int y, unsigned long now);
@@ -0,0 +1,36 @@
+#pragma once
+
+// Second-order IIR sections (RBJ audio EQ cookbook) in transposed direct
+// form II, the building block of the audio stages. Coefficients are designed
+// off the audio path; process() is a handful of multiply-adds per sample.
+// No Arduino dependencies (host-buildable).
+
+#include <stdint.h>
+
+struct BiquadCoeffs {
+    float b0, b1, b2;
+    float a1, a2;       // a0 normalized to 1
+};
+
+BiquadCoeffs biquadLowPass(float sampleRate, float hz, float q);
+BiquadCoeffs biquadHighPass(float sampleRate, float hz, float q);
+BiquadCoeffs biquadPeaking(float sampleRate, float hz, float q, float gainDb);
+BiquadCoeffs biquadLowShelf(float sampleRate, float hz, float gainDb);
+BiquadCoeffs biquadHighShelf(float sampleRate, float hz, float gainDb);
+
+#define BIQUAD_BUTTERWORTH_Q    0.70710678f
+
+struct Biquad {
+    BiquadCoeffs c = { 1, 0, 0, 0, 0 };
+    float z1 = 0;
+    float z2 = 0;
+
+    inline float process(float x) {
+        float y = c.b0 * x + z1;
+        z1 = c.b1 * x - c.a1 * y + z2;
+        z2 = c.b2 * x - c.a2 * y;
+        return y;
+    }
+
+    void reset() { z1 = z2 = 0; }
+};
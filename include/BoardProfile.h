@@ -0,0 +1,97 @@
+#pragma once
+
+// Compile-time board profiles. Each profile is a struct of constexpr pin and
+// feature settings; the build selects one with -DBOARD_PROFILE=<name> (see the
+// environments in platformio.ini) and the rest of the firmware reads
+// Board::xxx. Components that depend on the board are templates on the
+// profile (DisplayLayout, EncoderInput, the input and display handlers in
+// main.cpp), so features a profile does not have are discarded with
+// if constexpr or an empty specialization and cost neither flash, RAM nor a
+// runtime branch.
+
+#include <stdint.h>
+
+// ESP32-DevKit V1, PCM5102A + PAM8403, two encoders, 128x64 SSD1306
+struct BoardEsp32Dev {
+    // I2S DAC (PCM5102A, line out into the PAM8403)
+    static constexpr int i2sDout = 25;
+    static constexpr int i2sBclk = 27;
+    static constexpr int i2sLrc = 26;
+    static constexpr bool i2sApll = true;                   // clock I2S from the audio PLL (exact 44.1 kHz)
+
+    // Volume encoder (push = play/pause)
+    static constexpr int encBtnR = 32;
+    static constexpr int encBtnL = 33;
+    static constexpr int encBtnB = 34;
+    static constexpr bool encInternalPullup = false;
+
+    // Track encoder (push = stop)
+    static constexpr bool hasTrackEncoder = true;
+    static constexpr int enc2BtnR = 35;
+    static constexpr int enc2BtnL = 36;
+    static constexpr int enc2BtnB = 39;
+    static constexpr bool enc2InternalPullup = false;
+
+    // SSD1306 OLED on I2C
+    static constexpr int screenWidth = 128;
+    static constexpr int screenHeight = 64;
+    static constexpr int oledReset = -1;
+    static constexpr uint8_t oledAddress = 0x3C;
+    static constexpr int i2cSda = 21;
+    static constexpr int i2cScl = 22;
+
+    // Speakers: lowest frequency the drivers reproduce usefully (virtual bass crossover)
+    static constexpr float speakerLowCutHz = 150.0f;
+
+    // Speaker protection model: 5W full-range drivers in the closed box behind the PAM8403 at 5 V
+    static constexpr float ampPeakVolts = 4.5f;             // speaker voltage at digital full scale
+    static constexpr float speakerResonanceHz = 200.0f;     // in-box resonance
+    static constexpr float speakerQtc = 1.0f;
+    static constexpr float speakerMmPerVolt = 0.35f;        // cone excursion per volt well below resonance
+    static constexpr float speakerXmaxMm = 1.0f;            // linear excursion limit
+    static constexpr float speakerOhms = 3.6f;              // voice coil DC resistance
+    static constexpr float speakerKelvinPerWatt = 25.0f;    // voice coil thermal resistance
+    static constexpr float speakerThermalSeconds = 8.0f;    // voice coil thermal time constant
+    static constexpr float speakerMaxRiseK = 60.0f;         // allowed voice coil temperature rise
+
+    // Battery: 18650 cells in parallel on the UPS boost module, pack voltage through a 100k/100k divider
+    static constexpr bool hasBattery = true;
+    static constexpr int batteryAdcPin = 4;                 // ADC2, usable because Wi-Fi is never started
+    static constexpr float batteryDivider = 2.0f;           // pack volts per ADC volt
+    static constexpr int batteryCells = 1;                  // in series
+    static constexpr float batteryOhms = 0.12f;             // cells, protection board and wiring
+    static constexpr float systemWatts = 0.9f;              // ESP32 streaming, DAC and display
+    static constexpr float boostEfficiency = 0.85f;
+    static constexpr float ampEfficiency = 0.8f;            // PAM8403 at typical levels
+};
+
+// Same wiring with the smaller 128x32 panel
+struct BoardEsp32DevOled32 : BoardEsp32Dev {
+    static constexpr int screenHeight = 32;
+};
+
+// MAX98357A amplifier board (I2S DAC with integrated class-D amplifier, same
+// I2S pins and format) with a single (volume) encoder
+struct BoardEsp32DevMax98357 : BoardEsp32Dev {
+    static constexpr bool hasTrackEncoder = false;
+    static constexpr int batteryAdcPin = 35;                // free ADC1 pin without the track encoder
+    static constexpr float ampEfficiency = 0.85f;
+};
+
+#ifndef BOARD_PROFILE
+#define BOARD_PROFILE BoardEsp32Dev
+#endif
+
+typedef BOARD_PROFILE Board;
+
+// Derived screen layout for the selected panel: 6x8 font, 10 px line pitch,
+// status and volume rows on top, remaining rows for track info
+template <typename B>
+struct DisplayLayout {
+    static constexpr int lineHeight = 10;
+    static constexpr int charsPerLine = B::screenWidth / 6;
+    static constexpr int bodyTop = 22;
+    static constexpr int bodyLines = (B::screenHeight - bodyTop + 2) / lineHeight;
+    static constexpr bool showArtist = bodyLines >= 3;
+    static constexpr bool wrapText = bodyLines >= 4;
+};
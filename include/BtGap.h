@@ -0,0 +1,8 @@
+#pragma once
+
+// Shared Bluetooth GAP event hook. ESP-IDF allows one GAP callback and the
+// A2DP library installs its own, so this one handles the events the firmware
+// asks for (remote name, RSSI) and forwards every event to the library.
+
+// Install the callback; call after the A2DP sink has started
+void btGapBegin();
@@ -0,0 +1,31 @@
+#pragma once
+
+// Classic-only Bluetooth memory mode. The firmware only uses A2DP/AVRCP, so
+// with BT_CLASSIC_ONLY the BLE part of the controller's reserved DRAM is
+// returned to the heap before the stack starts, and a share of it deepens the
+// I2S DMA buffering. Wi-Fi is kept out of the image by never referencing it;
+// the size budget check fails the build if esp_wifi symbols get linked.
+
+#include <stdint.h>
+
+#ifndef BT_CLASSIC_ONLY
+#define BT_CLASSIC_ONLY 1
+#endif
+
+#define AUDIO_DMA_BUFFER_FRAMES 512     // frames per I2S DMA buffer (the driver's dma_buf_len)
+#define AUDIO_FRAME_BYTES       4       // 16-bit stereo
+#define AUDIO_DMA_BUFFER_COUNT  8       // buffers without reclaimed memory
+#define AUDIO_DMA_BUFFER_MAX    64      // upper bound for the deepened queue
+#define AUDIO_RECLAIM_SHARE     50      // percent of reclaimed DRAM given to audio
+
+// Release BLE controller memory; returns the internal heap bytes gained.
+// Must run before the Bluetooth controller is initialized.
+uint32_t btReleaseUnusedMemory();
+
+// I2S DMA buffer count for the given amount of reclaimed memory: the base
+// count plus AUDIO_RECLAIM_SHARE of it in buffers of
+// AUDIO_DMA_BUFFER_FRAMES * AUDIO_FRAME_BYTES bytes
+int audioBufferCount(uint32_t reclaimedBytes);
+
+// Audio buffered in the DMA queue, in ms, for 16-bit stereo at sampleRate
+uint32_t audioBufferDepthMs(int bufferCount, uint32_t sampleRate);
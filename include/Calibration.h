@@ -0,0 +1,39 @@
+#pragma once
+
+// Calibration signal source: plays SignalGenerator output through the audio
+// chain and I2S in place of the phone, e.g. pink noise or a log sweep into a
+// measurement microphone while tuning the EQ for an enclosure. A task on the
+// application core generates CALIBRATION_BLOCK_FRAMES at a time and hands
+// them to the same write path as the A2DP data callback; the blocking I2S
+// write paces it. While it runs, phone audio is discarded. Levels are
+// absolute (dBFS), independent of the volume setting.
+//
+// Serial: "gen" prints the state; "gen off"; "gen <type> [numbers] [left|
+// right|both] [invert]" starts a signal, with numbers
+//   tone  [hz [dbfs]]
+//   sweep [from to seconds [dbfs]]
+//   pink  [dbfs]
+//   pulse [dbfs]
+// The calibration display page offers a list of presets: the track knob
+// picks one, its button starts and stops it.
+
+#include <stdint.h>
+#include <stddef.h>
+#include "SignalGenerator.h"
+
+class Adafruit_GFX;
+
+#define CALIBRATION_BLOCK_FRAMES    256
+
+// Write path of the A2DP data callback (interleaved 16-bit stereo)
+typedef size_t (*CalibrationWriter)(const uint8_t* data, uint32_t length);
+
+void calibrationBegin(CalibrationWriter writer);
+bool calibrationActive();
+void calibrationStart(const SignalSettings& settings);
+void calibrationStop();
+
+// Display page: select a preset (-1/+1), start or stop the selected one
+void calibrationSelect(int direction);
+void calibrationToggle();
+void calibrationDraw(Adafruit_GFX& gfx, int lines);
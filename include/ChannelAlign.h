@@ -0,0 +1,71 @@
+#pragma once
+
+// Per-channel gain trim, polarity and delay, for enclosures with the drivers
+// at different distances from the listener or one of them wired inverted.
+// The delay is a whole number of samples from a short ring buffer plus a
+// fraction from a first-order Thiran allpass, which has a flat magnitude and
+// is exact at low frequencies. The fraction is kept between 0.5 and 1.5
+// samples where possible, where the allpass stays accurate highest up.
+// Changes are applied over ALIGN_FADE_FRAMES: the gain (including a polarity
+// flip) ramps, and a changed delay crossfades from the old read position to
+// the new one, so settings can be adjusted while music plays. A change that
+// arrives during a ramp waits for it to finish (restarting it would jump
+// back toward the old setting). With every setting neutral the stage only
+// records the input history.
+
+#include "AudioPipeline.h"
+
+#define ALIGN_MAX_DELAY_MS  1.0f
+#define ALIGN_RING          128     // samples per channel, power of two above the longest delay at 96 kHz
+#define ALIGN_FADE_FRAMES   256     // ramp and crossfade length when a setting changes
+
+class ChannelAlign : public AudioStage {
+public:
+    ChannelAlign();
+    const char* name() const override { return "align"; }
+    void reset() override;
+    void process(float* left, float* right, size_t frames) override;
+    int status(char* text, size_t size) const override;
+
+    // Delay applied to a channel (0 left, 1 right), samples
+    float delaySamples(int channel) const;
+
+protected:
+    void configure() override;
+
+private:
+    enum { P_LTRIM, P_RTRIM, P_LINVERT, P_RINVERT, P_LDELAY, P_RDELAY, P_COUNT };
+    AudioParam params[P_COUNT];
+
+    // Read position: whole samples back plus the allpass fraction
+    struct Tap {
+        int whole = 0;
+        bool fractional = false;
+        float coeff = 0;
+        float x1 = 0, y1 = 0;
+
+        bool sameDelay(const Tap& other) const {
+            return whole == other.whole && fractional == other.fractional && coeff == other.coeff;
+        }
+        float read(const float* ring, unsigned pos);
+    };
+
+    struct Channel {
+        float ring[ALIGN_RING] = {};
+        Tap tap;
+        Tap next;                   // during a delay crossfade
+        bool crossfade = false;
+        float gain = 1;
+        float targetGain = 1;
+        float gainStep = 0;
+    };
+
+    void processChannel(Channel& c, float* samples, size_t frames);
+    Tap tapFor(float delayMs) const;
+
+    Channel channels[2];
+    unsigned pos = 0;               // ring write index, shared by both channels
+    int fade = 0;                   // frames left of the current change
+    bool deferred = false;          // parameters changed during the fade
+    bool bypass = true;
+};
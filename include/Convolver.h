@@ -0,0 +1,45 @@
+#pragma once
+
+// Uniformly partitioned overlap-save convolution for long FIRs. The impulse
+// response is cut into partitions of one block each, and their spectra
+// (FFT size 2 x block) are computed once by begin(). Each block of input
+// costs one forward FFT, one multiply-add per partition against a
+// frequency-domain delay line of past input spectra, and one inverse FFT.
+// Output for a block is ready when the block is, so a caller feeding other
+// block sizes buffers one block; taps only add multiply-adds, not latency.
+// One impulse response is shared by up to CONVOLVER_MAX_CHANNELS
+// channels, each with its own history. begin() allocates, so keep it off
+// the audio path. No Arduino dependencies (host-buildable).
+
+#include <stdint.h>
+#include <stddef.h>
+#include "RealFft.h"
+
+#define CONVOLVER_MAX_CHANNELS  2
+
+class PartitionedConvolver {
+public:
+    ~PartitionedConvolver() { end(); }
+    // blockSize must be a power of two; false if it is not or memory runs out
+    bool begin(const float* ir, size_t taps, size_t blockSize, int channels);
+    void end();
+    void reset();
+
+    // Filters exactly blockSize() samples of one channel; in and out may alias
+    void process(int channel, const float* in, float* out);
+
+    size_t blockSize() const { return block; }
+    size_t partitions() const { return partCount; }
+    size_t memoryBytes() const;
+
+private:
+    RealFft fft;
+    size_t block = 0;
+    size_t partCount = 0;
+    int channelCount = 0;
+    float* spectra = nullptr;       // partCount packed IR spectra, pre-scaled for the inverse FFT
+    float* history = nullptr;       // per channel: partCount input spectra, newest at head
+    float* window = nullptr;        // per channel: the last two input blocks
+    float* accumulator = nullptr;   // one spectrum
+    size_t head[CONVOLVER_MAX_CHANNELS] = {};
+};
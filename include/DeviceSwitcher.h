@@ -0,0 +1,42 @@
+#pragma once
+
+// Paired-device memory on top of the A2DP sink: keeps the PairedDeviceList in
+// NVS, pages its phones in recency order as the ReconnectPolicy schedules
+// (on boot and after link loss), applies the policy's scan mode, switches on
+// request from the devices page, restores each phone's volume and EQ preset
+// and measures how long every connection attempt takes. The list doubles as
+// the name cache: a reconnecting phone shows its stored name at once while a
+// fresh remote name request runs in the background (NameResolver).
+
+#include <stdint.h>
+#include <stddef.h>
+#include "BluetoothA2DPSink.h"
+
+class Adafruit_GFX;
+
+#define SWITCH_SAVE_DELAY       5000    // ms of quiet before volume changes are saved
+
+// Call after the sink is started; defaultVolume is used for new phones
+void deviceSwitcherBegin(BluetoothA2DPSink& sink, int defaultVolume);
+
+// Connection callback hook; only records the state, safe from the BT task
+void deviceSwitcherOnConnection(esp_a2d_connection_state_t state);
+
+void deviceSwitcherUpdate(unsigned long now);
+void deviceSwitcherVolumeChanged(int volume);
+void deviceSwitcherEqPresetChanged(int preset);
+// Save pending volume changes now (before shutdown)
+void deviceSwitcherFlush();
+
+// Volume stored for the phone that just connected; true once per connection
+bool deviceSwitcherTakeVolume(int& volume);
+// Same for the phone's EQ preset
+bool deviceSwitcherTakeEqPreset(int& preset);
+
+// Display name of the connected phone when it becomes known or changes
+bool deviceSwitcherTakeName(char* name, size_t size);
+
+// Devices page: move the selection and connect to the selected phone
+void deviceSwitcherSelect(int step);
+void deviceSwitcherConnectSelected();
+void deviceSwitcherDraw(Adafruit_GFX& gfx, int lines);
@@ -0,0 +1,49 @@
+#pragma once
+
+// Rotary encoder with push button on the pins a board profile gives it. A
+// profile without the encoder instantiates the empty specialization: no
+// RotaryEncoder is constructed, no pin is configured and every call is a
+// constant, so the input handling around it compiles away.
+
+#include <Arduino.h>
+#include <RotaryEncoder.h>
+
+template <int PinA, int PinB, int PinButton, bool InternalPullup, bool Present = true>
+class EncoderInput {
+public:
+    static constexpr bool present = true;
+
+    void begin() {
+        if constexpr (!InternalPullup) {
+            pinMode(PinA, INPUT_PULLUP);
+            pinMode(PinB, INPUT_PULLUP);
+        }
+        pinMode(PinButton, INPUT_PULLUP);
+        last = encoder.getPosition();
+    }
+
+    // Detents turned since the last call, signed by direction
+    int steps() {
+        encoder.tick();
+        int position = encoder.getPosition();
+        int moved = position - last;
+        last = position;
+        return moved;
+    }
+
+    bool pressed() const { return digitalRead(PinButton) == LOW; }
+
+private:
+    RotaryEncoder encoder{ PinA, PinB, RotaryEncoder::LatchMode::TWO03 };
+    int last = 0;
+};
+
+template <int PinA, int PinB, int PinButton, bool InternalPullup>
+class EncoderInput<PinA, PinB, PinButton, InternalPullup, false> {
+public:
+    static constexpr bool present = false;
+
+    void begin() {}
+    int steps() { return 0; }
+    bool pressed() const { return false; }
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+// One-pole envelope follower with separate attack and release, the level
+// detector shared by the stages that need one (virtual bass normalization,
+// the output gate and its level reading). A compare and a multiply-add per
+// sample. No Arduino dependencies (host-buildable).
+
+#include <math.h>
+#include <stdint.h>
+
+struct EnvelopeFollower {
+    float attack = 1;           // per-sample coefficients, 1 = instant
+    float release = 1;
+    float value = 0;
+
+    // Time constants in seconds (63 % of a step)
+    void setTimes(float sampleRate, float attackSeconds, float releaseSeconds) {
+        attack = 1 - expf(-1.0f / (attackSeconds * sampleRate));
+        release = 1 - expf(-1.0f / (releaseSeconds * sampleRate));
+    }
+
+    // magnitude >= 0, e.g. |x| or max(|left|, |right|)
+    inline float process(float magnitude) {
+        value += (magnitude > value ? attack : release) * (magnitude - value);
+        return value;
+    }
+
+    void reset() { value = 0; }
+};
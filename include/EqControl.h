@@ -0,0 +1,21 @@
+#pragma once
+
+// EQ preset selection and the "eq" serial command over the EqStage bank:
+//   eq                                   list presets, * marks the one playing
+//   eq <n> | next                        select a preset
+//   eq show <n>                          print a preset as a pasteable "eq load" line
+//   eq load <slot> <text>                replace a user slot from that text form
+//   eq band <slot> <band> <type> <hz> <gain> <q>
+//                                        edit one band of a user slot
+//   eq name <slot> <name>
+// User slots are kept in the "eq" Preferences namespace; the selected preset
+// is remembered per phone by the DeviceSwitcher.
+
+void eqControlBegin();
+// Select a preset (clamped) and remember it for the connected phone
+void eqControlSelect(int index);
+// Select without remembering it (the connected phone's stored preset)
+void eqControlApply(int index);
+// Next preset, wrapping; returns its index
+int eqControlNext();
+const char* eqControlPresetName();
@@ -0,0 +1,78 @@
+#pragma once
+
+// EQ preset bank: built-in presets in flash plus user slots that are edited
+// from the serial console and kept in NVS. A band packs into four bytes
+// (type, log-spaced frequency code, gain in 0.5 dB, Q in 0.05 steps), a
+// preset with its name into 32. Presets travel over serial as one line of
+// text: 2 hex digits per byte for the bands, then the name, e.g.
+//   "024a0c0e 03e5040e 00000000 00000000 00000000 Bass boost"
+// No Arduino dependencies (host-buildable).
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Biquad.h"
+
+#define EQ_BANDS            5
+#define EQ_BUILTIN_PRESETS  4       // flat, bass boost, voice, night
+#define EQ_USER_SLOTS       3
+#define EQ_PRESET_COUNT     (EQ_BUILTIN_PRESETS + EQ_USER_SLOTS)
+#define EQ_NAME_LENGTH      12      // including the NUL
+#define EQ_TEXT_LENGTH      (EQ_BANDS * 9 + EQ_NAME_LENGTH)
+#define EQ_BLOB_VERSION     1
+
+enum EqBandType : uint8_t {
+    EQ_OFF,
+    EQ_PEAK,
+    EQ_LOW_SHELF,
+    EQ_HIGH_SHELF,
+    EQ_LOW_PASS,
+    EQ_HIGH_PASS,
+    EQ_TYPE_COUNT
+};
+
+struct EqBand {
+    uint8_t type;           // EqBandType
+    uint8_t freq;           // 20 Hz * 1000^(freq/255)
+    int8_t gain;            // 0.5 dB steps (peak and shelves)
+    uint8_t q;              // 0.05 steps (peak and pass filters)
+};
+
+struct EqPreset {
+    EqBand bands[EQ_BANDS];
+    char name[EQ_NAME_LENGTH];
+};
+static_assert(sizeof(EqPreset) == 32, "EqPreset is stored byte for byte in NVS");
+
+// Band fields in and out of their packed form; out-of-range values are clamped
+EqBand eqBand(uint8_t type, float hz, float gainDb, float q);
+float eqBandHz(const EqBand& band);
+float eqBandGainDb(const EqBand& band);
+float eqBandQ(const EqBand& band);
+const char* eqBandTypeName(uint8_t type);
+// EQ_TYPE_COUNT if the name is unknown
+uint8_t eqBandTypeFromName(const char* name);
+
+// Unity (b0 = 1) for EQ_OFF or a flat band
+BiquadCoeffs eqBandCoeffs(const EqBand& band, float sampleRate);
+// Bands that change the sound (not off, not 0 dB peak or shelf)
+int eqActiveBands(const EqPreset& preset);
+
+// Serial text form (see the top of this file); false if text is malformed
+void eqPresetFormat(const EqPreset& preset, char* text, size_t size);
+bool eqPresetParse(const char* text, EqPreset& preset);
+
+class EqPresetBank {
+public:
+    EqPresetBank();
+    const EqPreset& at(int index) const;
+    static bool isUser(int index) { return index >= EQ_BUILTIN_PRESETS && index < EQ_PRESET_COUNT; }
+    // False for built-in presets
+    bool setUser(int index, const EqPreset& preset);
+
+    static constexpr size_t blobSize() { return 1 + EQ_USER_SLOTS * sizeof(EqPreset); }
+    size_t serialize(uint8_t* out, size_t capacity) const;
+    bool deserialize(const uint8_t* data, size_t length);
+
+private:
+    EqPreset user[EQ_USER_SLOTS];
+};
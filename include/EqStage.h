@@ -0,0 +1,75 @@
+#pragma once
+
+// Preset equalizer: up to EQ_BANDS biquads per channel, designed from the
+// selected entry of an EqPresetBank. A preset change must not click, and
+// simply swapping the coefficients of a running biquad leaves its state
+// matching the old filter, which rings. So the stage keeps two filter
+// banks: the new preset is designed into the idle one, which first runs
+// on the input for EQ_WARMUP_FRAMES with its output discarded (its state
+// settles to what it would hold had it always been running), and then
+// the output crossfades from the old bank to the new over EQ_FADE_FRAMES.
+// A change requested during a switch is applied once it has finished.
+// The flat preset costs nothing outside a switch. Other tasks select a
+// preset with AudioPipeline::postParam() and report edits with reload(),
+// so every switch starts on the audio task at a block boundary.
+
+#include <atomic>
+
+#include <math.h>
+#include "AudioPipeline.h"
+#include "Biquad.h"
+#include "EqPresets.h"
+
+#define EQ_WARMUP_FRAMES    2048    // new bank runs silently before the crossfade
+#define EQ_FADE_FRAMES      1024
+
+class EqStage : public AudioStage {
+public:
+    EqStage();
+    const char* name() const override { return "eq"; }
+    void reset() override;
+    void process(float* left, float* right, size_t frames) override;
+    int status(char* text, size_t size) const override;
+
+    EqPresetBank& presets() { return bank; }
+    // Selected preset: the one being played, or the latest request
+    int preset() const { return (int)lroundf(params[P_PRESET].value); }
+    bool switching() const { return warmup > 0 || fade > 0; }
+    // Redesign after the bank entry at index was edited, if it is in use;
+    // from any task, applied before the next block
+    void reload(int index);
+
+protected:
+    void configure() override;
+
+private:
+    enum { P_PRESET, P_COUNT };
+    AudioParam params[P_COUNT];
+
+    // Only the bands that change the sound, so a 2-band preset costs 2 biquads
+    struct FilterBank {
+        Biquad left[EQ_BANDS];
+        Biquad right[EQ_BANDS];
+        int bands = 0;
+    };
+
+    void design(FilterBank& filters, int index);
+    void run(FilterBank& filters, float* left, float* right, size_t frames);
+    // Preset the audio task plays or has started switching to
+    int latest() const;
+    void startSwitch(int index);
+    void finishSwitch();
+
+    EqPresetBank bank;
+    FilterBank filters[2];
+    int active = 0;                 // bank the output comes from
+    int current = 0;                // preset in the active bank
+    int target = 0;                 // preset in the idle bank during a switch
+    int queued = -1;                // requested during a switch
+    int warmup = 0;                 // frames left before the crossfade
+    int fade = 0;                   // frames left of the crossfade
+    std::atomic<int> edited{-1};    // bank entry reported by reload()
+    uint32_t designedRate = 0;
+    float scratchLeft[AUDIO_BLOCK_FRAMES];
+    float scratchRight[AUDIO_BLOCK_FRAMES];
+};
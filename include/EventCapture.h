@@ -0,0 +1,34 @@
+#pragma once
+
+// On-device event capture for deterministic replay. "capture on" starts
+// recording every external Player input into a RAM buffer in the EventLog
+// format, "capture dump" prints it as hex between CAPTURE-BEGIN/CAPTURE-END
+// for tools/sim/replay.cpp. Recording stops when the buffer is full. When
+// capture is off each hook costs one flag test.
+
+#include <stdint.h>
+#include <stddef.h>
+#include "EventLog.h"
+
+class Player;
+
+#define CAPTURE_BUFFER_BYTES    16384   // allocated on "capture on", about a minute of streaming
+
+extern volatile bool captureActive;
+
+// Registers the console command; the player's state seeds each capture
+void captureBegin(const Player& player);
+
+void captureRecord(uint8_t type, const void* payload, uint8_t length);
+
+static inline void captureEvent(uint8_t type, const void* payload, uint8_t length) {
+    if (captureActive) {
+        captureRecord(type, payload, length);
+    }
+}
+
+static inline void captureEvent(uint8_t type, uint8_t value) {
+    if (captureActive) {
+        captureRecord(type, &value, 1);
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// Compact binary log of the external events that drive the Player: A2DP
+// connection changes, audio packets, AVRCP metadata, device name and volume
+// updates from the DeviceSwitcher, encoder steps and button levels. Each
+// record is
+//
+//   type (1 byte) | time since previous record, us (LEB128) | length (1 byte) | payload
+//
+// and a capture starts with an EVENT_START record holding the PlayerState at
+// that moment. Written on the device (EventCapture), replayed on the host
+// (tools/sim/replay.cpp). No Arduino dependencies (host-buildable).
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define EVENT_LOG_VERSION       1
+#define EVENT_LOG_MAX_PAYLOAD   255
+
+// Append new types at the end so older captures still replay
+enum EventType : uint8_t {
+    EVENT_START,            // u8 version, PlayerState
+    EVENT_CONNECTION,       // u8 esp_a2d_connection_state_t
+    EVENT_AUDIO,            // u16 packet bytes
+    EVENT_METADATA,         // u8 attribute id, text without NUL (truncated)
+    EVENT_DEVICE_NAME,      // text without NUL
+    EVENT_VOLUME_SET,       // u8 volume from the DeviceSwitcher
+    EVENT_VOLUME_STEP,      // i8 encoder direction
+    EVENT_TRACK_STEP,       // i8 encoder direction
+    EVENT_VOLUME_BUTTON,    // u8 1 = pressed
+    EVENT_TRACK_BUTTON,     // u8 1 = pressed
+    EVENT_VOLUME_LIMIT,     // u8 maximum volume (battery)
+    EVENT_TYPE_COUNT
+};
+
+struct EventRecord {
+    uint8_t type;
+    uint32_t deltaUs;
+    uint8_t length;
+    const uint8_t* payload;
+};
+
+// Largest encoded record: type, 5-byte delta, length, payload
+#define EVENT_LOG_MAX_RECORD    (7 + EVENT_LOG_MAX_PAYLOAD)
+
+// Encodes one record into buf; returns the bytes written, 0 if it does not fit
+size_t eventLogEncode(uint8_t* buf, size_t size, uint8_t type, uint32_t deltaUs,
+                      const void* payload, uint8_t length);
+
+// Decodes the record at buf; returns the bytes consumed, 0 if truncated or malformed
+size_t eventLogDecode(const uint8_t* buf, size_t size, EventRecord& out);
+
+const char* eventTypeName(uint8_t type);
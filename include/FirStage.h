@@ -0,0 +1,40 @@
+#pragma once
+
+// Speaker correction FIR from flash (include/SpeakerFir.h, generated by
+// tools/fir_design.py) through a PartitionedConvolver, for what biquads
+// cannot do, such as linearizing the enclosure's phase. Blocks from the
+// pipeline are gathered into FIR_PARTITION frames, adding that much latency
+// on top of the filter's own delay. The convolver memory (about 52 KB for
+// 2048 taps) is allocated the first time the stage is turned on (prepare(),
+// off the audio task), so a build that never turns it on pays nothing. Streams at a rate other
+// than the filter's pass through unchanged.
+
+#include "AudioPipeline.h"
+#include "Convolver.h"
+
+#define FIR_PARTITION   128     // frames per partition: latency vs. cost per tap
+
+class FirStage : public AudioStage {
+public:
+    FirStage();
+    const char* name() const override { return "fir"; }
+    void prepare() override;
+    void reset() override;
+    void process(float* left, float* right, size_t frames) override;
+
+    size_t memoryBytes() const { return convolver.memoryBytes(); }
+
+protected:
+    void configure() override;
+
+private:
+    enum { P_GAIN, P_COUNT };
+    AudioParam params[P_COUNT];
+
+    PartitionedConvolver convolver;
+    bool ready = false;
+    float gain = 1;
+    size_t fill = 0;
+    float input[2][FIR_PARTITION];
+    float output[2][FIR_PARTITION];
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+// Bluetooth link quality telemetry on top of LinkStats: per-packet timing
+// and throughput from the A2DP data callback, RSSI polled once a second
+// while a phone is connected, and underruns split into RF and non-RF causes.
+// "link" on the serial console prints the recent windows; linkMonitorDraw()
+// renders the diagnostics page.
+
+#include <stdint.h>
+#include "BluetoothA2DPSink.h"
+
+class Adafruit_GFX;
+
+#define LINK_RSSI_INTERVAL      1000    // ms between RSSI reads while connected
+
+// bufferDepthMs is the audio buffered behind I2S; longer packet gaps underrun
+void linkMonitorBegin(BluetoothA2DPSink& sink, uint32_t bufferDepthMs);
+// The same depth changes with the stream's sample rate
+void linkMonitorSetBufferDepth(uint32_t bufferDepthMs);
+
+// A2DP data callback, on the Bluetooth task
+void linkMonitorOnPacket(uint32_t bytes);
+
+// RSSI read result from the GAP callback (BtGap), on the Bluetooth task
+void linkMonitorOnRssi(int8_t rssiDelta);
+
+void linkMonitorOnDisconnect();
+// A2DP audio suspended or stopped (pause), on the Bluetooth task
+void linkMonitorOnSuspend();
+void linkMonitorUpdate(unsigned long now);
+void linkMonitorDraw(Adafruit_GFX& gfx, int lines);
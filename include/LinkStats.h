@@ -0,0 +1,66 @@
+#pragma once
+
+// Rolling Bluetooth link statistics: bytes, packet inter-arrival gaps and
+// RSSI aggregated into fixed one-second windows. A gap longer than the audio
+// buffer depth counts as an underrun, and each underrun is attributed to RF
+// (weak RSSI in that window), a stalled stream (long gap with good RSSI) or
+// neither, which points at the CPU side. The gap across a disconnect or an
+// A2DP suspend (pause) is not a gap in the stream and is not counted.
+// onPacket() is cheap enough for the A2DP data callback. No Arduino
+// dependencies (host-buildable).
+
+#include <stdint.h>
+
+#define LINK_WINDOW_US      1000000     // window length
+#define LINK_WINDOWS        16          // windows kept (power of two)
+#define LINK_WEAK_RSSI      -5          // RSSI delta below the golden range that counts as weak
+
+struct LinkWindow {
+    uint32_t startMs;
+    uint32_t bytes;
+    uint32_t packets;
+    uint32_t maxGapUs;
+    uint64_t sumGapUs;
+    uint16_t underruns;
+    int8_t rssi;            // lowest RSSI delta reported in the window
+    bool hasRssi;
+};
+
+struct LinkTotals {
+    uint32_t underruns;
+    uint32_t underrunsWeakRssi;     // RF side
+    uint32_t underrunsGoodRssi;     // stream stalled although the radio looked fine
+    uint32_t worstGapUs;
+};
+
+class LinkStats {
+public:
+    // Gaps longer than this many microseconds starve the output
+    void setUnderrunGap(uint32_t gapUs) { underrunGapUs = gapUs; }
+
+    void onPacket(uint32_t nowUs, uint32_t bytes);
+    void onRssi(uint32_t nowUs, int8_t rssiDelta);
+    void onDisconnect() { havePacket = false; }
+    void onSuspend() { havePacket = false; }
+
+    // Completed windows, 0 = most recent; false if fewer have completed
+    bool window(int age, LinkWindow& out) const;
+    const LinkWindow& current() const { return open; }
+    const LinkTotals& totals() const { return sums; }
+
+private:
+    void advance(uint32_t nowUs);
+    void closeWindow(LinkWindow& w);
+
+    void push(const LinkWindow& w) { windows[closed++ & (LINK_WINDOWS - 1)] = w; }
+
+    LinkWindow open = {};
+    LinkWindow windows[LINK_WINDOWS] = {};      // completed, ring
+    uint32_t closed = 0;            // windows completed so far
+    uint32_t windowStartUs = 0;
+    uint32_t lastPacketUs = 0;
+    bool havePacket = false;
+    bool started = false;
+    uint32_t underrunGapUs = 100000;
+    LinkTotals sums = {};
+};
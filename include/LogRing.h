@@ -0,0 +1,97 @@
+#pragma once
+
+// Lock-free bounded ring of fixed-size text records.
+// Any task may push (multi-producer), one drain task pops (single consumer).
+// A full ring never blocks the caller: the record is dropped and counted.
+// Kept free of Arduino/ESP-IDF headers so it also builds on the host.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <atomic>
+
+template <size_t TextSize>
+struct LogRecord {
+    uint32_t timestamp;     // millis() at the time of the call
+    uint8_t level;
+    uint8_t length;         // text length without the terminating NUL
+    char text[TextSize];
+};
+
+template <size_t Slots, size_t TextSize>
+class LogRing {
+    static_assert((Slots & (Slots - 1)) == 0, "Slots must be a power of two");
+    static_assert(TextSize <= 256, "length is stored in a uint8_t");
+
+public:
+    typedef LogRecord<TextSize> Record;
+
+    LogRing() {
+        for (size_t i = 0; i < Slots; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Format straight into a free slot; returns false (and counts a drop) when full.
+    bool push(uint8_t level, uint32_t timestamp, const char* fmt, va_list args) {
+        Cell* cell;
+        uint32_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[pos & (Slots - 1)];
+            uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+            int32_t diff = (int32_t)(seq - pos);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        int n = vsnprintf(cell->record.text, TextSize, fmt, args);
+        if (n < 0) {
+            n = 0;
+            cell->record.text[0] = '\0';
+        } else if ((size_t)n >= TextSize) {
+            n = TextSize - 1;   // truncated
+        }
+        cell->record.timestamp = timestamp;
+        cell->record.level = level;
+        cell->record.length = (uint8_t)n;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Copy the oldest record out; only the drain task may call this.
+    bool pop(Record& out) {
+        Cell* cell = &cells[tail & (Slots - 1)];
+        uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+        if ((int32_t)(seq - (tail + 1)) < 0) {
+            return false;
+        }
+        out = cell->record;
+        cell->sequence.store(tail + Slots, std::memory_order_release);
+        tail++;
+        return true;
+    }
+
+    uint32_t droppedCount() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        Record record;
+    };
+
+    Cell cells[Slots];
+    std::atomic<uint32_t> head{0};
+    uint32_t tail = 0;
+    std::atomic<uint32_t> dropped{0};
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+// EBU R128 / ITU-R BS.1770 loudness of the incoming stream, and an optional
+// slow AGC that brings every source to the same target. The meter K-weights
+// both channels (high shelf plus RLB high-pass, recomputed for the stream
+// rate) and sums their mean square into 100 ms sub-blocks. Momentary
+// loudness covers the last 4 of them and short-term the last 30. Integrated
+// loudness gates the overlapping 400 ms blocks absolutely at -70 LUFS and
+// then relatively at -10 LU. The blocks are kept as a 0.1 LU histogram, not
+// a list, so memory stays fixed for any programme length. The AGC follows
+// the short-term loudness of passages above its gate with a time constant of
+// "window" seconds and slews its gain at "rate" dB/s within +-"range" dB.
+// Block peaks cap the gain so a boost never clips. The meter sees the input,
+// so its readings do not depend on the AGC.
+
+#include "AudioPipeline.h"
+#include "Biquad.h"
+
+#define LOUDNESS_SHORT_BLOCKS   30      // 100 ms sub-blocks in the short-term window
+#define LOUDNESS_MOMENTARY      4       // ... in the momentary window (and gating blocks)
+#define LOUDNESS_MIN_LUFS       -70.0f  // absolute gate and histogram floor
+#define LOUDNESS_MAX_LUFS       5.0f
+#define LOUDNESS_BIN_LU         0.1f
+#define LOUDNESS_BINS           750     // (max - min) / bin width
+#define LOUDNESS_SILENCE        -100.0f // reported when there is nothing to measure
+
+class LoudnessMeter : public AudioStage {
+public:
+    LoudnessMeter();
+    const char* name() const override { return "loudness"; }
+    void reset() override;
+    void process(float* left, float* right, size_t frames) override;
+    int status(char* text, size_t size) const override;
+
+    float momentary() const;            // LUFS
+    float shortTerm() const;
+    float integrated() const;           // since the last reset(), gated
+    float agcGainDb() const { return agcDb; }
+
+protected:
+    void configure() override;
+
+private:
+    enum { P_AGC, P_TARGET, P_RANGE, P_RATE, P_WINDOW, P_COUNT };
+    AudioParam params[P_COUNT];
+
+    float loudnessOf(float energy, int blocks) const;
+    void closeSubBlock();
+
+    Biquad shelf[2];
+    Biquad highPass[2];
+    uint32_t subBlockFrames = 4410;
+    uint32_t subBlockFill = 0;
+    float subBlockSum = 0;
+    float subBlocks[LOUDNESS_SHORT_BLOCKS] = {};    // sum of squares per 100 ms, ring
+    int subBlockHead = 0;
+    int subBlockCount = 0;
+    uint32_t histogram[LOUDNESS_BINS] = {};
+
+    float programLufs = LOUDNESS_SILENCE;           // AGC's view of the programme
+    float agcDb = 0;
+    float gain = 1;                                 // applied, linear
+};
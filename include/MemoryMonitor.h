@@ -0,0 +1,46 @@
+#pragma once
+
+// Heap and stack health monitor. Samples free size, largest free block and
+// minimum-ever free for internal, DMA-capable and PSRAM heaps, plus the stack
+// high-water mark of watched tasks, and logs a warning when memory runs low,
+// fragments, or keeps shrinking. "mem" on the serial console prints the full
+// state; memoryMonitorDraw() renders the diagnostics page.
+
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+class Adafruit_GFX;
+
+#define MEMORY_SAMPLE_INTERVAL  1000    // ms between samples
+#define MEMORY_TREND_SAMPLES    60      // samples in the leak-trend window
+#define MEMORY_MAX_TASKS        10
+
+#define MEMORY_LOW_INTERNAL     (16 * 1024)     // warn below this many free internal bytes
+#define MEMORY_FRAGMENTED_PCT   60              // warn when largest block < 40% of free
+#define MEMORY_LEAK_BYTES       (4 * 1024)      // warn when the window lost this much
+#define MEMORY_LOW_STACK        512             // warn below this many unused stack bytes
+
+struct HeapStats {
+    uint32_t total;
+    uint32_t free;
+    uint32_t largestBlock;
+    uint32_t minFree;       // low-water mark since boot
+
+    uint8_t fragmentation() const {
+        return free ? (uint8_t)(100 - (uint64_t)largestBlock * 100 / free) : 0;
+    }
+};
+
+struct MemorySnapshot {
+    HeapStats internal;
+    HeapStats dma;
+    HeapStats spiram;
+};
+
+void memoryMonitorBegin();
+// A null handle is resolved by name on each sample, for tasks created later
+void memoryMonitorWatchTask(const char* name, TaskHandle_t task = nullptr);
+void memoryMonitorUpdate(unsigned long now);
+const MemorySnapshot& memoryMonitorSnapshot();
+void memoryMonitorDraw(Adafruit_GFX& gfx, int lines);
@@ -0,0 +1,20 @@
+#pragma once
+
+// Asynchronous remote name requests for connected phones. A request is issued
+// from the loop task, the answer arrives as a GAP event on the Bluetooth task
+// (see BtGap) and is picked up later with nameResolverTake(), so no Bluetooth callback
+// ever waits for the air round trip. One lookup is in flight at a time.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define NAME_REQUEST_TIMEOUT 5000   // ms before a lookup is abandoned
+
+// Start a lookup; ignored while another one is still in flight
+void nameResolverRequest(const uint8_t address[6], unsigned long now);
+
+// Completed lookup, if any: fills address and name and returns true once
+bool nameResolverTake(uint8_t address[6], char* name, size_t size, unsigned long now);
+
+// Result from the GAP callback (BtGap), on the Bluetooth task
+void nameResolverOnResult(bool ok, const char* name);
@@ -0,0 +1,50 @@
+#pragma once
+
+// Downward expander on the chain output, to keep the noise floor of the
+// stream (and what the AGC and EQ make of it) out of the speakers in pauses
+// and between tracks. A peak envelope of both channels drives an open/closed
+// state with hysteresis: the gate opens as soon as the envelope reaches
+// "open" dBFS and closes once it has stayed more than "hyst" dB below that
+// for "hold" ms. While open the gain is 1. While closed it follows the
+// envelope below the open threshold with 1:"ratio" expansion, down to
+// "depth" dB, so a sound that rises slowly fades in and the gain is already
+// 1 when the gate opens. The gain rises with the attack time and falls with
+// the release time. The closed-state gain is computed once per block; per
+// frame it is an envelope step, a compare and a gain step. The envelope is
+// also the output peak level shown by "dsp".
+
+#include "AudioPipeline.h"
+#include "Envelope.h"
+
+#define GATE_DETECTOR_RELEASE   0.050f  // s, envelope decay; long enough to bridge a 20 Hz cycle
+
+class NoiseGate : public AudioStage {
+public:
+    NoiseGate();
+    const char* name() const override { return "gate"; }
+    void reset() override;
+    void process(float* left, float* right, size_t frames) override;
+    int status(char* text, size_t size) const override;
+
+    bool isOpen() const { return open; }
+    float gainDb() const;
+    float levelDb() const;              // output peak envelope before the gate, dBFS
+
+protected:
+    void configure() override;
+
+private:
+    enum { P_OPEN, P_HYST, P_RATIO, P_DEPTH, P_ATTACK, P_RELEASE, P_HOLD, P_COUNT };
+    AudioParam params[P_COUNT];
+
+    EnvelopeFollower envelope;
+    float openLevel = 0;                // linear thresholds
+    float closeLevel = 0;
+    float floorGain = 0;
+    float gainAttack = 1;               // per-sample coefficients
+    float gainRelease = 1;
+    uint32_t holdFrames = 0;
+    uint32_t holdLeft = 0;
+    bool open = false;
+    float gain = 1;
+};
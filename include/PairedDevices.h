@@ -0,0 +1,63 @@
+#pragma once
+
+// Most-recently-used list of paired phones with per-device settings.
+// Index 0 is the most recently connected device; when the list is full the
+// least recently connected one is evicted. The whole list serializes to a
+// small versioned blob for NVS. No Arduino dependencies (host-buildable).
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PAIRED_MAX_DEVICES  6
+#define PAIRED_NAME_LENGTH  24      // including the terminating NUL
+#define PAIRED_BLOB_VERSION 1
+
+struct PairedDevice {
+    uint32_t lastSeen;              // connection sequence number, higher = more recent
+    uint8_t address[6];
+    uint8_t volume;                 // 0-100
+    uint8_t eqPreset;
+    char name[PAIRED_NAME_LENGTH];
+};
+
+struct PairedBlobHeader {
+    uint8_t version;
+    uint8_t count;
+    uint16_t recordSize;
+};
+
+class PairedDeviceList {
+public:
+    int count() const { return deviceCount; }
+    const PairedDevice& at(int index) const { return devices[index]; }
+    PairedDevice& at(int index) { return devices[index]; }
+
+    // Index of the device with this address, or -1
+    int find(const uint8_t address[6]) const;
+
+    // Record a connection: moves the device to the front, adding it (and
+    // evicting the least recently used entry if full) when it is new.
+    PairedDevice& touch(const uint8_t address[6], uint8_t defaultVolume);
+
+    // Store a (re)resolved name without changing the order; true if it
+    // differs from the cached one and the list needs saving
+    bool setName(const uint8_t address[6], const char* name);
+
+    bool remove(const uint8_t address[6]);
+    void clear();
+
+    static constexpr size_t blobSize(int count) { return sizeof(PairedBlobHeader) + count * sizeof(PairedDevice); }
+    size_t serialize(uint8_t* out, size_t capacity) const;
+    bool deserialize(const uint8_t* data, size_t length);
+
+private:
+    PairedDevice devices[PAIRED_MAX_DEVICES];
+    int deviceCount = 0;
+    uint32_t sequence = 0;
+};
+
+void formatAddress(const uint8_t address[6], char* out, size_t size);
+
+// Copy a NUL terminated UTF-8 name into size bytes, cutting before a
+// multi-byte sequence that does not fit rather than through it
+void copyName(char* out, size_t size, const char* name);
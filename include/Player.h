@@ -0,0 +1,115 @@
+#pragma once
+
+// Player state machine behind the Bluetooth callbacks and the knobs:
+// connection state, play/pause, volume, display page and the cleaned-up
+// track metadata. Handlers only update state and return the action the
+// caller should perform on the A2DP sink, so the same logic runs on the
+// device and in the host replay harness (tools/sim/replay.cpp).
+// No Arduino dependencies (host-buildable).
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PLAYER_TEXT_LENGTH      96      // title / artist buffer, including the NUL
+#define PLAYER_NAME_LENGTH      32      // connected device name, including the NUL
+#define PLAYER_VOLUME_STEP      5       // percent per encoder detent
+#define PLAYER_LONG_PRESS       1000    // ms holding a knob for its long-press action
+
+// Same values as esp_a2d_connection_state_t
+enum PlayerLink : uint8_t {
+    LINK_DISCONNECTED,
+    LINK_CONNECTING,
+    LINK_CONNECTED,
+    LINK_DISCONNECTING,
+};
+
+// Same values as esp_avrc_md_attr_mask_t
+enum PlayerMetadata : uint8_t {
+    METADATA_TITLE = 0x01,
+    METADATA_ARTIST = 0x02,
+};
+
+// Display pages, cycled by a long press on the volume knob
+enum DisplayPage : uint8_t {
+    PAGE_PLAYER,
+    PAGE_DEVICES,
+    PAGE_MEMORY,
+    PAGE_LINK,
+    PAGE_SIGNAL,                // calibration signals
+    PAGE_COUNT
+};
+
+enum PlayerAction : uint8_t {
+    ACTION_NONE,
+    ACTION_SET_VOLUME,
+    ACTION_PLAY,
+    ACTION_PAUSE,
+    ACTION_STOP,
+    ACTION_NEXT_TRACK,
+    ACTION_PREVIOUS_TRACK,
+    ACTION_NEXT_PAGE,
+    ACTION_SELECT_NEXT,         // devices page
+    ACTION_SELECT_PREVIOUS,
+    ACTION_CONNECT_SELECTED,
+    ACTION_SIGNAL_NEXT,         // signal page
+    ACTION_SIGNAL_PREVIOUS,
+    ACTION_SIGNAL_TOGGLE,
+    ACTION_NEXT_EQ_PRESET,      // long press on the track knob, player page
+};
+
+struct PlayerState {
+    bool connected;
+    bool playing;               // audio is streaming
+    bool paused;                // last play/pause command sent was pause
+    uint8_t volume;             // 0-100
+    uint8_t page;               // DisplayPage
+    char device[PLAYER_NAME_LENGTH];
+    char title[PLAYER_TEXT_LENGTH];
+    char artist[PLAYER_TEXT_LENGTH];
+};
+static_assert(sizeof(PlayerState) == 5 + PLAYER_NAME_LENGTH + 2 * PLAYER_TEXT_LENGTH,
+              "PlayerState is stored byte for byte in event captures");
+
+class Player {
+public:
+    void begin(int volume);
+
+    void onConnection(uint8_t state);
+    // True when this packet starts the stream
+    bool onAudio();
+    // text is read up to its NUL or PLAYER_TEXT_LENGTH - 1 bytes
+    void onMetadata(uint8_t id, const char* text);
+    void setDeviceName(const char* name);
+    void setVolume(int volume);
+    // Upper volume bound (low battery); lowers the volume if needed and then
+    // returns ACTION_SET_VOLUME
+    PlayerAction setVolumeLimit(int limit);
+    int volumeLimit() const { return limit; }
+
+    PlayerAction onVolumeStep(int direction);
+    PlayerAction onTrackStep(int direction);
+    // Called with the debounced button level on every poll, so the long press
+    // is detected while the knob is still held
+    PlayerAction onVolumeButton(bool pressed, uint32_t nowMs);
+    // Same; short presses act on release so they can be told from long ones
+    PlayerAction onTrackButton(bool pressed, uint32_t nowMs);
+
+    const PlayerState& state() const { return s; }
+    // Start from a captured state (replay)
+    void restore(const PlayerState& state) { s = state; }
+
+private:
+    PlayerState s = {};
+    uint8_t limit = 100;
+    bool volumePressed = false;
+    bool volumeLongPress = false;
+    uint32_t volumePressTime = 0;
+    bool trackPressed = false;
+    bool trackLongPress = false;
+    uint32_t trackPressTime = 0;
+};
+
+// Metadata cleanup shared with the host tools; both work in place on a NUL
+// terminated string and never make it longer
+void cleanTitle(char* title);
+void cleanArtist(char* artist);
@@ -0,0 +1,36 @@
+#pragma once
+
+// In-place FFT of real float data, size a power of two from 8 to
+// FFT_MAX_SIZE. Runs as a complex radix-2 FFT of half the size plus a split
+// pass. Spectra are packed into the same n floats: data[0] = DC,
+// data[1] = Nyquist (both real), then re/im pairs for bins 1 .. n/2-1.
+// Twiddle and bit-reversal tables are allocated by begin(), so keep that
+// off the audio path. No Arduino dependencies (host-buildable).
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FFT_MAX_SIZE    4096
+
+class RealFft {
+public:
+    ~RealFft() { end(); }
+    // False if the size is not supported or the tables cannot be allocated
+    bool begin(size_t size);
+    void end();
+    size_t size() const { return n; }
+
+    void forward(float* data) const;
+    // Unnormalized: returns the input scaled by n
+    void inverse(float* data) const;
+
+private:
+    void complexFft(float* data, bool inverse) const;
+
+    size_t n = 0;
+    float* twiddle = nullptr;       // e^(-2 pi i k / n), k < n/2, as re/im pairs
+    uint16_t* bitReverse = nullptr; // n/2 entries
+};
+
+// acc += a * b for packed spectra of n floats
+void spectrumMultiplyAdd(float* acc, const float* a, const float* b, size_t n);
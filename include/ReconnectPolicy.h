@@ -0,0 +1,88 @@
+#pragma once
+
+// Reconnect policy engine. Driven by connection-state events and a periodic
+// poll(), it decides when to page which remembered phone (cycling through the
+// list, then backing off exponentially between rounds) and how the radio
+// should scan while disconnected: discoverable for a while after a
+// disconnect, then only connectable in short windows so page-scan duty stays
+// under a cap. No Arduino dependencies, so policies can be simulated on the
+// host (tools/sim/reconnect_sim.cpp).
+
+#include <stdint.h>
+
+struct ReconnectConfig {
+    uint32_t attemptTimeoutMs = 6000;     // page one phone for at most this long
+    uint32_t initialBackoffMs = 5000;     // pause after the first failed round
+    uint32_t maxBackoffMs = 120000;
+    uint8_t backoffFactor = 2;
+    uint32_t discoverableMs = 120000;     // discoverable + connectable after a disconnect
+    uint32_t scanPeriodMs = 10000;        // afterwards, connectable windows repeat this often
+    uint8_t maxScanDutyPct = 20;          // ... and last this share of each period
+};
+
+struct ReconnectStats {
+    uint32_t attempts;          // pages started
+    uint32_t timeouts;          // pages that did not connect
+    uint32_t reconnects;        // links re-established after a disconnect
+    uint32_t lastReconnectMs;   // disconnect to connect, last time
+    uint32_t worstReconnectMs;
+    uint64_t totalReconnectMs;
+    uint64_t radioBusyMs;       // paging or scanning while disconnected
+    uint64_t disconnectedMs;
+};
+
+struct RadioMode {
+    bool connectable;
+    bool discoverable;
+
+    bool operator==(const RadioMode& other) const {
+        return connectable == other.connectable && discoverable == other.discoverable;
+    }
+    bool operator!=(const RadioMode& other) const { return !(*this == other); }
+};
+
+class ReconnectPolicy {
+public:
+    explicit ReconnectPolicy(const ReconnectConfig& config = ReconnectConfig()) : config(config) {}
+
+    const ReconnectConfig& settings() const { return config; }
+    void configure(const ReconnectConfig& newConfig) { config = newConfig; }
+
+    // Boot counts as a disconnect: start walking the list right away
+    void begin(uint32_t now) { onDisconnected(now); }
+    void onConnected(uint32_t now);
+    void onDisconnected(uint32_t now);
+
+    // Page this list entry next (user selection), ahead of the normal order
+    void request(int index, uint32_t now);
+
+    // Call often; returns the list index to page now, or -1. knownDevices is
+    // the current size of the paired device list.
+    int poll(uint32_t now, int knownDevices);
+
+    RadioMode radioMode(uint32_t now) const;
+    bool isPaging() const { return state == STATE_PAGING; }
+    uint32_t currentBackoffMs() const { return backoff; }
+    const ReconnectStats& stats() const { return counters; }
+    void resetStats() { counters = ReconnectStats(); }
+
+private:
+    enum State {
+        STATE_CONNECTED,
+        STATE_WAITING,          // until nextAttemptAt
+        STATE_PAGING,           // until attemptDeadline
+    };
+
+    void account(uint32_t now);
+
+    ReconnectConfig config;
+    ReconnectStats counters = ReconnectStats();
+    State state = STATE_CONNECTED;
+    uint32_t disconnectedAt = 0;
+    uint32_t nextAttemptAt = 0;
+    uint32_t attemptDeadline = 0;
+    uint32_t backoff = 0;
+    uint32_t lastAccounted = 0;
+    int nextIndex = 0;
+    int requestedIndex = -1;
+};
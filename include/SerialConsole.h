@@ -0,0 +1,13 @@
+#pragma once
+
+// Line-based command console on Serial. Modules register their commands at
+// setup time; consolePoll() runs from loop(), so handlers execute in the
+// Arduino loop task and may print directly.
+
+typedef void (*ConsoleHandler)(const char* args);
+
+#define CONSOLE_MAX_COMMANDS 16
+#define CONSOLE_LINE_LENGTH  96
+
+void consoleRegister(const char* name, const char* help, ConsoleHandler handler);
+void consolePoll();
@@ -0,0 +1,96 @@
+#pragma once
+
+// Test signals for tuning the speaker and its EQ: steady sine tones,
+// exponential (log) sweeps, pink noise and polarity pulses. Levels are dBFS
+// peak for tones, sweeps and pulses, and dBFS RMS for noise. Tones use a
+// rotating phasor instead of sinf() per sample; pink noise is Voss-McCartney
+// (one of SIGNAL_PINK_ROWS white generators changes per sample, picked by
+// the trailing zeros of a counter, plus a white row every sample), so both
+// are a handful of operations per frame. Sweeps repeat after a second of
+// silence, pulses every half second. The output is planar float like
+// AudioStage blocks. No Arduino dependencies (host-buildable).
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SIGNAL_PINK_ROWS        16      // octaves of pink noise below the top one
+#define SIGNAL_SWEEP_GAP        1.0f    // s of silence between sweeps
+#define SIGNAL_FADE             0.005f  // s of raised-cosine fade at the sweep ends
+#define SIGNAL_PULSE_PERIOD     0.5f    // s between polarity pulses
+#define SIGNAL_PULSE_WIDTH      0.001f  // s, Hann shaped
+
+enum SignalType : uint8_t {
+    SIGNAL_OFF,
+    SIGNAL_TONE,
+    SIGNAL_SWEEP,
+    SIGNAL_PINK,
+    SIGNAL_PULSE,
+    SIGNAL_COUNT
+};
+
+enum SignalChannels : uint8_t {
+    SIGNAL_LEFT = 1,
+    SIGNAL_RIGHT = 2,
+    SIGNAL_BOTH = 3,
+};
+
+struct SignalSettings {
+    uint8_t type = SIGNAL_OFF;          // SignalType
+    uint8_t channels = SIGNAL_BOTH;     // SignalChannels; the others stay silent
+    bool invert = false;                // negative polarity
+    float level = -20;                  // dBFS
+    float frequency = 1000;             // tone, Hz
+    float sweepStart = 20;              // Hz
+    float sweepEnd = 20000;
+    float sweepSeconds = 10;
+};
+
+const char* signalTypeName(uint8_t type);
+// SIGNAL_COUNT if the name is unknown
+uint8_t signalTypeFromName(const char* name);
+
+class SignalGenerator {
+public:
+    // Applies the settings and restarts the signal from its beginning
+    void start(const SignalSettings& settings, uint32_t sampleRate);
+    void stop() { s.type = SIGNAL_OFF; }
+    bool active() const { return s.type != SIGNAL_OFF; }
+    const SignalSettings& settings() const { return s; }
+
+    // Silence when stopped
+    void generate(float* left, float* right, size_t frames);
+
+    // Current sweep frequency (0 in the gap) and position, for the display
+    float sweepFrequency() const;
+    float seconds() const { return (float)position / rate; }
+
+private:
+    float tone();
+    float sweep();
+    float pink();
+    float pulse();
+    uint32_t random();
+
+    SignalSettings s;
+    uint32_t rate = 44100;
+    float amplitude = 0;
+    uint32_t position = 0;              // frames since start, or since the current sweep or pulse
+
+    // Tone: phasor and its per-sample rotation
+    float re = 1, im = 0;
+    float rotRe = 1, rotIm = 0;
+
+    // Sweep: phase in cycles, frequency in cycles per sample and its growth per sample
+    double phase = 0;
+    double step = 0;
+    double growth = 1;
+    uint32_t sweepFrames = 0;
+    uint32_t sweepCycle = 1;            // sweep plus gap
+    uint32_t fadeFrames = 0;
+
+    // Pink noise
+    uint32_t seed = 1;
+    uint32_t counter = 0;
+    float rows[SIGNAL_PINK_ROWS] = {};
+    float rowSum = 0;
+};
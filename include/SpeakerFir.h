@@ -0,0 +1,352 @@
+#pragma once
+
+// Generated by tools/fir_design.py --fc 150 --q 0.707 --taps 2048 --rate 44100; do not edit.
+// Impulse response of the "fir" audio stage, kept in flash.
+
+#define SPEAKER_FIR_RATE    44100
+#define SPEAKER_FIR_TAPS    2048
+
+static const float speakerFir[SPEAKER_FIR_TAPS] = {
+    1.33216361e-16f, -3.72850174e-14f, 2.14786573e-13f, -6.19555767e-13f, 1.38089444e-12f, -2.55876468e-12f,
+    4.31000906e-12f, -6.67154212e-12f, 9.81334218e-12f, -1.37748567e-11f, 1.87017470e-11f, -2.46860360e-11f,
+    3.17857008e-11f, -4.02227832e-11f, 4.98752828e-11f, -6.12031958e-11f, 7.37801617e-11f, -8.84457870e-11f,
+    1.04309570e-10f, -1.22769499e-10f, 1.42272291e-10f, -1.64993727e-10f, 1.88476641e-10f, -2.15938335e-10f,
+    2.43730447e-10f, -2.76423668e-10f, 3.08841035e-10f, -3.47270584e-10f, 3.84615214e-10f, -4.29300452e-10f,
+    4.71859250e-10f, -5.23335173e-10f, 5.71378868e-10f, -6.30197217e-10f, 6.83979227e-10f, -7.50709605e-10f,
+    8.10464904e-10f, -8.85695926e-10f, 9.51639900e-10f, -1.03598039e-09f, 1.10830762e-09f, -1.20238777e-09f,
+    1.28127083e-09f, -1.38574346e-09f, 1.47133173e-09f, -1.58687350e-09f, 1.67929190e-09f, -1.80660451e-09f,
+    1.90595225e-09f, -2.04576373e-09f, 2.15211316e-09f, -2.30517907e-09f, 2.41857430e-09f, -2.58567900e-09f,
+    2.70613481e-09f, -2.88809266e-09f, 3.01559321e-09f, -3.21324978e-09f, 3.34774738e-09f, -3.56198067e-09f,
+    3.70339471e-09f, -3.93511625e-09f, 4.08333203e-09f, -4.33348794e-09f, 4.48835552e-09f, -4.75792781e-09f,
+    4.91926109e-09f, -5.20926840e-09f, 5.37684395e-09f, -5.68834263e-09f, 5.86189903e-09f, -6.19598402e-09f,
+    6.37522087e-09f, -6.73302644e-09f, 6.91760358e-09f, -7.30030398e-09f, 7.48984109e-09f, -7.89865132e-09f,
+    8.09272716e-09f, -8.52890318e-09f, 8.72705523e-09f, -9.19189434e-09f, 9.39361876e-09f, -9.88846003e-09f,
+    1.00932113e-08f, -1.06194352e-08f, 1.08266264e-08f, -1.13856549e-08f, 1.15946579e-08f, -1.21879540e-08f,
+    1.23980999e-08f, -1.30271669e-08f, 1.32377467e-08f, -1.39041280e-08f, 1.41143942e-08f, -1.48196712e-08f,
+    1.50288369e-08f, -1.57746289e-08f, 1.59818726e-08f, -1.67698334e-08f, 1.69742977e-08f, -1.78061168e-08f,
+    1.80069124e-08f, -1.88843089e-08f, 1.90805160e-08f, -2.00052385e-08f, 2.01959100e-08f, -2.11697335e-08f,
+    2.13538983e-08f, -2.23786195e-08f, 2.25552860e-08f, -2.36327205e-08f, 2.38008806e-08f, -2.49328587e-08f,
+    2.50914923e-08f, -2.62798535e-08f, 2.64279334e-08f, -2.76745218e-08f, 2.78110198e-08f, -2.91176780e-08f,
+    2.92415701e-08f, -3.06101329e-08f, 3.07204069e-08f, -3.21526945e-08f, 3.22483563e-08f, -3.37461666e-08f,
+    3.38262487e-08f, -3.53913489e-08f, 3.54549192e-08f, -3.70890371e-08f, 3.71352074e-08f, -3.88400220e-08f,
+    3.88679586e-08f, -4.06450892e-08f, 4.06540236e-08f, -4.25050191e-08f, 4.24942592e-08f, -4.44205858e-08f,
+    4.43895287e-08f, -4.63925574e-08f, 4.63407024e-08f, -4.84216953e-08f, 4.83486582e-08f, -5.05087535e-08f,
+    5.04142815e-08f, -5.26544785e-08f, 5.25384664e-08f, -5.48596088e-08f, 5.47221160e-08f, -5.71248738e-08f,
+    5.69661422e-08f, -5.94509943e-08f, 5.92714676e-08f, -6.18386812e-08f, 6.16390249e-08f, -6.42886352e-08f,
+    6.40697580e-08f, -6.68015463e-08f, 6.65646226e-08f, -6.93780929e-08f, 6.91245866e-08f, -7.20189420e-08f,
+    7.17506307e-08f, -7.47247476e-08f, 7.44437494e-08f, -7.74961508e-08f, 7.72049513e-08f, -8.03337790e-08f,
+    8.00352597e-08f, -8.32382450e-08f, 8.29357136e-08f, -8.62101468e-08f, 8.59073681e-08f, -8.92500667e-08f,
+    8.89512954e-08f, -9.23585706e-08f, 9.20685846e-08f, -9.55362075e-08f, 9.52603442e-08f, -9.87835087e-08f,
+    9.85277004e-08f, -1.02100987e-07f, 1.01871800e-07f, -1.05489137e-07f, 1.05293810e-07f, -1.08948433e-07f,
+    1.08794917e-07f, -1.12479329e-07f, 1.12376333e-07f, -1.16082258e-07f, 1.16039287e-07f, -1.19757632e-07f,
+    1.19785037e-07f, -1.23505841e-07f, 1.23614861e-07f, -1.27327250e-07f, 1.27530062e-07f, -1.31222204e-07f,
+    1.31531969e-07f, -1.35191021e-07f, 1.35621936e-07f, -1.39233996e-07f, 1.39801343e-07f, -1.43351398e-07f,
+    1.44071598e-07f, -1.47543472e-07f, 1.48434135e-07f, -1.51810436e-07f, 1.52890417e-07f, -1.56152480e-07f,
+    1.57441934e-07f, -1.60569771e-07f, 1.62090207e-07f, -1.65062445e-07f, 1.66836782e-07f, -1.69630614e-07f,
+    1.71683238e-07f, -1.74274358e-07f, 1.76631182e-07f, -1.78993734e-07f, 1.81682251e-07f, -1.83788769e-07f,
+    1.86838112e-07f, -1.88659462e-07f, 1.92100461e-07f, -1.93605785e-07f, 1.97471025e-07f, -1.98627681e-07f,
+    2.02951558e-07f, -2.03725069e-07f, 2.08543847e-07f, -2.08897838e-07f, 2.14249704e-07f, -2.14145853e-07f,
+    2.20070973e-07f, -2.19468951e-07f, 2.26009522e-07f, -2.24866946e-07f, 2.32067249e-07f, -2.30339628e-07f,
+    2.38246077e-07f, -2.35886763e-07f, 2.44547954e-07f, -2.41508095e-07f, 2.50974851e-07f, -2.47203350e-07f,
+    2.57528764e-07f, -2.52972231e-07f, 2.64211707e-07f, -2.58814428e-07f, 2.71025715e-07f, -2.64729615e-07f,
+    2.77972839e-07f, -2.70717450e-07f, 2.85055147e-07f, -2.76777583e-07f, 2.92274716e-07f, -2.82909655e-07f,
+    2.99633639e-07f, -2.89113303e-07f, 3.07134011e-07f, -2.95388159e-07f, 3.14777933e-07f, -3.01733857e-07f,
+    3.22567507e-07f, -3.08150038e-07f, 3.30504832e-07f, -3.14636348e-07f, 3.38592000e-07f, -3.21192448e-07f,
+    3.46831094e-07f, -3.27818016e-07f, 3.55224178e-07f, -3.34512749e-07f, 3.63773297e-07f, -3.41276375e-07f,
+    3.72480472e-07f, -3.48108653e-07f, 3.81347691e-07f, -3.55009382e-07f, 3.90376905e-07f, -3.61978403e-07f,
+    3.99570023e-07f, -3.69015610e-07f, 4.08928901e-07f, -3.76120956e-07f, 4.18455341e-07f, -3.83294459e-07f,
+    4.28151075e-07f, -3.90536211e-07f, 4.38017770e-07f, -3.97846385e-07f, 4.48057002e-07f, -4.05225248e-07f,
+    4.58270266e-07f, -4.12673165e-07f, 4.68658952e-07f, -4.20190611e-07f, 4.79224340e-07f, -4.27778181e-07f,
+    4.89967594e-07f, -4.35436602e-07f, 5.00889744e-07f, -4.43166742e-07f, 5.11991680e-07f, -4.50969625e-07f,
+    5.23274136e-07f, -4.58846439e-07f, 5.34737682e-07f, -4.66798552e-07f, 5.46382706e-07f, -4.74827525e-07f,
+    5.58209404e-07f, -4.82935126e-07f, 5.70217765e-07f, -4.91123344e-07f, 5.82407557e-07f, -4.99394403e-07f,
+    5.94778308e-07f, -5.07750783e-07f, 6.07329296e-07f, -5.16195228e-07f, 6.20059526e-07f, -5.24730770e-07f,
+    6.32967720e-07f, -5.33360745e-07f, 6.46052293e-07f, -5.42088809e-07f, 6.59311337e-07f, -5.50918957e-07f,
+    6.72742605e-07f, -5.59855545e-07f, 6.86343486e-07f, -5.68903310e-07f, 7.00110989e-07f, -5.78067385e-07f,
+    7.14041722e-07f, -5.87353328e-07f, 7.28131868e-07f, -5.96767137e-07f, 7.42377167e-07f, -6.06315277e-07f,
+    7.56772890e-07f, -6.16004700e-07f, 7.71313819e-07f, -6.25842871e-07f, 7.85994222e-07f, -6.35837788e-07f,
+    8.00807830e-07f, -6.45998011e-07f, 8.15747810e-07f, -6.56332683e-07f, 8.30806743e-07f, -6.66851558e-07f,
+    8.45976601e-07f, -6.77565025e-07f, 8.61248712e-07f, -6.88484136e-07f, 8.76613745e-07f, -6.99620631e-07f,
+    8.92061676e-07f, -7.10986963e-07f, 9.07581764e-07f, -7.22596331e-07f, 9.23162527e-07f, -7.34462701e-07f,
+    9.38791708e-07f, -7.46600836e-07f, 9.54456253e-07f, -7.59026324e-07f, 9.70142284e-07f, -7.71755605e-07f,
+    9.85835068e-07f, -7.84805997e-07f, 1.00151899e-06f, -7.98195727e-07f, 1.01717754e-06f, -8.11943956e-07f,
+    1.03279326e-06f, -8.26070806e-07f, 1.04834773e-06f, -8.40597384e-07f, 1.06382155e-06f, -8.55545815e-07f,
+    1.07919432e-06f, -8.70939263e-07f, 1.09444458e-06f, -8.86801955e-07f, 1.10954982e-06f, -9.03159208e-07f,
+    1.12448645e-06f, -9.20037453e-07f, 1.13922975e-06f, -9.37464252e-07f, 1.15375390e-06f, -9.55468327e-07f,
+    1.16803191e-06f, -9.74079574e-07f, 1.18203563e-06f, -9.93329083e-07f, 1.19573573e-06f, -1.01324916e-06f,
+    1.20910166e-06f, -1.03387333e-06f, 1.22210166e-06f, -1.05523636e-06f, 1.23470277e-06f, -1.07737427e-06f,
+    1.24687076e-06f, -1.10032435e-06f, 1.25857016e-06f, -1.12412514e-06f, 1.26976428e-06f, -1.14881645e-06f,
+    1.28041513e-06f, -1.17443938e-06f, 1.29048352e-06f, -1.20103627e-06f, 1.29992899e-06f, -1.22865076e-06f,
+    1.30870984e-06f, -1.25732770e-06f, 1.31678316e-06f, -1.28711322e-06f, 1.32410481e-06f, -1.31805465e-06f,
+    1.33062948e-06f, -1.35020052e-06f, 1.33631069e-06f, -1.38360055e-06f, 1.34110082e-06f, -1.41830560e-06f,
+    1.34495113e-06f, -1.45436762e-06f, 1.34781187e-06f, -1.49183964e-06f, 1.34963221e-06f, -1.53077571e-06f,
+    1.35036041e-06f, -1.57123084e-06f, 1.34994379e-06f, -1.61326092e-06f, 1.34832884e-06f, -1.65692271e-06f,
+    1.34546129e-06f, -1.70227370e-06f, 1.34128617e-06f, -1.74937206e-06f, 1.33574790e-06f, -1.79827656e-06f,
+    1.32879041e-06f, -1.84904645e-06f, 1.32035721e-06f, -1.90174134e-06f, 1.31039155e-06f, -1.95642112e-06f,
+    1.29883648e-06f, -2.01314581e-06f, 1.28563503e-06f, -2.07197541e-06f, 1.27073034e-06f, -2.13296980e-06f,
+    1.25406583e-06f, -2.19618853e-06f, 1.23558531e-06f, -2.26169067e-06f, 1.21523319e-06f, -2.32953462e-06f,
+    1.19295473e-06f, -2.39977795e-06f, 1.16869615e-06f, -2.47247717e-06f, 1.14240485e-06f, -2.54768748e-06f,
+    1.11402969e-06f, -2.62546260e-06f, 1.08352122e-06f, -2.70585446e-06f, 1.05083188e-06f, -2.78891297e-06f,
+    1.01591634e-06f, -2.87468577e-06f, 9.78731762e-07f, -2.96321787e-06f, 9.39238063e-07f, -3.05455139e-06f,
+    8.97398300e-07f, -3.14872524e-06f, 8.53178949e-07f, -3.24577474e-06f, 8.06550284e-07f, -3.34573129e-06f,
+    7.57486742e-07f, -3.44862198e-06f, 7.05967304e-07f, -3.55446921e-06f, 6.51975902e-07f, -3.66329027e-06f,
+    5.95501854e-07f, -3.77509688e-06f, 5.36540290e-07f, -3.88989477e-06f, 4.75092632e-07f, -4.00768321e-06f,
+    4.11167067e-07f, -4.12845450e-06f, 3.44779055e-07f, -4.25219344e-06f, 2.75951855e-07f, -4.37887685e-06f,
+    2.04717069e-07f, -4.50847297e-06f, 1.31115208e-07f, -4.64094089e-06f, 5.51962819e-08f, -4.77622995e-06f,
+    -2.29795868e-08f, -4.91427916e-06f, -1.03341534e-07f, -5.05501649e-06f, -1.85807299e-07f, -5.19835826e-06f,
+    -2.70282547e-07f, -5.34420842e-06f, -3.56660166e-07f, -5.49245786e-06f, -4.44819551e-07f, -5.64298368e-06f,
+    -5.34625856e-07f, -5.79564841e-06f, -6.25929225e-07f, -5.95029927e-06f, -7.18564009e-07f, -6.10676734e-06f,
+    -8.12347954e-07f, -6.26486677e-06f, -9.07081363e-07f, -6.42439391e-06f, -1.00254625e-06f, -6.58512645e-06f,
+    -1.09850545e-06f, -6.74682258e-06f, -1.19470176e-06f, -6.90922001e-06f, -1.29085698e-06f, -7.07203513e-06f,
+    -1.38667100e-06f, -7.23496200e-06f, -1.48182085e-06f, -7.39767143e-06f, -1.57595972e-06f, -7.55980999e-06f,
+    -1.66871598e-06f, -7.72099903e-06f, -1.75969219e-06f, -7.88083364e-06f, -1.84846403e-06f, -8.03888167e-06f,
+    -1.93457935e-06f, -8.19468265e-06f, -2.01755706e-06f, -8.34774680e-06f, -2.09688610e-06f, -8.49755391e-06f,
+    -2.17202441e-06f, -8.64355234e-06f, -2.24239779e-06f, -8.78515791e-06f, -2.30739892e-06f, -8.92175285e-06f,
+    -2.36638619e-06f, -9.05268472e-06f, -2.41868272e-06f, -9.17726533e-06f, -2.46357519e-06f, -9.29476970e-06f,
+    -2.50031285e-06f, -9.40443494e-06f, -2.52810643e-06f, -9.50545928e-06f, -2.54612707e-06f, -9.59700095e-06f,
+    -2.55350532e-06f, -9.67817721e-06f, -2.54933009e-06f, -9.74806330e-06f, -2.53264767e-06f, -9.80569151e-06f,
+    -2.50246077e-06f, -9.85005016e-06f, -2.45772753e-06f, -9.88008275e-06f, -2.39736064e-06f, -9.89468698e-06f,
+    -2.32022650e-06f, -9.89271399e-06f, -2.22514429e-06f, -9.87296749e-06f, -2.11088529e-06f, -9.83420304e-06f,
+    -1.97617210e-06f, -9.77512733e-06f, -1.81967796e-06f, -9.69439757e-06f, -1.64002616e-06f, -9.59062089e-06f,
+    -1.43578952e-06f, -9.46235388e-06f, -1.20548986e-06f, -9.30810212e-06f, -9.47597705e-07f, -9.12631991e-06f,
+    -6.60531960e-07f, -8.91541000e-06f, -3.42659717e-07f, -8.67372347e-06f, 7.70381894e-09f, -8.39955971e-06f,
+    3.92295297e-07f, -8.09116652e-06f, 8.12903068e-07f, -7.74674031e-06f, 1.27136690e-06f, -7.36442650e-06f,
+    1.76957756e-06f, -6.94231998e-06f, 2.30947622e-06f, -6.47846580e-06f, 2.89305374e-06f, -5.97085997e-06f,
+    3.52234977e-06f, -5.41745050e-06f, 4.19945165e-06f, -4.81613852e-06f, 4.92649315e-06f, -4.16477970e-06f,
+    5.70565297e-06f, -3.46118585e-06f, 6.53915307e-06f, -2.70312669e-06f, 7.42925677e-06f, -1.88833194e-06f,
+    8.37826656e-06f, -1.01449353e-06f, 9.38852171e-06f, -7.92682459e-08f, 1.04623956e-05f, 9.19719549e-07f,
+    1.16022928e-05f, 1.98487476e-06f, 1.28106457e-05f, 3.11862816e-06f, 1.40899111e-05f, 4.32343272e-06f,
+    1.54425664e-05f, 5.60175951e-06f, 1.68711053e-05f, 6.95609331e-06f, 1.83780330e-05f, 8.38892793e-06f,
+    1.99658618e-05f, 9.90276101e-06f, 2.16371053e-05f, 1.15000885e-05f, 2.33942729e-05f, 1.31833989e-05f,
+    2.52398638e-05f, 1.49551665e-05f, 2.71763602e-05f, 1.68178450e-05f, 2.92062203e-05f, 1.87738602e-05f,
+    3.13318710e-05f, 2.08256018e-05f, 3.35556996e-05f, 2.29754157e-05f, 3.58800456e-05f, 2.52255951e-05f,
+    3.83071917e-05f, 2.75783708e-05f, 4.08393538e-05f, 3.00359018e-05f, 4.34786715e-05f, 3.26002649e-05f,
+    4.62271966e-05f, 3.52734430e-05f, 4.90868826e-05f, 3.80573143e-05f, 5.20595721e-05f, 4.09536394e-05f,
+    5.51469845e-05f, 4.39640484e-05f, 5.83507026e-05f, 4.70900277e-05f, 6.16721587e-05f, 5.03329050e-05f,
+    6.51126198e-05f, 5.36938349e-05f, 6.86731723e-05f, 5.71737824e-05f, 7.23547059e-05f, 6.07735070e-05f,
+    7.61578963e-05f, 6.44935450e-05f, 8.00831879e-05f, 6.83341912e-05f, 8.41307750e-05f, 7.22954801e-05f,
+    8.83005824e-05f, 7.63771661e-05f, 9.25922452e-05f, 8.05787028e-05f, 9.70050878e-05f, 8.48992211e-05f,
+    1.01538102e-04f, 8.93375069e-05f, 1.06189922e-04f, 9.38919780e-05f, 1.10958805e-04f, 9.85606589e-05f,
+    1.15842603e-04f, 1.03341156e-04f, 1.20838735e-04f, 1.08230632e-04f, 1.25944166e-04f, 1.13225776e-04f,
+    1.31155375e-04f, 1.18322779e-04f, 1.36468326e-04f, 1.23517300e-04f, 1.41878442e-04f, 1.28804440e-04f,
+    1.47380568e-04f, 1.34178708e-04f, 1.52968944e-04f, 1.39633987e-04f, 1.58637170e-04f, 1.45163504e-04f,
+    1.64378173e-04f, 1.50759792e-04f, 1.70184168e-04f, 1.56414657e-04f, 1.76046627e-04f, 1.62119139e-04f,
+    1.81956237e-04f, 1.67863471e-04f, 1.87902863e-04f, 1.73637048e-04f, 1.93875510e-04f, 1.79428378e-04f,
+    1.99862278e-04f, 1.85225044e-04f, 2.05850322e-04f, 1.91013663e-04f, 2.11825812e-04f, 1.96779838e-04f,
+    2.17773881e-04f, 2.02508117e-04f, 2.23678587e-04f, 2.08181943e-04f, 2.29522862e-04f, 2.13783612e-04f,
+    2.35288467e-04f, 2.19294219e-04f, 2.40955940e-04f, 2.24693611e-04f, 2.46504547e-04f, 2.29960338e-04f,
+    2.51912235e-04f, 2.35071597e-04f, 2.57155574e-04f, 2.40003185e-04f, 2.62209705e-04f, 2.44729440e-04f,
+    2.67048292e-04f, 2.49223191e-04f, 2.71643458e-04f, 2.53455697e-04f, 2.75965735e-04f, 2.57396596e-04f,
+    2.79984004e-04f, 2.61013844e-04f, 2.83665440e-04f, 2.64273656e-04f, 2.86975452e-04f, 2.67140452e-04f,
+    2.89877622e-04f, 2.69576789e-04f, 2.92333646e-04f, 2.71543309e-04f, 2.94303275e-04f, 2.72998672e-04f,
+    2.95744253e-04f, 2.73899497e-04f, 2.96612251e-04f, 2.74200296e-04f, 2.96860810e-04f, 2.73853417e-04f,
+    2.96441278e-04f, 2.72808978e-04f, 2.95302742e-04f, 2.71014803e-04f, 2.93391969e-04f, 2.68416358e-04f,
+    2.90653344e-04f, 2.64956691e-04f, 2.87028802e-04f, 2.60576366e-04f, 2.82457768e-04f, 2.55213398e-04f,
+    2.76877092e-04f, 2.48803194e-04f, 2.70220990e-04f, 2.41278488e-04f, 2.62420976e-04f, 2.32569277e-04f,
+    2.53405806e-04f, 2.22602763e-04f, 2.43101414e-04f, 2.11303291e-04f, 2.31430852e-04f, 1.98592287e-04f,
+    2.18314232e-04f, 1.84388203e-04f, 2.03668668e-04f, 1.68606454e-04f, 1.87408217e-04f, 1.51159370e-04f,
+    1.69443828e-04f, 1.31956132e-04f, 1.49683288e-04f, 1.10902728e-04f, 1.28031167e-04f, 8.79018952e-05f,
+    1.04388773e-04f, 6.28530765e-05f, 7.86541023e-05f, 3.56523716e-05f, 5.07217967e-05f, 6.19249408e-06f,
+    2.04831011e-05f, -2.56372689e-05f, -1.21741749e-05f, -5.99510948e-05f, -4.73656926e-05f, -9.68666596e-05f,
+    -8.52106161e-05f, -1.36505169e-04f, -1.25831640e-04f, -1.78991385e-04f, -1.69355015e-04f, -2.24453648e-04f,
+    -2.15910567e-04f, -2.73023897e-04f, -2.65631710e-04f, -3.24837683e-04f, -3.18655461e-04f, -3.80034176e-04f,
+    -3.75122442e-04f, -4.38756169e-04f, -4.35176882e-04f, -5.01150079e-04f, -4.98966609e-04f, -5.67365935e-04f,
+    -5.66643038e-04f, -6.37557365e-04f, -6.38361153e-04f, -7.11881576e-04f, -7.14279481e-04f, -7.90499327e-04f,
+    -7.94560060e-04f, -8.73574892e-04f, -8.79368398e-04f, -9.61276017e-04f, -9.68873423e-04f, -1.05377387e-03f,
+    -1.06324743e-03f, -1.15124299e-03f, -1.16266601e-03f, -1.25386120e-03f, -1.26730799e-03f, -1.36180954e-03f,
+    -1.37735532e-03f, -1.47527220e-03f, -1.49299301e-03f, -1.59443639e-03f, -1.61440900e-03f, -1.71949224e-03f,
+    -1.74179407e-03f, -1.85063272e-03f, -1.87534170e-03f, -1.98805344e-03f, -2.01524791e-03f, -2.13195259e-03f,
+    -2.16171116e-03f, -2.28253071e-03f, -2.31493213e-03f, -2.43999059e-03f, -2.47511360e-03f, -2.60453706e-03f,
+    -2.64246019e-03f, -2.77637678e-03f, -2.81717824e-03f, -2.95571808e-03f, -2.99947551e-03f, -3.14277069e-03f,
+    -3.18956101e-03f, -3.33774557e-03f, -3.38764471e-03f, -3.54085457e-03f, -3.59393729e-03f, -3.75231027e-03f,
+    -3.80864986e-03f, -3.97232560e-03f, -4.03199364e-03f, -4.20111360e-03f, -4.26417968e-03f, -4.43888711e-03f,
+    -4.50541847e-03f, -4.68585840e-03f, -4.75591966e-03f, -4.94223885e-03f, -5.01589162e-03f, -5.20823858e-03f,
+    -5.28554106e-03f, -5.48406603e-03f, -5.56507264e-03f, -5.76992762e-03f, -5.85468853e-03f, -6.06602729e-03f,
+    -6.15458793e-03f, -6.37256603e-03f, -6.46496660e-03f, -6.68974148e-03f, -6.78601638e-03f, -7.01774741e-03f,
+    -7.11792462e-03f, -7.35677325e-03f, -7.46087369e-03f, -7.70700351e-03f, -7.81504033e-03f, -8.06861733e-03f,
+    -8.18059512e-03f, -8.44178785e-03f, -8.55770181e-03f, -8.82668168e-03f, -8.94651666e-03f, -9.22345829e-03f,
+    -9.34718778e-03f, -9.63226938e-03f, -9.75985440e-03f, -1.00532583e-02f, -1.01846461e-02f, -1.04865593e-02f,
+    -1.06216821e-02f, -1.09322971e-02f, -1.10710704e-02f, -1.13905860e-02f, -1.15329067e-02f, -1.18615291e-02f,
+    -1.20072740e-02f, -1.23452182e-02f, -1.24942413e-02f, -1.28417323e-02f, -1.29938625e-02f, -1.33511376e-02f,
+    -1.35061758e-02f, -1.38734864e-02f, -1.40312019e-02f, -1.44088168e-02f, -1.45689437e-02f, -1.49571517e-02f,
+    -1.51193841e-02f, -1.55184985e-02f, -1.56824852e-02f, -1.60928488e-02f, -1.62581867e-02f, -1.66801773e-02f,
+    -1.68464040e-02f, -1.72804424e-02f, -1.74470264e-02f, -1.78935855e-02f, -1.80599150e-02f, -1.85195315e-02f,
+    -1.86849002e-02f, -1.91581891e-02f, -1.93217786e-02f, -1.98094523e-02f, -1.99703094e-02f, -2.04732019e-02f,
+    -2.06302099e-02f, -2.11493082e-02f, -2.13011496e-02f, -2.18376356e-02f, -2.19827423e-02f, -2.25380492e-02f,
+    -2.26745360e-02f, -2.32504251e-02f, -2.33759972e-02f, -2.39746652e-02f, -2.40864901e-02f, -2.47107221e-02f,
+    -2.48052428e-02f, -2.54586375e-02f, -2.55312958e-02f, -2.62186057e-02f, -2.62634164e-02f, -2.69910834e-02f,
+    -2.69999497e-02f, -2.77769872e-02f, -2.77385447e-02f, -2.85780742e-02f, -2.84756083e-02f, -2.93977351e-02f,
+    -2.92051120e-02f, -3.02428366e-02f, -2.99156340e-02f, -3.11286746e-02f, -3.05816037e-02f, -3.20955056e-02f,
+    -3.11292403e-02f, -3.32876339e-02f, -3.12166321e-02f, -3.57994416e-02f, 9.81668572e-01f, -5.09486845e-04f,
+    -4.62287686e-03f, -2.10422929e-03f, -3.80787756e-03f, -2.39337051e-03f, -3.45770437e-03f, -2.46508481e-03f,
+    -3.23293041e-03f, -2.46380725e-03f, -3.06074788e-03f, -2.43035678e-03f, -2.91632128e-03f, -2.38063392e-03f,
+    -2.78887457e-03f, -2.32208993e-03f, -2.67296799e-03f, -2.25866567e-03f, -2.56554957e-03f, -2.19263018e-03f,
+    -2.46476628e-03f, -2.12537374e-03f, -2.36942089e-03f, -2.05778874e-03f, -2.27869948e-03f, -1.99046833e-03f,
+    -2.19202441e-03f, -1.92381704e-03f, -2.10897011e-03f, -1.85811573e-03f, -2.02921255e-03f, -1.79356153e-03f,
+    -1.95249762e-03f, -1.73029317e-03f, -1.87862065e-03f, -1.66840778e-03f, -1.80741277e-03f, -1.60797217e-03f,
+    -1.73873161e-03f, -1.54903069e-03f, -1.67245473e-03f, -1.49161080e-03f, -1.60847500e-03f, -1.43572708e-03f,
+    -1.54669722e-03f, -1.38138419e-03f, -1.48703560e-03f, -1.32857908e-03f, -1.42941190e-03f, -1.27730263e-03f,
+    -1.37375407e-03f, -1.22754101e-03f, -1.31999508e-03f, -1.17927657e-03f, -1.26807215e-03f, -1.13248873e-03f,
+    -1.21792607e-03f, -1.08715450e-03f, -1.16950067e-03f, -1.04324907e-03f, -1.12274244e-03f, -1.00074613e-03f,
+    -1.07760017e-03f, -9.59618270e-04f, -1.03402468e-03f, -9.19837187e-04f, -9.91968634e-04f, -8.81373942e-04f,
+    -9.51386348e-04f, -8.44199134e-04f, -9.12233631e-04f, -8.08283050e-04f, -8.74467677e-04f, -7.73595800e-04f,
+    -8.38046961e-04f, -7.40107422e-04f, -8.02931157e-04f, -7.07787976e-04f, -7.69081059e-04f, -6.76607620e-04f,
+    -7.36458528e-04f, -6.46536678e-04f, -7.05026438e-04f, -6.17545696e-04f, -6.74748627e-04f, -5.89605493e-04f,
+    -6.45589864e-04f, -5.62687197e-04f, -6.17515812e-04f, -5.36762286e-04f, -5.90492997e-04f, -5.11802617e-04f,
+    -5.64488786e-04f, -4.87780448e-04f, -5.39471358e-04f, -4.64668465e-04f, -5.15409686e-04f, -4.42439798e-04f,
+    -4.92273515e-04f, -4.21068036e-04f, -4.70033347e-04f, -4.00527240e-04f, -4.48660422e-04f, -3.80791956e-04f,
+    -4.28126703e-04f, -3.61837219e-04f, -4.08404864e-04f, -3.43638565e-04f, -3.89468269e-04f, -3.26172033e-04f,
+    -3.71290968e-04f, -3.09414168e-04f, -3.53847678e-04f, -2.93342025e-04f, -3.37113773e-04f, -2.77933171e-04f,
+    -3.21065270e-04f, -2.63165682e-04f, -3.05678821e-04f, -2.49018146e-04f, -2.90931699e-04f, -2.35469658e-04f,
+    -2.76801786e-04f, -2.22499819e-04f, -2.63267566e-04f, -2.10088736e-04f, -2.50308109e-04f, -1.98217011e-04f,
+    -2.37903065e-04f, -1.86865746e-04f, -2.26032648e-04f, -1.76016529e-04f, -2.14677631e-04f, -1.65651437e-04f,
+    -2.03819332e-04f, -1.55753024e-04f, -1.93439606e-04f, -1.46304320e-04f, -1.83520831e-04f, -1.37288821e-04f,
+    -1.74045901e-04f, -1.28690486e-04f, -1.64998214e-04f, -1.20493724e-04f, -1.56361665e-04f, -1.12683397e-04f,
+    -1.48120630e-04f, -1.05244801e-04f, -1.40259960e-04f, -9.81636698e-05f, -1.32764973e-04f, -9.14261583e-05f,
+    -1.25621437e-04f, -8.50188407e-05f, -1.18815568e-04f, -7.89287000e-05f, -1.12334015e-04f, -7.31431211e-05f,
+    -1.06163852e-04f, -6.76498824e-05f, -1.00292567e-04f, -6.24371481e-05f, -9.47080571e-05f, -5.74934602e-05f,
+    -8.93986115e-05f, -5.28077301e-05f, -8.43529082e-05f, -4.83692308e-05f, -7.95600023e-05f, -4.41675890e-05f,
+    -7.50093168e-05f, -4.01927765e-05f, -7.06906336e-05f, -3.64351028e-05f, -6.65940850e-05f, -3.28852067e-05f,
+    -6.27101440e-05f, -2.95340484e-05f, -5.90296159e-05f, -2.63729018e-05f, -5.55436298e-05f, -2.33933465e-05f,
+    -5.22436297e-05f, -2.05872601e-05f, -4.91213660e-05f, -1.79468103e-05f, -4.61688874e-05f, -1.54644476e-05f,
+    -4.33785328e-05f, -1.31328975e-05f, -4.07429229e-05f, -1.09451533e-05f, -3.82549522e-05f, -8.89446854e-06f,
+    -3.59077818e-05f, -6.97434969e-06f, -3.36948308e-05f, -5.17854931e-06f, -3.16097697e-05f, -3.50105874e-06f,
+    -2.96465121e-05f, -1.93610127e-06f, -2.77992081e-05f, -4.78125303e-07f, -2.60622368e-05f, 8.78202360e-07f,
+    -2.44301995e-05f, 2.13800310e-06f, -2.28979125e-05f, 3.30619294e-06f, -2.14604008e-05f, 4.38748892e-06f,
+    -2.01128912e-05f, 5.38641530e-06f, -1.88508060e-05f, 6.30730969e-06f, -1.76697566e-05f, 7.15432900e-06f,
+    -1.65655375e-05f, 7.93145534e-06f, -1.55341199e-05f, 8.64250172e-06f, -1.45716464e-05f, 9.29111765e-06f,
+    -1.36744246e-05f, 9.88079466e-06f, -1.28389218e-05f, 1.04148716e-05f, -1.20617595e-05f, 1.08965400e-05f,
+    -1.13397082e-05f, 1.13288490e-05f, -1.06696818e-05f, 1.17147105e-05f, -1.00487328e-05f, 1.20569038e-05f,
+    -9.47404715e-06f, 1.23580806e-05f, -8.94293976e-06f, 1.26207695e-05f, -8.45284940e-06f, 1.28473806e-05f,
+    -8.00133438e-06f, 1.30402096e-05f, -7.58606800e-06f, 1.32014423e-05f, -7.20483427e-06f, 1.33331588e-05f,
+    -6.85552369e-06f, 1.34373373e-05f, -6.53612917e-06f, 1.35158582e-05f, -6.24474205e-06f, 1.35705078e-05f,
+    -5.97954828e-06f, 1.36029822e-05f, -5.73882466e-06f, 1.36148905e-05f, -5.52093524e-06f, 1.36077587e-05f,
+    -5.32432777e-06f, 1.35830328e-05f, -5.14753034e-06f, 1.35420821e-05f, -4.98914804e-06f, 1.34862026e-05f,
+    -4.84785981e-06f, 1.34166198e-05f, -4.72241529e-06f, 1.33344916e-05f, -4.61163189e-06f, 1.32409118e-05f,
+    -4.51439184e-06f, 1.31369120e-05f, -4.42963943e-06f, 1.30234648e-05f, -4.35637829e-06f, 1.29014865e-05f,
+    -4.29366878e-06f, 1.27718394e-05f, -4.24062545e-06f, 1.26353340e-05f, -4.19641463e-06f, 1.24927320e-05f,
+    -4.16025205e-06f, 1.23447479e-05f, -4.13140060e-06f, 1.21920515e-05f, -4.10916813e-06f, 1.20352700e-05f,
+    -4.09290533e-06f, 1.18749899e-05f, -4.08200372e-06f, 1.17117591e-05f, -4.07589368e-06f, 1.15460887e-05f,
+    -4.07404259e-06f, 1.13784548e-05f, -4.07595299e-06f, 1.12093003e-05f, -4.08116085e-06f, 1.10390363e-05f,
+    -4.08923391e-06f, 1.08680443e-05f, -4.09977004e-06f, 1.06966770e-05f, -4.11239572e-06f, 1.05252605e-05f,
+    -4.12676456e-06f, 1.03540952e-05f, -4.14255584e-06f, 1.01834573e-05f, -4.15947320e-06f, 1.00136004e-05f,
+    -4.17724328e-06f, 9.84475632e-06f, -4.19561448e-06f, 9.67713649e-06f, -4.21435577e-06f, 9.51093322e-06f,
+    -4.23325553e-06f, 9.34632064e-06f, -4.25212046e-06f, 9.18345581e-06f, -4.27077450e-06f, 9.02247975e-06f,
+    -4.28905784e-06f, 8.86351836e-06f, -4.30682598e-06f, 8.70668336e-06f, -4.32394875e-06f, 8.55207318e-06f,
+    -4.34030951e-06f, 8.39977379e-06f, -4.35580424e-06f, 8.24985948e-06f, -4.37034081e-06f, 8.10239365e-06f,
+    -4.38383815e-06f, 7.95742952e-06f, -4.39622559e-06f, 7.81501083e-06f, -4.40744212e-06f, 7.67517246e-06f,
+    -4.41743578e-06f, 7.53794112e-06f, -4.42616299e-06f, 7.40333589e-06f, -4.43358801e-06f, 7.27136879e-06f,
+    -4.43968231e-06f, 7.14204535e-06f, -4.44442412e-06f, 7.01536504e-06f, -4.44779784e-06f, 6.89132185e-06f,
+    -4.44979363e-06f, 6.76990466e-06f, -4.45040692e-06f, 6.65109772e-06f, -4.44963798e-06f, 6.53488102e-06f,
+    -4.44749153e-06f, 6.42123071e-06f, -4.44397635e-06f, 6.31011941e-06f, -4.43910490e-06f, 6.20151661e-06f,
+    -4.43289304e-06f, 6.09538895e-06f, -4.42535962e-06f, 5.99170056e-06f, -4.41652626e-06f, 5.89041327e-06f,
+    -4.40641700e-06f, 5.79148696e-06f, -4.39505807e-06f, 5.69487977e-06f, -4.38247765e-06f, 5.60054833e-06f,
+    -4.36870560e-06f, 5.50844798e-06f, -4.35377327e-06f, 5.41853301e-06f, -4.33771327e-06f, 5.33075679e-06f,
+    -4.32055930e-06f, 5.24507199e-06f, -4.30234595e-06f, 5.16143074e-06f, -4.28310856e-06f, 5.07978478e-06f,
+    -4.26288306e-06f, 5.00008558e-06f, -4.24170578e-06f, 4.92228452e-06f, -4.21961340e-06f, 4.84633295e-06f,
+    -4.19664275e-06f, 4.77218235e-06f, -4.17283074e-06f, 4.69978443e-06f, -4.14821425e-06f, 4.62909119e-06f,
+    -4.12283002e-06f, 4.56005503e-06f, -4.09671458e-06f, 4.49262884e-06f, -4.06990415e-06f, 4.42676602e-06f,
+    -4.04243458e-06f, 4.36242062e-06f, -4.01434131e-06f, 4.29954732e-06f, -3.98565925e-06f, 4.23810155e-06f,
+    -3.95642277e-06f, 4.17803949e-06f, -3.92666565e-06f, 4.11931811e-06f, -3.89642102e-06f, 4.06189525e-06f,
+    -3.86572135e-06f, 4.00572957e-06f, -3.83459838e-06f, 3.95078069e-06f, -3.80308313e-06f, 3.89700909e-06f,
+    -3.77120584e-06f, 3.84437622e-06f, -3.73899598e-06f, 3.79284447e-06f, -3.70648223e-06f, 3.74237719e-06f,
+    -3.67369243e-06f, 3.69293869e-06f, -3.64065363e-06f, 3.64449427e-06f, -3.60739202e-06f, 3.59701020e-06f,
+    -3.57393299e-06f, 3.55045373e-06f, -3.54030106e-06f, 3.50479306e-06f, -3.50651994e-06f, 3.45999740e-06f,
+    -3.47261249e-06f, 3.41603689e-06f, -3.43860074e-06f, 3.37288264e-06f, -3.40450592e-06f, 3.33050670e-06f,
+    -3.37034842e-06f, 3.28888205e-06f, -3.33614782e-06f, 3.24798261e-06f, -3.30192292e-06f, 3.20778319e-06f,
+    -3.26769174e-06f, 3.16825950e-06f, -3.23347149e-06f, 3.12938811e-06f, -3.19927867e-06f, 3.09114648e-06f,
+    -3.16512900e-06f, 3.05351289e-06f, -3.13103748e-06f, 3.01646646e-06f, -3.09701840e-06f, 2.97998710e-06f,
+    -3.06308536e-06f, 2.94405554e-06f, -3.02925125e-06f, 2.90865324e-06f, -2.99552834e-06f, 2.87376244e-06f,
+    -2.96192821e-06f, 2.83936610e-06f, -2.92846184e-06f, 2.80544787e-06f, -2.89513959e-06f, 2.77199212e-06f,
+    -2.86197124e-06f, 2.73898387e-06f, -2.82896597e-06f, 2.70640881e-06f, -2.79613243e-06f, 2.67425323e-06f,
+    -2.76347872e-06f, 2.64250405e-06f, -2.73101241e-06f, 2.61114878e-06f, -2.69874060e-06f, 2.58017549e-06f,
+    -2.66666988e-06f, 2.54957279e-06f, -2.63480638e-06f, 2.51932986e-06f, -2.60315578e-06f, 2.48943636e-06f,
+    -2.57172334e-06f, 2.45988245e-06f, -2.54051388e-06f, 2.43065876e-06f, -2.50953186e-06f, 2.40175639e-06f,
+    -2.47878132e-06f, 2.37316688e-06f, -2.44826597e-06f, 2.34488217e-06f, -2.41798914e-06f, 2.31689462e-06f,
+    -2.38795385e-06f, 2.28919699e-06f, -2.35816278e-06f, 2.26178239e-06f, -2.32861833e-06f, 2.23464430e-06f,
+    -2.29932259e-06f, 2.20777653e-06f, -2.27027739e-06f, 2.18117323e-06f, -2.24148428e-06f, 2.15482884e-06f,
+    -2.21294457e-06f, 2.12873812e-06f, -2.18465935e-06f, 2.10289610e-06f, -2.15662946e-06f, 2.07729808e-06f,
+    -2.12885554e-06f, 2.05193961e-06f, -2.10133804e-06f, 2.02681651e-06f, -2.07407720e-06f, 2.00192480e-06f,
+    -2.04707310e-06f, 1.97726074e-06f, -2.02032564e-06f, 1.95282080e-06f, -1.99383458e-06f, 1.92860163e-06f,
+    -1.96759952e-06f, 1.90460008e-06f, -1.94161992e-06f, 1.88081318e-06f, -1.91589511e-06f, 1.85723812e-06f,
+    -1.89042431e-06f, 1.83387226e-06f, -1.86520663e-06f, 1.81071309e-06f, -1.84024106e-06f, 1.78775826e-06f,
+    -1.81552651e-06f, 1.76500554e-06f, -1.79106177e-06f, 1.74245283e-06f, -1.76684560e-06f, 1.72009816e-06f,
+    -1.74287665e-06f, 1.69793962e-06f, -1.71915348e-06f, 1.67597545e-06f, -1.69567463e-06f, 1.65420399e-06f,
+    -1.67243857e-06f, 1.63262363e-06f, -1.64944371e-06f, 1.61123288e-06f, -1.62668840e-06f, 1.59003031e-06f,
+    -1.60417099e-06f, 1.56901457e-06f, -1.58188974e-06f, 1.54818435e-06f, -1.55984292e-06f, 1.52753846e-06f,
+    -1.53802875e-06f, 1.50707570e-06f, -1.51644542e-06f, 1.48679497e-06f, -1.49509113e-06f, 1.46669521e-06f,
+    -1.47396402e-06f, 1.44677538e-06f, -1.45306224e-06f, 1.42703451e-06f, -1.43238394e-06f, 1.40747167e-06f,
+    -1.41192722e-06f, 1.38808592e-06f, -1.39169023e-06f, 1.36887641e-06f, -1.37167106e-06f, 1.34984228e-06f,
+    -1.35186784e-06f, 1.33098270e-06f, -1.33227868e-06f, 1.31229687e-06f, -1.31290171e-06f, 1.29378401e-06f,
+    -1.29373505e-06f, 1.27544336e-06f, -1.27477684e-06f, 1.25727416e-06f, -1.25602520e-06f, 1.23927569e-06f,
+    -1.23747830e-06f, 1.22144721e-06f, -1.21913430e-06f, 1.20378801e-06f, -1.20099136e-06f, 1.18629740e-06f,
+    -1.18304768e-06f, 1.16897467e-06f, -1.16530145e-06f, 1.15181912e-06f, -1.14775090e-06f, 1.13483008e-06f,
+    -1.13039426e-06f, 1.11800685e-06f, -1.11322977e-06f, 1.10134876e-06f, -1.09625570e-06f, 1.08485512e-06f,
+    -1.07947035e-06f, 1.06852526e-06f, -1.06287201e-06f, 1.05235848e-06f, -1.04645900e-06f, 1.03635410e-06f,
+    -1.03022967e-06f, 1.02051145e-06f, -1.01418237e-06f, 1.00482983e-06f, -9.98315489e-07f, 9.89308554e-07f,
+    -9.82627426e-07f, 9.73946925e-07f, -9.67116599e-07f, 9.58744245e-07f, -9.51781449e-07f, 9.43699812e-07f,
+    -9.36620433e-07f, 9.28812918e-07f, -9.21632031e-07f, 9.14082851e-07f, -9.06814743e-07f, 8.99508894e-07f,
+    -8.92167087e-07f, 8.85090325e-07f, -8.77687600e-07f, 8.70826414e-07f, -8.63374841e-07f, 8.56716430e-07f,
+    -8.49227384e-07f, 8.42759631e-07f, -8.35243826e-07f, 8.28955274e-07f, -8.21422779e-07f, 8.15302608e-07f,
+    -8.07762877e-07f, 8.01800876e-07f, -7.94262769e-07f, 7.88449317e-07f, -7.80921122e-07f, 7.75247163e-07f,
+    -7.67736622e-07f, 7.62193640e-07f, -7.54707971e-07f, 7.49287972e-07f, -7.41833889e-07f, 7.36529373e-07f,
+    -7.29113110e-07f, 7.23917054e-07f, -7.16544387e-07f, 7.11450221e-07f, -7.04126485e-07f, 6.99128075e-07f,
+    -6.91858187e-07f, 6.86949812e-07f, -6.79738291e-07f, 6.74914622e-07f, -6.67765609e-07f, 6.63021693e-07f,
+    -6.55938966e-07f, 6.51270207e-07f, -6.44257202e-07f, 6.39659341e-07f, -6.32719170e-07f, 6.28188270e-07f,
+    -6.21323736e-07f, 6.16856164e-07f, -6.10069779e-07f, 6.05662189e-07f, -5.98956191e-07f, 5.94605508e-07f,
+    -5.87981873e-07f, 5.83685281e-07f, -5.77145740e-07f, 5.72900664e-07f, -5.66446719e-07f, 5.62250810e-07f,
+    -5.55883745e-07f, 5.51734870e-07f, -5.45455764e-07f, 5.41351993e-07f, -5.35161735e-07f, 5.31101322e-07f,
+    -5.25000623e-07f, 5.20982003e-07f, -5.14971405e-07f, 5.10993176e-07f, -5.05073066e-07f, 5.01133980e-07f,
+    -4.95304599e-07f, 4.91403552e-07f, -4.85665008e-07f, 4.81801028e-07f, -4.76153302e-07f, 4.72325543e-07f,
+    -4.66768500e-07f, 4.62976229e-07f, -4.57509627e-07f, 4.53752217e-07f, -4.48375717e-07f, 4.44652639e-07f,
+    -4.39365810e-07f, 4.35676625e-07f, -4.30478952e-07f, 4.26823302e-07f, -4.21714196e-07f, 4.18091799e-07f,
+    -4.13070603e-07f, 4.09481244e-07f, -4.04547236e-07f, 4.00990764e-07f, -3.96143167e-07f, 3.92619485e-07f,
+    -3.87857470e-07f, 3.84366535e-07f, -3.79689231e-07f, 3.76231040e-07f, -3.71637533e-07f, 3.68212127e-07f,
+    -3.63701468e-07f, 3.60308921e-07f, -3.55880132e-07f, 3.52520551e-07f, -3.48172625e-07f, 3.44846142e-07f,
+    -3.40578052e-07f, 3.37284822e-07f, -3.33095520e-07f, 3.29835717e-07f, -3.25724141e-07f, 3.22497958e-07f,
+    -3.18463033e-07f, 3.15270672e-07f, -3.11311314e-07f, 3.08152987e-07f, -3.04268105e-07f, 3.01144035e-07f,
+    -2.97332534e-07f, 2.94242945e-07f, -2.90503728e-07f, 2.87448849e-07f, -2.83780819e-07f, 2.80760878e-07f,
+    -2.77162942e-07f, 2.74178165e-07f, -2.70649233e-07f, 2.67699844e-07f, -2.64238832e-07f, 2.61325050e-07f,
+    -2.57930880e-07f, 2.55052917e-07f, -2.51724522e-07f, 2.48882581e-07f, -2.45618903e-07f, 2.42813181e-07f,
+    -2.39613172e-07f, 2.36843854e-07f, -2.33706478e-07f, 2.30973740e-07f, -2.27897974e-07f, 2.25201978e-07f,
+    -2.22186812e-07f, 2.19527710e-07f, -2.16572149e-07f, 2.13950079e-07f, -2.11053142e-07f, 2.08468227e-07f,
+    -2.05628948e-07f, 2.03081299e-07f, -2.00298727e-07f, 1.97788440e-07f, -1.95061641e-07f, 1.92588796e-07f,
+    -1.89916851e-07f, 1.87481516e-07f, -1.84863522e-07f, 1.82465748e-07f, -1.79900818e-07f, 1.77540640e-07f,
+    -1.75027904e-07f, 1.72705344e-07f, -1.70243949e-07f, 1.67959012e-07f, -1.65548119e-07f, 1.63300796e-07f,
+    -1.60939584e-07f, 1.58729850e-07f, -1.56417513e-07f, 1.54245327e-07f, -1.51981076e-07f, 1.49846385e-07f,
+    -1.47629445e-07f, 1.45532179e-07f, -1.43361793e-07f, 1.41301867e-07f, -1.39177290e-07f, 1.37154608e-07f,
+    -1.35075113e-07f, 1.33089561e-07f, -1.31054433e-07f, 1.29105886e-07f, -1.27114426e-07f, 1.25202745e-07f,
+    -1.23254268e-07f, 1.21379299e-07f, -1.19473133e-07f, 1.17634712e-07f, -1.15770199e-07f, 1.13968147e-07f,
+    -1.12144643e-07f, 1.10378770e-07f, -1.08595641e-07f, 1.06865745e-07f, -1.05122371e-07f, 1.03428238e-07f,
+    -1.01724013e-07f, 1.00065418e-07f, -9.83997429e-08f, 9.67764509e-08f, -9.51487415e-08f, 9.35605060e-08f,
+    -9.19701875e-08f, 9.04167521e-08f, -8.88632610e-08f, 8.73443593e-08f, -8.58271415e-08f, 8.43424981e-08f,
+    -8.28610098e-08f, 8.14103397e-08f, -7.99640464e-08f, 7.85470558e-08f, -7.71354321e-08f, 7.57518190e-08f,
+    -7.43743481e-08f, 7.30238023e-08f, -7.16799760e-08f, 7.03621793e-08f, -6.90514973e-08f, 6.77661243e-08f,
+    -6.64880939e-08f, 6.52348119e-08f, -6.39889480e-08f, 6.27674172e-08f, -6.15532420e-08f, 6.03631162e-08f,
+    -5.91801583e-08f, 5.80210850e-08f, -5.68688797e-08f, 5.57405004e-08f, -5.46185890e-08f, 5.35205395e-08f,
+    -5.24284692e-08f, 5.13603799e-08f, -5.02977037e-08f, 4.92591996e-08f, -4.82254758e-08f, 4.72161771e-08f,
+    -4.62109689e-08f, 4.52304911e-08f, -4.42533666e-08f, 4.33013210e-08f, -4.23518528e-08f, 4.14278463e-08f,
+    -4.05056112e-08f, 3.96092468e-08f, -3.87138259e-08f, 3.78447030e-08f, -3.69756810e-08f, 3.61333953e-08f,
+    -3.52903607e-08f, 3.44745046e-08f, -3.36570490e-08f, 3.28672123e-08f, -3.20749306e-08f, 3.13106996e-08f,
+    -3.05431897e-08f, 2.98041485e-08f, -2.90610109e-08f, 2.83467410e-08f, -2.76275787e-08f, 2.69376593e-08f,
+    -2.62420778e-08f, 2.55760861e-08f, -2.49036928e-08f, 2.42612041e-08f, -2.36116083e-08f, 2.29921961e-08f,
+    -2.23650095e-08f, 2.17682459e-08f, -2.11630809e-08f, 2.05885364e-08f, -2.00050071e-08f, 1.94522514e-08f,
+    -1.88899736e-08f, 1.83585749e-08f, -1.78171647e-08f, 1.73066907e-08f, -1.67857654e-08f, 1.62957830e-08f,
+    -1.57949616e-08f, 1.53250368e-08f, -1.48439365e-08f, 1.43936358e-08f, -1.39318766e-08f, 1.35007647e-08f,
+    -1.30579656e-08f, 1.26456091e-08f, -1.22213897e-08f, 1.18273536e-08f, -1.14213331e-08f, 1.10451832e-08f,
+    -1.06569809e-08f, 1.02982835e-08f, -9.92751822e-09f, 9.58583979e-09f, -9.23212983e-09f, 8.90703752e-09f,
+    -8.57000078e-09f, 8.26106249e-09f, -7.94031590e-09f, 7.64710028e-09f, -7.34226013e-09f, 7.06433691e-09f,
+    -6.77501845e-09f, 6.51195841e-09f, -6.23777569e-09f, 5.98915070e-09f, -5.72971667e-09f, 5.49510006e-09f,
+    -5.25002633e-09f, 5.02899274e-09f, -4.79788945e-09f, 4.59001501e-09f, -4.37249085e-09f, 4.17735337e-09f,
+    -3.97301541e-09f, 3.79019430e-09f, -3.59864782e-09f, 3.42772427e-09f, -3.24857294e-09f, 3.08912996e-09f,
+    -2.92197553e-09f, 2.77359800e-09f, -2.61804032e-09f, 2.48031510e-09f, -2.33595213e-09f, 2.20846803e-09f,
+    -2.07489571e-09f, 1.95724353e-09f, -1.83405580e-09f, 1.72582844e-09f, -1.61261723e-09f, 1.51340957e-09f,
+    -1.40976475e-09f, 1.31917374e-09f, -1.22468320e-09f, 1.14230781e-09f, -1.05655742e-09f, 9.81998602e-10f,
+    -9.04572270e-10f, 8.37432924e-10f, -7.67912673e-10f, 7.07797585e-10f, -6.45763591e-10f, 5.92279326e-10f,
+    -5.37310034e-10f, 4.90064874e-10f, -4.41737091e-10f, 4.00340895e-10f, -3.58229918e-10f, 3.22293974e-10f,
+    -2.85973753e-10f, 2.55110639e-10f, -2.24153943e-10f, 1.97977325e-10f, -1.71955928e-10f, 1.50080360e-10f,
+    -1.28565274e-10f, 1.10605967e-10f, -9.31676775e-11f, 7.87402373e-11f, -6.49489803e-11f, 5.36691238e-11f,
+    -4.30951817e-11f, 3.45784260e-11f, -2.67924559e-11f, 2.06537713e-11f, -1.52271613e-11f, 1.10806049e-11f,
+    -7.58586211e-12f, 5.04417075e-12f, -3.05533916e-12f, 1.72949622e-12f, -8.22608962e-13f, 3.21376636e-13f,
+    -7.49394259e-14f, 4.35688961e-15f,
+};
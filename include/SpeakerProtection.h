@@ -0,0 +1,53 @@
+#pragma once
+
+// Always-on protection for the drivers, from the model in the board profile.
+// Excursion: the signal is split at the in-box resonance (2nd-order
+// high-pass and its complement) and each part runs through the closed-box
+// displacement response, a 2nd-order low-pass at resonance. From the block's
+// peaks the stage picks how much of the low part it can keep; at zero only
+// the high-pass remains, so the effect is a dynamic high-pass that only acts
+// on loud bass. Heat: the output power on the voice coil resistance feeds a
+// first-order thermal model, and past the margin a broadband gain holds the
+// power at the level that keeps the coil there. Gains move linearly across
+// each block. Cost: three biquads per channel and a few multiply-adds per
+// frame. The coil temperature and its gain survive reset(), since the coil
+// does not cool down between streams.
+
+#include "AudioPipeline.h"
+#include "Biquad.h"
+
+class SpeakerProtection : public AudioStage {
+public:
+    SpeakerProtection();
+    const char* name() const override { return "protect"; }
+    void reset() override;
+    void process(float* left, float* right, size_t frames) override;
+    int status(char* text, size_t size) const override;
+
+    float excursionMm() const { return excursion; }     // peak of the last block
+    float coilRiseK() const { return coilRise; }
+    float speakerWatts() const { return watts; }        // both channels, about 1 s average
+    float lowGainDb() const;
+    float gainDb() const;
+
+protected:
+    void configure() override;
+
+private:
+    enum { P_MARGIN, P_RELEASE, P_COUNT };
+    AudioParam params[P_COUNT];
+
+    Biquad split[2];            // high-pass at resonance; low part = input - high
+    Biquad modelHigh[2];        // displacement of each part
+    Biquad modelLow[2];
+    float low[2][AUDIO_BLOCK_FRAMES];
+
+    float excursionLimit = 1;   // model units (full scale, 1 = excursion of a full-scale DC level)
+    float excursion = 0;
+    float coilRise = 0;
+    float watts = 0;
+    float lowGain = 1;          // share of the low part kept
+    float excursionGain = 1;
+    float thermalGain = 1;
+    float gain = 1;             // applied broadband gain, the smaller of the two
+};
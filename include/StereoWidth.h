@@ -0,0 +1,33 @@
+#pragma once
+
+// Mid/side stereo width for speakers too close together to image well. Each
+// frame is split into mid (L+R)/2 and side (L-R)/2, the side is scaled by the
+// width and the pair recombined, all in one pass over the block. Mid and side
+// gains are constant-power (gm^2 + gs^2 = 2, gs/gm = width), so uncorrelated
+// material keeps its loudness at any width; width 1 is the identity. An
+// optional 2nd-order high-pass on the side channel keeps bass mono, which the
+// drivers and the shared enclosure reproduce better. Cost: one biquad and six
+// multiply-adds per frame.
+
+#include "AudioPipeline.h"
+#include "Biquad.h"
+
+class StereoWidth : public AudioStage {
+public:
+    StereoWidth();
+    const char* name() const override { return "width"; }
+    void reset() override { sideHighPass.reset(); }
+    void process(float* left, float* right, size_t frames) override;
+
+protected:
+    void configure() override;
+
+private:
+    enum { P_WIDTH, P_MONO, P_COUNT };
+    AudioParam params[P_COUNT];
+
+    Biquad sideHighPass;
+    bool monoBass = false;
+    float midGain = 1;
+    float sideGain = 1;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+// Fixed-buffer line breaking for the OLED. Text is split into at most
+// maxLines lines of at most width characters, preferring a space in the last
+// TEXT_BREAK_SEARCH columns, with "..." on a last line that had to be cut.
+// Every index stays inside the input string and the TextLines buffers
+// whatever the input, including text without spaces, runs of spaces and
+// UTF-8 sequences (never split). No Arduino dependencies (host-buildable).
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TEXT_MAX_WIDTH          32      // characters per line, >= any panel's charsPerLine
+#define TEXT_MAX_LINES          4
+#define TEXT_BREAK_SEARCH       5       // columns searched back for a word break
+
+struct TextLines {
+    char line[TEXT_MAX_LINES][TEXT_MAX_WIDTH + 1];
+    int count;
+};
+
+// width is clamped to [4, TEXT_MAX_WIDTH] and maxLines to [1, TEXT_MAX_LINES];
+// at most maxInput bytes of text are read
+void layoutText(const char* text, int width, int maxLines, TextLines& out, size_t maxInput = 256);
@@ -0,0 +1,76 @@
+#pragma once
+
+// Binary event trace. TRACE(id, a0, a1, a2) stores a 16-byte record
+// (cycle timestamp, event id, three arguments) in a RAM ring that wraps and
+// keeps the newest events. Dump with the "trace" serial command and decode
+// on the host with tools/trace_decode.py. Define TRACE_ENABLED=0 to compile
+// every TRACE() out.
+
+#include <stdint.h>
+#include <atomic>
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+#define TRACE_RING_RECORDS 1024     // must be a power of two
+
+enum TraceEventId : uint16_t {
+#define TRACE_EVENT(name, fmt) name,
+#include "TraceEvents.def"
+#undef TRACE_EVENT
+    TRACE_EVENT_COUNT
+};
+
+struct TraceRecord {
+    uint32_t timestamp;     // CPU cycle counter of the writing core
+    uint16_t id;            // TraceEventId, bit 15 set when written on core 1
+    uint16_t a0;
+    uint32_t a1;
+    uint32_t a2;
+};
+static_assert(sizeof(TraceRecord) == 16, "trace record layout is part of the dump format");
+
+#define TRACE_CORE1_FLAG 0x8000
+
+extern TraceRecord traceRing[TRACE_RING_RECORDS];
+extern std::atomic<uint32_t> traceHead;
+extern bool traceActive;
+
+#if defined(ARDUINO)
+#include <freertos/FreeRTOS.h>
+#include <xtensa/core-macros.h>
+static inline uint32_t traceTimestamp() { return XTHAL_GET_CCOUNT(); }
+static inline uint16_t traceCoreFlag() { return xPortGetCoreID() ? TRACE_CORE1_FLAG : 0; }
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint32_t traceTimestamp() { return (uint32_t)__rdtsc(); }
+static inline uint16_t traceCoreFlag() { return 0; }
+#else
+#include <chrono>
+static inline uint32_t traceTimestamp() {
+    return (uint32_t)std::chrono::steady_clock::now().time_since_epoch().count();
+}
+static inline uint16_t traceCoreFlag() { return 0; }
+#endif
+
+static inline void traceEvent(uint16_t id, uint16_t a0, uint32_t a1, uint32_t a2) {
+    if (!traceActive) {
+        return;
+    }
+    uint32_t slot = traceHead.fetch_add(1, std::memory_order_relaxed) & (TRACE_RING_RECORDS - 1);
+    TraceRecord& r = traceRing[slot];
+    r.timestamp = traceTimestamp();
+    r.id = id | traceCoreFlag();
+    r.a0 = a0;
+    r.a1 = a1;
+    r.a2 = a2;
+}
+
+#if TRACE_ENABLED
+#define TRACE(id, a0, a1, a2) traceEvent((id), (uint16_t)(a0), (uint32_t)(a1), (uint32_t)(a2))
+#else
+#define TRACE(id, a0, a1, a2) do {} while (0)
+#endif
+
+void traceBegin();
@@ -0,0 +1,43 @@
+#pragma once
+
+// Psychoacoustic bass for drivers that cannot reproduce the fundamentals.
+// The mono low band below the crossover (4th-order Linkwitz-Riley) drives a
+// nonlinear harmonic generator: a full-wave rectifier for even harmonics
+// plus a cubic soft clipper for odd ones (less the fundamental it passes),
+// fed through a per-block envelope normalization so the harmonic mix does
+// not depend on level. The harmonics are band-limited to 1.5x..4x crossover
+// (LR4 high-pass), where the drivers play, and mixed into both channels;
+// optionally the original sub-crossover content is removed to free amplifier
+// headroom. The stage runs after the EQ, so a preset's bass shelf raises or
+// lowers the harmonics with the fundamentals they stand in for; the
+// crossover belongs to the speakers (Board::speakerLowCutHz), not to a
+// preset. Fixed cost: eight biquads and a few multiply-adds per frame, one
+// division per block.
+
+#include "AudioPipeline.h"
+#include "Biquad.h"
+#include "Envelope.h"
+
+class VirtualBass : public AudioStage {
+public:
+    VirtualBass();
+    const char* name() const override { return "bass"; }
+    void reset() override;
+    void process(float* left, float* right, size_t frames) override;
+
+protected:
+    void configure() override;
+
+private:
+    enum { P_FREQ, P_GAIN, P_DRIVE, P_EVEN, P_CUT, P_COUNT };
+    AudioParam params[P_COUNT];
+
+    Biquad lowBand[2];          // crossover, LR4
+    Biquad harmonicHigh[2];     // removes DC, the fundamental and h2 below the crossover, LR4
+    Biquad harmonicLow;         // removes harmonics above 4x crossover
+    Biquad cutLeft[2];          // optional high-pass of the main channels
+    Biquad cutRight[2];
+    EnvelopeFollower envelope;  // of the low band
+    float mixGain = 1;
+    float fundamentalGain = 0;  // of the soft clipper, subtracted from its output
+};
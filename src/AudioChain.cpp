@@ -0,0 +1,49 @@
+#include "AudioChain.h"
+#include "LoudnessMeter.h"
+#include "EqStage.h"
+#include "VirtualBass.h"
+#include "StereoWidth.h"
+#include "FirStage.h"
+#include "ChannelAlign.h"
+#include "SpeakerProtection.h"
+#include "NoiseGate.h"
+
+static AudioPipeline pipeline;
+static bool built = false;
+
+static LoudnessMeter loudnessMeter;
+static EqStage eqStage;
+static VirtualBass virtualBass;
+static StereoWidth stereoWidth;
+static FirStage firStage;
+static ChannelAlign channelAlign;
+static SpeakerProtection speakerProtection;
+static NoiseGate noiseGate;
+
+AudioPipeline& audioChain() {
+    return pipeline;
+}
+
+EqStage& audioChainEq() {
+    return eqStage;
+}
+
+float audioChainSpeakerWatts() {
+    return speakerProtection.enabled ? speakerProtection.speakerWatts() : 0;
+}
+
+void audioChainBegin(uint32_t sampleRate) {
+    if (!built) {
+        // Stages are added here in processing order
+        pipeline.add(loudnessMeter);
+        pipeline.add(eqStage);
+        pipeline.add(virtualBass);
+        pipeline.add(stereoWidth);
+        pipeline.add(firStage);
+        pipeline.add(channelAlign);
+        pipeline.add(speakerProtection);
+        pipeline.add(noiseGate);
+        built = true;
+    }
+    pipeline.begin(sampleRate);
+}
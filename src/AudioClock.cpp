@@ -0,0 +1,71 @@
+#include <math.h>
+#include "AudioClock.h"
+
+static AudioClock selected = { 44100, false, AUDIO_CLOCK_MCLK_RATIO, {}, 0 };
+
+double apllOutputHz(const ApllCoeffs& c, double xtalHz) {
+    double multiplier = 4 + c.sdm2 + c.sdm1 / 256.0 + c.sdm0 / 65536.0;
+    return xtalHz * multiplier / (2 * (c.oDiv + 2));
+}
+
+bool apllCoefficients(double targetHz, ApllCoeffs& out, bool fractional, double xtalHz) {
+    bool found = false;
+    double bestError = 0;
+    for (int oDiv = 0; oDiv <= AUDIO_CLOCK_MAX_ODIV; oDiv++) {
+        double vco = targetHz * 2 * (oDiv + 2);
+        if (vco < AUDIO_CLOCK_VCO_MIN_HZ || vco > AUDIO_CLOCK_VCO_MAX_HZ) {
+            continue;
+        }
+        // Multiplier in 1/65536 steps (whole steps only on revision 0)
+        double steps = (vco / xtalHz - 4) * 65536;
+        long sdm = fractional ? lround(steps) : lround(steps / 65536) * 65536;
+        if (sdm < 0 || sdm >> 16 > AUDIO_CLOCK_MAX_SDM2) {
+            continue;
+        }
+        ApllCoeffs c = { (uint8_t)oDiv, (uint8_t)(sdm >> 16), (uint8_t)(sdm >> 8), (uint8_t)sdm, 0 };
+        c.outputHz = apllOutputHz(c, xtalHz);
+        double vcoHz = c.outputHz * 2 * (oDiv + 2);
+        double error = fabs(c.outputHz - targetHz);
+        if (vcoHz >= AUDIO_CLOCK_VCO_MIN_HZ && vcoHz <= AUDIO_CLOCK_VCO_MAX_HZ && (!found || error < bestError)) {
+            out = c;
+            bestError = error;
+            found = true;
+        }
+    }
+    return found;
+}
+
+double dividerErrorPpm(uint32_t sampleRate) {
+    // MCLK = D2 / (n + b / a); the closest fraction with a small denominator
+    double ratio = AUDIO_CLOCK_D2_HZ / ((double)sampleRate * AUDIO_CLOCK_MCLK_RATIO);
+    double n = floor(ratio), best = n;
+    for (int a = 1; a <= AUDIO_CLOCK_DIVIDER_MAX_A; a++) {
+        double divider = n + round((ratio - n) * a) / a;
+        best = fabs(divider - ratio) < fabs(best - ratio) ? divider : best;
+    }
+    return (ratio / best - 1) * 1e6;
+}
+
+const AudioClock& audioClockSelect(uint32_t sampleRate, bool useApll, bool fractional) {
+    selected = { sampleRate, false, AUDIO_CLOCK_MCLK_RATIO, {}, dividerErrorPpm(sampleRate) };
+    if (!useApll) {
+        return selected;
+    }
+    // Low rates put 256 x fs below the APLL's range; a larger MCLK ratio is still a whole multiple of BCK
+    for (uint16_t mclkRatio = AUDIO_CLOCK_MCLK_RATIO; mclkRatio <= 8 * AUDIO_CLOCK_MCLK_RATIO; mclkRatio *= 2) {
+        double target = (double)sampleRate * mclkRatio;
+        ApllCoeffs coeffs;
+        if (apllCoefficients(target, coeffs, fractional)) {
+            selected.apll = true;
+            selected.mclkRatio = mclkRatio;
+            selected.coeffs = coeffs;
+            selected.errorPpm = (coeffs.outputHz / target - 1) * 1e6;
+            break;
+        }
+    }
+    return selected;
+}
+
+const AudioClock& audioClock() {
+    return selected;
+}
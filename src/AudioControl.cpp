@@ -0,0 +1,95 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include "AudioControl.h"
+#include "AudioChain.h"
+#include "AudioClock.h"
+#include "SerialConsole.h"
+
+static Preferences prefs;
+
+// Keys are "<stage>.<param>" and "<stage>" for the on/off state (at most 15 characters)
+static void saveStage(AudioStage& stage) {
+    char key[16];
+    prefs.putBool(stage.name(), stage.enabled);
+    for (int i = 0; i < stage.paramCount(); i++) {
+        snprintf(key, sizeof(key), "%s.%s", stage.name(), stage.param(i).name);
+        prefs.putFloat(key, stage.param(i).value);
+    }
+}
+
+static void restoreStage(AudioStage& stage) {
+    char key[16];
+    // Before streaming starts, so directly
+    stage.enabled = prefs.getBool(stage.name(), stage.enabled);
+    if (stage.enabled) {
+        stage.prepare();
+    }
+    for (int i = 0; i < stage.paramCount(); i++) {
+        snprintf(key, sizeof(key), "%s.%s", stage.name(), stage.param(i).name);
+        if (prefs.isKey(key)) {
+            stage.setParam(stage.param(i).name, prefs.getFloat(key));
+        }
+    }
+    // Apply at once instead of fading in from the defaults
+    stage.reset();
+}
+
+static void printStage(AudioStage& stage) {
+    Serial.printf("  %-10s %-3s", stage.name(), stage.enabled ? "on" : "off");
+    for (int i = 0; i < stage.paramCount(); i++) {
+        const AudioParam& p = stage.param(i);
+        Serial.printf(" %s=%g", p.name, p.value);
+    }
+    char text[80];
+    if (stage.status(text, sizeof(text)) > 0) {
+        Serial.printf("  [%s]", text);
+    }
+    Serial.println();
+}
+
+static void dspCommand(const char* args) {
+    AudioPipeline& chain = audioChain();
+    char stageName[16], param[16];
+    float value;
+    int fields = sscanf(args, "%15s %15s %f", stageName, param, &value);
+    if (fields <= 0) {
+        for (int i = 0; i < chain.count(); i++) {
+            printStage(*chain.stage(i));
+        }
+        Serial.printf("  clipped samples: %lu\n", (unsigned long)chain.clippedSamples());
+        const AudioClock& clock = audioClock();
+        Serial.printf("  I2S clock: %lu Hz from %s, %+.2f ppm\n", (unsigned long)clock.sampleRate,
+                      clock.apll ? "APLL" : "PLL_D2 divider", clock.errorPpm);
+        return;
+    }
+
+    AudioStage* stage = chain.find(stageName);
+    if (stage == nullptr) {
+        Serial.printf("dsp: no stage '%s'\n", stageName);
+        return;
+    }
+    // Applied by the audio task at its next block
+    if (fields == 2 && strcmp(param, "on") == 0) {
+        chain.postEnabled(*stage, true);
+    } else if (fields == 2 && strcmp(param, "off") == 0) {
+        chain.postEnabled(*stage, false);
+    } else if (fields == 3 && !chain.postParam(*stage, param, value)) {
+        Serial.printf("dsp: %s has no parameter '%s'\n", stageName, param);
+        return;
+    }
+    if (stage->persistent) {
+        saveStage(*stage);
+    }
+    printStage(*stage);
+}
+
+void audioControlBegin() {
+    prefs.begin("dsp", false);
+    AudioPipeline& chain = audioChain();
+    for (int i = 0; i < chain.count(); i++) {
+        if (chain.stage(i)->persistent) {
+            restoreStage(*chain.stage(i));
+        }
+    }
+    consoleRegister("dsp", "audio stages [<stage> on|off | <stage> <param> <value>]", dspCommand);
+}
@@ -0,0 +1,146 @@
+#include <string.h>
+#include <math.h>
+#include "AudioPipeline.h"
+
+static const float SAMPLE_SCALE = 1.0f / 32768.0f;
+
+bool AudioStage::storeParam(const char* param, float value) {
+    for (int i = 0; i < paramTotal; i++) {
+        AudioParam& p = paramTable[i];
+        if (strcmp(p.name, param) == 0) {
+            p.value = value < p.min ? p.min : value > p.max ? p.max : value;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AudioStage::setParam(const char* param, float value) {
+    if (!storeParam(param, value)) {
+        return false;
+    }
+    configure();
+    return true;
+}
+
+bool AudioPipeline::postParam(AudioStage& stage, const char* param, float value) {
+    if (!stage.storeParam(param, value)) {
+        return false;
+    }
+    stage.pending.fetch_or(AUDIO_PENDING_CONFIGURE);
+    return true;
+}
+
+void AudioPipeline::postEnabled(AudioStage& stage, bool on) {
+    if (on) {
+        // Reset requested before the stage is seen enabled, so its first block starts clean
+        stage.prepare();
+        stage.pending.fetch_or(AUDIO_PENDING_RESET);
+    }
+    stage.enabled = on;
+}
+
+void AudioPipeline::applyPending() {
+    for (int i = 0; i < stageCount; i++) {
+        AudioStage& stage = *stages[i];
+        if (stage.pending.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        uint32_t flags = stage.pending.exchange(0);
+        if (flags & AUDIO_PENDING_CONFIGURE) {
+            stage.configure();
+        }
+        if (flags & AUDIO_PENDING_RESET) {
+            stage.reset();
+        }
+    }
+}
+
+bool AudioPipeline::add(AudioStage& stage) {
+    if (stageCount >= AUDIO_MAX_STAGES) {
+        return false;
+    }
+    stages[stageCount++] = &stage;
+    stage.begin(rate);
+    return true;
+}
+
+void AudioPipeline::begin(uint32_t sampleRate) {
+    rate = sampleRate;
+    for (int i = 0; i < stageCount; i++) {
+        stages[i]->begin(sampleRate);
+    }
+}
+
+void AudioPipeline::reset() {
+    for (int i = 0; i < stageCount; i++) {
+        stages[i]->reset();
+    }
+}
+
+bool AudioPipeline::active() const {
+    for (int i = 0; i < stageCount; i++) {
+        if (stages[i]->enabled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+AudioStage* AudioPipeline::find(const char* name) {
+    for (int i = 0; i < stageCount; i++) {
+        if (strcmp(stages[i]->name(), name) == 0) {
+            return stages[i];
+        }
+    }
+    return nullptr;
+}
+
+// Range check in float: converting an out-of-range or NaN float to int is undefined
+static inline int16_t saturate(float x, uint32_t& clipped) {
+    float v = x * 32768.0f;
+    if (v >= 32768.0f) {
+        clipped++;
+        return 32767;
+    }
+    if (v <= -32769.0f) {
+        clipped++;
+        return -32768;
+    }
+    if (isnan(v)) {
+        // An unstable stage (e.g. a filter after a bad parameter): silence, counted as a clip
+        clipped++;
+        return 0;
+    }
+    return (int16_t)v;
+}
+
+void AudioPipeline::process(const int16_t* in, int16_t* out, size_t frames) {
+    applyPending();
+    if (!active()) {
+        if (out != in) {
+            memcpy(out, in, frames * 2 * sizeof(int16_t));
+        }
+        return;
+    }
+
+    while (frames > 0) {
+        size_t n = frames < AUDIO_BLOCK_FRAMES ? frames : AUDIO_BLOCK_FRAMES;
+        for (size_t i = 0; i < n; i++) {
+            left[i] = in[2 * i] * SAMPLE_SCALE;
+            right[i] = in[2 * i + 1] * SAMPLE_SCALE;
+        }
+        for (int s = 0; s < stageCount; s++) {
+            if (stages[s]->enabled) {
+                stages[s]->process(left, right, n);
+            }
+        }
+        for (size_t i = 0; i < n; i++) {
+            out[2 * i] = saturate(left[i], clipped);
+            out[2 * i + 1] = saturate(right[i], clipped);
+        }
+        in += 2 * n;
+        out += 2 * n;
+        frames -= n;
+    }
+}
@@ -0,0 +1,88 @@
+#include <math.h>
+#include "BatteryGauge.h"
+
+// Rest voltage of an 18650 (NMC) cell at 0, 5, ... 100 percent, mV
+static const uint16_t restCurve[] = {
+    3000, 3450, 3600, 3660, 3700, 3730, 3750, 3770, 3790, 3810, 3840,
+    3870, 3910, 3950, 3990, 4030, 4070, 4100, 4130, 4160, 4200,
+};
+static const int CURVE_POINTS = sizeof(restCurve) / sizeof(restCurve[0]);
+
+float batteryPercentAtRest(float cellVolts) {
+    float mv = cellVolts * 1000;
+    if (mv <= restCurve[0]) {
+        return 0;
+    }
+    for (int i = 1; i < CURVE_POINTS; i++) {
+        if (mv < restCurve[i]) {
+            float t = (mv - restCurve[i - 1]) / (restCurve[i] - restCurve[i - 1]);
+            return (i - 1 + t) * 100.0f / (CURVE_POINTS - 1);
+        }
+    }
+    return 100;
+}
+
+void BatteryGauge::begin(const BatteryConfig& config) {
+    cfg = config;
+    started = false;
+    belowCutoff = 0;
+    current = BATTERY_OK;
+}
+
+bool BatteryGauge::update(uint32_t nowMs, float packVolts, float loadWatts) {
+    pack = packVolts;
+    // Battery current through the boost converter, and the rest voltage it hides
+    amps = packVolts > 0.5f ? loadWatts / (cfg.boostEfficiency * packVolts) : 0;
+    float cellRest = (packVolts + amps * cfg.ohms) / cfg.cells;
+
+    if (!started) {
+        started = true;
+        rest = cellRest;
+        shown = (int)batteryPercentAtRest(rest);
+    } else {
+        float dt = (nowMs - lastMs) / 1000.0f;
+        rest += (1 - expf(-dt / cfg.filterSeconds)) * (cellRest - rest);
+        int estimate = (int)batteryPercentAtRest(rest);
+        if (estimate < shown || estimate >= shown + BATTERY_RISE_PERCENT) {
+            shown = estimate;
+        }
+    }
+    lastMs = nowMs;
+
+    BatteryLevel previous = current;
+    bool empty = rest <= cfg.cutoffVolts || packVolts / cfg.cells <= cfg.brownoutVolts;
+    belowCutoff = empty ? (belowCutoff < 255 ? belowCutoff + 1 : 255) : 0;
+    if (current == BATTERY_EMPTY) {
+        // Latched until begin()
+    } else if (belowCutoff >= cfg.emptySamples) {
+        current = BATTERY_EMPTY;
+    } else if (shown <= BATTERY_CRITICAL_PERCENT) {
+        current = BATTERY_CRITICAL;
+    } else if (shown <= BATTERY_LOW_PERCENT) {
+        if (current != BATTERY_CRITICAL || shown > BATTERY_CRITICAL_PERCENT + BATTERY_HYSTERESIS) {
+            current = BATTERY_LOW;
+        }
+    } else if (shown > BATTERY_LOW_PERCENT + BATTERY_HYSTERESIS) {
+        current = BATTERY_OK;
+    } else if (current == BATTERY_CRITICAL && shown > BATTERY_CRITICAL_PERCENT + BATTERY_HYSTERESIS) {
+        current = BATTERY_LOW;
+    }
+    return current != previous;
+}
+
+const char* BatteryGauge::levelName() const {
+    static const char* const names[] = { "ok", "low", "critical", "empty" };
+    return names[current];
+}
+
+int BatteryGauge::volumeLimit() const {
+    switch (current) {
+        case BATTERY_LOW:
+            return BATTERY_LOW_VOLUME;
+        case BATTERY_CRITICAL:
+        case BATTERY_EMPTY:
+            return BATTERY_CRITICAL_VOLUME;
+        default:
+            return 100;
+    }
+}
@@ -0,0 +1,94 @@
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "BatteryMonitor.h"
+#include "BoardProfile.h"
+#include "AudioChain.h"
+#include "Logger.h"
+#include "SerialConsole.h"
+
+static BatteryGauge gauge;
+static unsigned long lastSample = 0;
+static bool sampled = false;
+static bool logSamples = false;
+
+static float readPackVolts() {
+    uint32_t sum = 0;
+    for (int i = 0; i < BATTERY_OVERSAMPLE; i++) {
+        sum += analogReadMilliVolts(Board::batteryAdcPin);
+    }
+    return sum / (float)BATTERY_OVERSAMPLE / 1000.0f * Board::batteryDivider;
+}
+
+static float loadWatts() {
+    return Board::systemWatts + audioChainSpeakerWatts() / Board::ampEfficiency;
+}
+
+static void batteryCommand(const char* args) {
+    if (strcmp(args, "log on") == 0 || strcmp(args, "log off") == 0) {
+        logSamples = args[5] == 'n';
+        return;
+    }
+    if (!sampled) {
+        Serial.println("battery: no sample yet");
+        return;
+    }
+    Serial.printf("pack %.3f V, rest %.3f V/cell, load %.2f W (%.0f mA)\n", gauge.packVolts(), gauge.restVolts(),
+                  loadWatts(), gauge.loadAmps() * 1000);
+    Serial.printf("charge %d%%, %s, volume limit %d%%\n", gauge.percent(), gauge.levelName(), gauge.volumeLimit());
+}
+
+const BatteryGauge& batteryGauge() {
+    return gauge;
+}
+
+bool batteryMonitorUpdate(unsigned long now) {
+    if constexpr (!Board::hasBattery) {
+        return false;
+    }
+    if (sampled && now - lastSample < BATTERY_SAMPLE_INTERVAL) {
+        return false;
+    }
+    lastSample = now;
+    sampled = true;
+
+    float pack = readPackVolts();
+    float load = loadWatts();
+    bool changed = gauge.update(now, pack, load);
+    if (logSamples) {
+        // Parsed by tools/sim/battery_sim.cpp
+        Serial.printf("BATT %lu %.4f %.3f\n", now, pack, load);
+    }
+    if (changed) {
+        LOG_W("Battery %s: %d%% (%.2f V/cell), volume limit %d%%", gauge.levelName(), gauge.percent(),
+              gauge.restVolts(), gauge.volumeLimit());
+    }
+    return changed;
+}
+
+void batteryMonitorDrawIcon(Adafruit_GFX& gfx, int x, int y, unsigned long now) {
+    if (!Board::hasBattery || !sampled) {
+        return;
+    }
+    if (gauge.level() >= BATTERY_CRITICAL && (now / 500) % 2) {
+        return;
+    }
+    gfx.drawRect(x, y, 12, 7, SSD1306_WHITE);
+    gfx.fillRect(x + 12, y + 2, 2, 3, SSD1306_WHITE);
+    int fill = (gauge.percent() * 10 + 50) / 100;
+    if (fill > 0) {
+        gfx.fillRect(x + 1, y + 1, fill, 5, SSD1306_WHITE);
+    }
+}
+
+void batteryMonitorBegin() {
+    if constexpr (Board::hasBattery) {
+        analogSetPinAttenuation(Board::batteryAdcPin, ADC_11db);
+        BatteryConfig config;
+        config.cells = Board::batteryCells;
+        config.ohms = Board::batteryOhms;
+        config.boostEfficiency = Board::boostEfficiency;
+        gauge.begin(config);
+        consoleRegister("battery", "battery voltage and charge estimate [log on|off]", batteryCommand);
+    }
+}
@@ -0,0 +1,42 @@
+#include <math.h>
+#include "Biquad.h"
+
+static BiquadCoeffs normalize(float b0, float b1, float b2, float a0, float a1, float a2) {
+    return { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+}
+
+// Clamp to just below Nyquist so a high corner at a low stream rate stays stable
+static float omega(float sampleRate, float hz) {
+    float limit = sampleRate * 0.49f;
+    return 2.0f * (float)M_PI * (hz < limit ? hz : limit) / sampleRate;
+}
+
+BiquadCoeffs biquadLowPass(float sampleRate, float hz, float q) {
+    float w = omega(sampleRate, hz), cw = cosf(w), alpha = sinf(w) / (2 * q);
+    return normalize((1 - cw) / 2, 1 - cw, (1 - cw) / 2, 1 + alpha, -2 * cw, 1 - alpha);
+}
+
+BiquadCoeffs biquadHighPass(float sampleRate, float hz, float q) {
+    float w = omega(sampleRate, hz), cw = cosf(w), alpha = sinf(w) / (2 * q);
+    return normalize((1 + cw) / 2, -(1 + cw), (1 + cw) / 2, 1 + alpha, -2 * cw, 1 - alpha);
+}
+
+BiquadCoeffs biquadPeaking(float sampleRate, float hz, float q, float gainDb) {
+    float a = powf(10, gainDb / 40), w = omega(sampleRate, hz), cw = cosf(w), alpha = sinf(w) / (2 * q);
+    return normalize(1 + alpha * a, -2 * cw, 1 - alpha * a, 1 + alpha / a, -2 * cw, 1 - alpha / a);
+}
+
+// Shelves with slope S = 1
+BiquadCoeffs biquadLowShelf(float sampleRate, float hz, float gainDb) {
+    float a = powf(10, gainDb / 40), w = omega(sampleRate, hz), cw = cosf(w);
+    float alpha = sinf(w) / 2 * sqrtf(2), k = 2 * sqrtf(a) * alpha;
+    return normalize(a * ((a + 1) - (a - 1) * cw + k), 2 * a * ((a - 1) - (a + 1) * cw), a * ((a + 1) - (a - 1) * cw - k),
+                     (a + 1) + (a - 1) * cw + k, -2 * ((a - 1) + (a + 1) * cw), (a + 1) + (a - 1) * cw - k);
+}
+
+BiquadCoeffs biquadHighShelf(float sampleRate, float hz, float gainDb) {
+    float a = powf(10, gainDb / 40), w = omega(sampleRate, hz), cw = cosf(w);
+    float alpha = sinf(w) / 2 * sqrtf(2), k = 2 * sqrtf(a) * alpha;
+    return normalize(a * ((a + 1) + (a - 1) * cw + k), -2 * a * ((a - 1) + (a + 1) * cw), a * ((a + 1) + (a - 1) * cw - k),
+                     (a + 1) - (a - 1) * cw + k, 2 * ((a - 1) - (a + 1) * cw), (a + 1) - (a - 1) * cw - k);
+}
@@ -0,0 +1,29 @@
+#include <Arduino.h>
+#include <esp_gap_bt_api.h>
+#include "BtGap.h"
+#include "NameResolver.h"
+#include "LinkMonitor.h"
+
+// GAP event handler of the A2DP library
+extern "C" void ccall_app_gap_callback(esp_bt_gap_cb_event_t event, esp_bt_gap_cb_param_t* param);
+
+static void gapCallback(esp_bt_gap_cb_event_t event, esp_bt_gap_cb_param_t* param) {
+    switch (event) {
+        case ESP_BT_GAP_READ_REMOTE_NAME_EVT:
+            nameResolverOnResult(param->read_rmt_name.stat == ESP_BT_STATUS_SUCCESS,
+                                 (const char*)param->read_rmt_name.rmt_name);
+            break;
+        case ESP_BT_GAP_READ_RSSI_DELTA_EVT:
+            if (param->read_rssi_delta.stat == ESP_BT_STATUS_SUCCESS) {
+                linkMonitorOnRssi(param->read_rssi_delta.rssi_delta);
+            }
+            break;
+        default:
+            break;
+    }
+    ccall_app_gap_callback(event, param);
+}
+
+void btGapBegin() {
+    esp_bt_gap_register_callback(gapCallback);
+}
@@ -0,0 +1,34 @@
+#include <Arduino.h>
+#include <esp_bt.h>
+#include <esp_heap_caps.h>
+#include "BtMemory.h"
+#include "Logger.h"
+
+uint32_t btReleaseUnusedMemory() {
+#if BT_CLASSIC_ONLY
+    if (esp_bt_controller_get_status() != ESP_BT_CONTROLLER_STATUS_IDLE) {
+        LOG_W("BT controller already started, BLE memory not released");
+        return 0;
+    }
+    uint32_t before = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    esp_err_t err = esp_bt_controller_mem_release(ESP_BT_MODE_BLE);
+    if (err != ESP_OK) {
+        LOG_W("BLE memory release failed (%d)", err);
+        return 0;
+    }
+    uint32_t after = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    return after > before ? after - before : 0;
+#else
+    return 0;
+#endif
+}
+
+int audioBufferCount(uint32_t reclaimedBytes) {
+    uint32_t extra = reclaimedBytes * AUDIO_RECLAIM_SHARE / 100 / (AUDIO_DMA_BUFFER_FRAMES * AUDIO_FRAME_BYTES);
+    uint32_t count = AUDIO_DMA_BUFFER_COUNT + extra;
+    return count > AUDIO_DMA_BUFFER_MAX ? AUDIO_DMA_BUFFER_MAX : (int)count;
+}
+
+uint32_t audioBufferDepthMs(int bufferCount, uint32_t sampleRate) {
+    return (uint32_t)((uint64_t)bufferCount * AUDIO_DMA_BUFFER_FRAMES * 1000 / sampleRate);
+}
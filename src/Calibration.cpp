@@ -0,0 +1,236 @@
+#include <Arduino.h>
+#include <math.h>
+#include <Adafruit_GFX.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "Calibration.h"
+#include "AudioChain.h"
+#include "Logger.h"
+#include "SerialConsole.h"
+
+// Time the phone's last data callback gets to finish its I2S write before the
+// generator takes over the chain
+#define CALIBRATION_HANDOVER_MS     50
+
+struct CalibrationPreset {
+    const char* label;
+    SignalSettings settings;
+};
+
+static SignalSettings preset(uint8_t type, uint8_t channels, float level, float frequency = 1000) {
+    SignalSettings s;
+    s.type = type;
+    s.channels = channels;
+    s.level = level;
+    s.frequency = frequency;
+    return s;
+}
+
+static const CalibrationPreset presets[] = {
+    { "Pink noise", preset(SIGNAL_PINK, SIGNAL_BOTH, -20) },
+    { "Pink noise left", preset(SIGNAL_PINK, SIGNAL_LEFT, -20) },
+    { "Pink noise right", preset(SIGNAL_PINK, SIGNAL_RIGHT, -20) },
+    { "Sweep 20-20k 10s", preset(SIGNAL_SWEEP, SIGNAL_BOTH, -12) },
+    { "Tone 1 kHz", preset(SIGNAL_TONE, SIGNAL_BOTH, -20) },
+    { "Tone 100 Hz", preset(SIGNAL_TONE, SIGNAL_BOTH, -20, 100) },
+    { "Pulse left", preset(SIGNAL_PULSE, SIGNAL_LEFT, -6) },
+    { "Pulse right", preset(SIGNAL_PULSE, SIGNAL_RIGHT, -6) },
+};
+static const int PRESET_COUNT = sizeof(presets) / sizeof(presets[0]);
+
+static SignalGenerator generator;
+static CalibrationWriter writeBlock = nullptr;
+static TaskHandle_t task = nullptr;
+static portMUX_TYPE requestLock = portMUX_INITIALIZER_UNLOCKED;
+static SignalSettings request;
+static bool requestPending = false;
+static volatile bool running = false;   // from the start request until the last block is written
+static int selected = 0;
+
+static void applyRequest() {
+    portENTER_CRITICAL(&requestLock);
+    bool pending = requestPending;
+    SignalSettings settings = request;
+    requestPending = false;
+    portEXIT_CRITICAL(&requestLock);
+    if (!pending) {
+        return;
+    }
+    if (settings.type == SIGNAL_OFF) {
+        generator.stop();
+        return;
+    }
+    if (!generator.active()) {
+        vTaskDelay(pdMS_TO_TICKS(CALIBRATION_HANDOVER_MS));
+        audioChain().reset();
+    }
+    generator.start(settings, audioChain().sampleRate());
+}
+
+static void calibrationTask(void* param) {
+    static float left[CALIBRATION_BLOCK_FRAMES], right[CALIBRATION_BLOCK_FRAMES];
+    static int16_t block[CALIBRATION_BLOCK_FRAMES * 2];
+    for (;;) {
+        applyRequest();
+        if (!generator.active()) {
+            running = false;
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        generator.generate(left, right, CALIBRATION_BLOCK_FRAMES);
+        for (int i = 0; i < CALIBRATION_BLOCK_FRAMES; i++) {
+            block[2 * i] = (int16_t)lrintf(fminf(fmaxf(left[i] * 32768.0f, -32768.0f), 32767.0f));
+            block[2 * i + 1] = (int16_t)lrintf(fminf(fmaxf(right[i] * 32768.0f, -32768.0f), 32767.0f));
+        }
+        writeBlock((const uint8_t*)block, sizeof(block));
+    }
+}
+
+static void describe(const SignalSettings& s, char* text, size_t size) {
+    const char* channels = s.channels == SIGNAL_LEFT ? " left" : s.channels == SIGNAL_RIGHT ? " right" : "";
+    const char* polarity = s.invert ? " inverted" : "";
+    switch (s.type) {
+        case SIGNAL_TONE:
+            snprintf(text, size, "tone %g Hz %g dBFS%s%s", s.frequency, s.level, channels, polarity);
+            break;
+        case SIGNAL_SWEEP:
+            snprintf(text, size, "sweep %g-%g Hz in %g s, %g dBFS%s%s", s.sweepStart, s.sweepEnd, s.sweepSeconds,
+                     s.level, channels, polarity);
+            break;
+        default:
+            snprintf(text, size, "%s %g dBFS%s%s", signalTypeName(s.type), s.level, channels, polarity);
+            break;
+    }
+}
+
+bool calibrationActive() {
+    return running;
+}
+
+void calibrationStart(const SignalSettings& settings) {
+    if (task == nullptr) {
+        return;
+    }
+    portENTER_CRITICAL(&requestLock);
+    request = settings;
+    requestPending = true;
+    portEXIT_CRITICAL(&requestLock);
+    if (settings.type != SIGNAL_OFF) {
+        running = true;
+    }
+    xTaskNotifyGive(task);
+
+    char text[64];
+    describe(settings, text, sizeof(text));
+    LOG_I("Calibration signal: %s", settings.type == SIGNAL_OFF ? "off" : text);
+}
+
+void calibrationStop() {
+    calibrationStart(SignalSettings());
+}
+
+static void genCommand(const char* args) {
+    char words[8][12];
+    int count = sscanf(args, "%11s %11s %11s %11s %11s %11s %11s %11s", words[0], words[1], words[2], words[3],
+                       words[4], words[5], words[6], words[7]);
+    if (count <= 0) {
+        char text[64];
+        if (generator.active()) {
+            describe(generator.settings(), text, sizeof(text));
+            Serial.printf("gen: %s, %.1f s", text, generator.seconds());
+            if (generator.sweepFrequency() > 0) {
+                Serial.printf(", now %.0f Hz", generator.sweepFrequency());
+            }
+            Serial.println();
+        } else {
+            Serial.println("gen: off");
+        }
+        return;
+    }
+
+    SignalSettings s;
+    s.type = signalTypeFromName(words[0]);
+    if (s.type == SIGNAL_COUNT) {
+        Serial.printf("gen: no signal '%s' (off, tone, sweep, pink, pulse)\n", words[0]);
+        return;
+    }
+    // Numbers fill the signal's fields in order; words set the options
+    float* fields[4] = {};
+    switch (s.type) {
+        case SIGNAL_TONE:
+            fields[0] = &s.frequency;
+            fields[1] = &s.level;
+            break;
+        case SIGNAL_SWEEP:
+            s.level = -12;
+            fields[0] = &s.sweepStart;
+            fields[1] = &s.sweepEnd;
+            fields[2] = &s.sweepSeconds;
+            fields[3] = &s.level;
+            break;
+        case SIGNAL_PINK:
+        case SIGNAL_PULSE:
+            fields[0] = &s.level;
+            break;
+    }
+    int numbers = 0;
+    for (int i = 1; i < count; i++) {
+        char* end;
+        float value = strtof(words[i], &end);
+        if (*end == '\0' && numbers < 4 && fields[numbers] != nullptr) {
+            *fields[numbers++] = value;
+        } else if (strcmp(words[i], "left") == 0) {
+            s.channels = SIGNAL_LEFT;
+        } else if (strcmp(words[i], "right") == 0) {
+            s.channels = SIGNAL_RIGHT;
+        } else if (strcmp(words[i], "both") == 0) {
+            s.channels = SIGNAL_BOTH;
+        } else if (strcmp(words[i], "invert") == 0) {
+            s.invert = true;
+        } else {
+            Serial.printf("gen: unexpected '%s'\n", words[i]);
+            return;
+        }
+    }
+    calibrationStart(s);
+}
+
+void calibrationSelect(int direction) {
+    selected = (selected + (direction > 0 ? 1 : PRESET_COUNT - 1)) % PRESET_COUNT;
+}
+
+void calibrationToggle() {
+    if (running) {
+        calibrationStop();
+    } else {
+        calibrationStart(presets[selected].settings);
+    }
+}
+
+void calibrationDraw(Adafruit_GFX& gfx, int lines) {
+    gfx.setCursor(0, 0);
+    gfx.println(running ? "Signal   push=stop" : "Signal   push=play");
+
+    // With the signal running, the last line shows where it is
+    int rows = running && lines >= 4 ? lines - 2 : lines - 1;
+    int first = selected >= rows ? selected - rows + 1 : 0;
+    for (int i = first; i < PRESET_COUNT && i < first + rows; i++) {
+        gfx.printf("%c %-19.19s\n", i == selected ? '>' : ' ', presets[i].label);
+    }
+    if (running && lines >= 4) {
+        gfx.setCursor(0, (lines - 1) * 8);
+        if (generator.sweepFrequency() > 0) {
+            gfx.printf("%s %6.0f Hz\n", signalTypeName(generator.settings().type), generator.sweepFrequency());
+        } else {
+            gfx.printf("%s %6.1f s\n", signalTypeName(generator.settings().type), generator.seconds());
+        }
+    }
+}
+
+void calibrationBegin(CalibrationWriter writer) {
+    writeBlock = writer;
+    // Application core; the blocking I2S write leaves the core to the other tasks between blocks
+    xTaskCreatePinnedToCore(calibrationTask, "signal", 3072, nullptr, 5, &task, 1);
+    consoleRegister("gen", "calibration signal [off | tone|sweep|pink|pulse [numbers] [left|right] [invert]]",
+                    genCommand);
+}
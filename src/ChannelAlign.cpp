@@ -0,0 +1,156 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "ChannelAlign.h"
+
+static_assert((ALIGN_RING & (ALIGN_RING - 1)) == 0, "ALIGN_RING must be a power of two");
+
+ChannelAlign::ChannelAlign()
+    : params{
+          { "ltrim", 0, -12, 6 },                       // dB
+          { "rtrim", 0, -12, 6 },
+          { "linvert", 0, 0, 1 },                       // 1 = inverted polarity
+          { "rinvert", 0, 0, 1 },
+          { "ldelay", 0, 0, ALIGN_MAX_DELAY_MS },       // ms
+          { "rdelay", 0, 0, ALIGN_MAX_DELAY_MS },
+      } {
+    paramTable = params;
+    paramTotal = P_COUNT;
+    persistent = true;
+}
+
+ChannelAlign::Tap ChannelAlign::tapFor(float delayMs) const {
+    Tap tap;
+    float delay = fminf(delayMs * rate / 1000, ALIGN_RING - 2);
+    if (delay <= 0) {
+        return tap;
+    }
+    tap.whole = delay >= 1.5f ? (int)(delay - 0.5f) : 0;
+    float fraction = delay - tap.whole;
+    if (fraction > 1e-4f) {
+        tap.fractional = true;
+        tap.coeff = (1 - fraction) / (1 + fraction);
+    }
+    return tap;
+}
+
+float ChannelAlign::Tap::read(const float* ring, unsigned pos) {
+    float v = ring[(pos - whole) & (ALIGN_RING - 1)];
+    if (!fractional) {
+        return v;
+    }
+    // y[n] = a x[n] + x[n-1] - a y[n-1]
+    float y = coeff * (v - y1) + x1;
+    x1 = v;
+    y1 = y;
+    return y;
+}
+
+float ChannelAlign::delaySamples(int channel) const {
+    float ms = params[channel ? P_RDELAY : P_LDELAY].value;
+    Tap tap = tapFor(ms);
+    return tap.whole + (tap.fractional ? (1 - tap.coeff) / (1 + tap.coeff) : 0);
+}
+
+void ChannelAlign::configure() {
+    if (fade > 0) {
+        // Finish the running change first; it is picked up when the fade ends
+        deferred = true;
+        return;
+    }
+    bool changed = false;
+    bypass = true;
+    for (int ch = 0; ch < 2; ch++) {
+        Channel& c = channels[ch];
+        float trim = params[ch ? P_RTRIM : P_LTRIM].value;
+        bool invert = params[ch ? P_RINVERT : P_LINVERT].value >= 0.5f;
+        c.targetGain = powf(10, trim / 20) * (invert ? -1 : 1);
+        c.gainStep = (c.targetGain - c.gain) / ALIGN_FADE_FRAMES;
+
+        Tap next = tapFor(params[ch ? P_RDELAY : P_LDELAY].value);
+        c.crossfade = !next.sameDelay(c.tap);
+        if (c.crossfade) {
+            // Start the new allpass as if the signal had been steady, to keep its transient small
+            next.x1 = next.y1 = c.ring[(pos - 1 - next.whole) & (ALIGN_RING - 1)];
+            c.next = next;
+        }
+        changed |= c.crossfade || c.gain != c.targetGain;
+        bypass &= c.targetGain == 1 && next.whole == 0 && !next.fractional;
+    }
+    fade = changed ? ALIGN_FADE_FRAMES : 0;
+}
+
+void ChannelAlign::reset() {
+    // Nothing to fade from: take the latest settings at once
+    if (deferred) {
+        deferred = false;
+        fade = 0;
+        configure();
+    }
+    for (Channel& c : channels) {
+        memset(c.ring, 0, sizeof(c.ring));
+        if (c.crossfade) {
+            c.tap = c.next;
+            c.crossfade = false;
+        }
+        c.tap.x1 = c.tap.y1 = 0;
+        c.gain = c.targetGain;
+        c.gainStep = 0;
+    }
+    pos = 0;
+    fade = 0;
+}
+
+void ChannelAlign::processChannel(Channel& c, float* samples, size_t frames) {
+    unsigned p = pos;
+    int remaining = fade;
+    for (size_t i = 0; i < frames; i++, p++) {
+        c.ring[p & (ALIGN_RING - 1)] = samples[i];
+        float y = c.tap.read(c.ring, p);
+        if (remaining > 0) {
+            if (c.crossfade) {
+                float t = 1 - (float)remaining / ALIGN_FADE_FRAMES;
+                y += t * (c.next.read(c.ring, p) - y);
+            }
+            c.gain += c.gainStep;
+            remaining--;
+        }
+        samples[i] = c.gain * y;
+    }
+}
+
+void ChannelAlign::process(float* left, float* right, size_t frames) {
+    if (bypass && fade == 0) {
+        // Keep the history current so a delay set later starts from real samples
+        for (size_t i = 0; i < frames; i++) {
+            channels[0].ring[(pos + i) & (ALIGN_RING - 1)] = left[i];
+            channels[1].ring[(pos + i) & (ALIGN_RING - 1)] = right[i];
+        }
+        pos += frames;
+        return;
+    }
+    processChannel(channels[0], left, frames);
+    processChannel(channels[1], right, frames);
+    pos += frames;
+    if (fade > 0) {
+        fade -= fade < (int)frames ? fade : (int)frames;
+        if (fade == 0) {
+            for (Channel& c : channels) {
+                c.gain = c.targetGain;
+                c.gainStep = 0;
+                if (c.crossfade) {
+                    c.tap = c.next;
+                    c.crossfade = false;
+                }
+            }
+            if (deferred) {
+                deferred = false;
+                configure();
+            }
+        }
+    }
+}
+
+int ChannelAlign::status(char* text, size_t size) const {
+    return snprintf(text, size, "delay L %.2f R %.2f samples", delaySamples(0), delaySamples(1));
+}
@@ -0,0 +1,89 @@
+#include <stdlib.h>
+#include <string.h>
+#include "Convolver.h"
+
+bool PartitionedConvolver::begin(const float* ir, size_t taps, size_t blockSize, int channels) {
+    end();
+    if (taps == 0 || channels < 1 || channels > CONVOLVER_MAX_CHANNELS || !fft.begin(2 * blockSize)) {
+        return false;
+    }
+    size_t size = 2 * blockSize;
+    block = blockSize;
+    partCount = (taps + blockSize - 1) / blockSize;
+    channelCount = channels;
+    spectra = (float*)malloc(partCount * size * sizeof(float));
+    history = (float*)malloc(channels * partCount * size * sizeof(float));
+    window = (float*)malloc(channels * size * sizeof(float));
+    accumulator = (float*)malloc(size * sizeof(float));
+    if (spectra == nullptr || history == nullptr || window == nullptr || accumulator == nullptr) {
+        end();
+        return false;
+    }
+
+    // Each partition zero-padded to the FFT size; 1/n folds in the inverse FFT scaling
+    float scale = 1.0f / size;
+    for (size_t p = 0; p < partCount; p++) {
+        float* s = spectra + p * size;
+        size_t first = p * blockSize, count = taps - first < blockSize ? taps - first : blockSize;
+        for (size_t i = 0; i < size; i++) {
+            s[i] = i < count ? ir[first + i] * scale : 0;
+        }
+        fft.forward(s);
+    }
+    reset();
+    return true;
+}
+
+void PartitionedConvolver::end() {
+    free(spectra);
+    free(history);
+    free(window);
+    free(accumulator);
+    spectra = history = window = accumulator = nullptr;
+    fft.end();
+    block = partCount = 0;
+    channelCount = 0;
+}
+
+void PartitionedConvolver::reset() {
+    if (history == nullptr) {
+        return;
+    }
+    size_t size = 2 * block;
+    memset(history, 0, channelCount * partCount * size * sizeof(float));
+    memset(window, 0, channelCount * size * sizeof(float));
+    memset(head, 0, sizeof(head));
+}
+
+size_t PartitionedConvolver::memoryBytes() const {
+    size_t size = 2 * block;
+    return ((partCount * (1 + channelCount) + channelCount + 1) * size) * sizeof(float) +
+           block * (2 * sizeof(float) + sizeof(uint16_t));
+}
+
+void PartitionedConvolver::process(int channel, const float* in, float* out) {
+    size_t size = 2 * block;
+    float* win = window + channel * size;
+    float* line = history + channel * partCount * size;
+
+    // Slide the input window by one block and transform it into the newest history slot
+    memmove(win, win + block, block * sizeof(float));
+    memcpy(win + block, in, block * sizeof(float));
+    size_t newest = head[channel];
+    float* slot = line + newest * size;
+    memcpy(slot, win, size * sizeof(float));
+    fft.forward(slot);
+
+    // Partition p meets the input spectrum from p blocks ago
+    memset(accumulator, 0, size * sizeof(float));
+    size_t slotIndex = newest;
+    for (size_t p = 0; p < partCount; p++) {
+        spectrumMultiplyAdd(accumulator, spectra + p * size, line + slotIndex * size, size);
+        slotIndex = slotIndex == 0 ? partCount - 1 : slotIndex - 1;
+    }
+    head[channel] = newest + 1 == partCount ? 0 : newest + 1;
+
+    // Overlap-save: the first half is circular wrap-around, the second half is valid output
+    fft.inverse(accumulator);
+    memcpy(out, accumulator + block, block * sizeof(float));
+}
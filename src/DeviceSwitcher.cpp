@@ -0,0 +1,313 @@
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Preferences.h>
+#include <esp_gap_bt_api.h>
+#include "DeviceSwitcher.h"
+#include "PairedDevices.h"
+#include "NameResolver.h"
+#include "ReconnectPolicy.h"
+#include "Logger.h"
+#include "SerialConsole.h"
+
+static BluetoothA2DPSink* a2dp = nullptr;
+static PairedDeviceList pairedDevices;
+static Preferences prefs;
+
+static ReconnectPolicy policy;
+static RadioMode appliedMode = { true, true };     // the sink starts discoverable
+static int attemptIndex = 0;            // list index of the phone being paged
+static uint8_t targetAddress[6];
+static unsigned long attemptStart = 0;
+static int selected = 0;
+
+// Written by the BT task, consumed by deviceSwitcherUpdate()
+static volatile esp_a2d_connection_state_t linkState = ESP_A2D_CONNECTION_STATE_DISCONNECTED;
+static volatile bool linkChanged = false;
+
+static bool namePending = false;
+static char pendingName[PAIRED_NAME_LENGTH];
+
+static int currentVolume = 0;
+static bool volumePending = false;
+static int pendingVolume = 0;
+static bool eqPending = false;
+static int pendingEqPreset = 0;
+static bool saveDirty = false;
+static unsigned long lastChange = 0;
+
+// Connection time of the last attempt per list slot, for the "devices" command
+static unsigned long connectTimes[PAIRED_MAX_DEVICES];
+
+static void saveList() {
+    uint8_t blob[PairedDeviceList::blobSize(PAIRED_MAX_DEVICES)];
+    size_t size = pairedDevices.serialize(blob, sizeof(blob));
+    prefs.putBytes("paired", blob, size);
+    saveDirty = false;
+}
+
+static void startAttempt(int index, unsigned long now) {
+    char text[18];
+    memcpy(targetAddress, pairedDevices.at(index).address, 6);
+    formatAddress(targetAddress, text, sizeof(text));
+    attemptIndex = index;
+    attemptStart = now;
+    LOG_I("Connecting to %s (backoff %lu ms)", text, (unsigned long)policy.currentBackoffMs());
+    a2dp->connect_to(targetAddress);
+}
+
+static void applyRadioMode(unsigned long now) {
+    RadioMode mode = policy.radioMode(now);
+    if (mode != appliedMode) {
+        esp_bt_gap_set_scan_mode(mode.connectable ? ESP_BT_CONNECTABLE : ESP_BT_NON_CONNECTABLE,
+                                 mode.discoverable ? ESP_BT_GENERAL_DISCOVERABLE : ESP_BT_NON_DISCOVERABLE);
+        appliedMode = mode;
+    }
+}
+
+static void onConnected(unsigned long now) {
+    esp_bd_addr_t* peer = a2dp->get_current_peer_address();
+    if (peer == nullptr) {
+        return;
+    }
+
+    bool paged = policy.isPaging();
+    unsigned long elapsed = paged ? now - attemptStart : 0;
+    policy.onConnected(now);
+    // The stack sets its own scan mode while a phone is connected
+    appliedMode = { false, false };
+
+    // Keep the timing table aligned with the list, which moves this phone to the front
+    int index = pairedDevices.find(*peer);
+    if (index < 0) {
+        index = pairedDevices.count() < PAIRED_MAX_DEVICES ? pairedDevices.count() : PAIRED_MAX_DEVICES - 1;
+    }
+    memmove(&connectTimes[1], &connectTimes[0], index * sizeof(connectTimes[0]));
+    connectTimes[0] = elapsed;
+
+    PairedDevice& device = pairedDevices.touch(*peer, (uint8_t)currentVolume);
+    if (paged) {
+        LOG_I("Connected after %lu ms (list entry %d)", elapsed, attemptIndex);
+    }
+    LOG_I("Link up %lu ms after disconnect (or boot)", (unsigned long)policy.stats().lastReconnectMs);
+
+    pendingVolume = device.volume;
+    volumePending = true;
+    pendingEqPreset = device.eqPreset;
+    eqPending = true;
+
+    // Show the cached name now and refresh it from the phone in the background
+    if (device.name[0] != '\0') {
+        strcpy(pendingName, device.name);
+        namePending = true;
+    }
+    nameResolverRequest(device.address, now);
+    selected = 0;
+    saveList();
+}
+
+static void devicesCommand(const char* args) {
+    if (strncmp(args, "forget ", 7) == 0) {
+        int index = atoi(args + 7);
+        if (index >= 0 && index < pairedDevices.count()) {
+            uint8_t address[6];
+            memcpy(address, pairedDevices.at(index).address, 6);
+            memmove(&connectTimes[index], &connectTimes[index + 1],
+                    (pairedDevices.count() - index - 1) * sizeof(connectTimes[0]));
+            pairedDevices.remove(address);
+            saveList();
+        }
+    }
+    for (int i = 0; i < pairedDevices.count(); i++) {
+        const PairedDevice& d = pairedDevices.at(i);
+        char text[18];
+        formatAddress(d.address, text, sizeof(text));
+        Serial.printf("  %d %s %-23s vol %3u eq %u seen #%lu last connect %lu ms\n", i, text, d.name,
+                      d.volume, d.eqPreset, (unsigned long)d.lastSeen, connectTimes[i]);
+    }
+}
+
+static void reconnectCommand(const char* args) {
+    if (strcmp(args, "reset") == 0) {
+        policy.resetStats();
+    }
+    const ReconnectStats& st = policy.stats();
+    const ReconnectConfig& cfg = policy.settings();
+    Serial.printf("  attempts %lu, timeouts %lu, reconnects %lu\n", (unsigned long)st.attempts,
+                  (unsigned long)st.timeouts, (unsigned long)st.reconnects);
+    Serial.printf("  reconnect time last %lu ms, worst %lu ms, mean %lu ms\n", (unsigned long)st.lastReconnectMs,
+                  (unsigned long)st.worstReconnectMs,
+                  (unsigned long)(st.reconnects ? st.totalReconnectMs / st.reconnects : 0));
+    Serial.printf("  radio busy %lu of %lu ms disconnected, backoff now %lu ms\n", (unsigned long)st.radioBusyMs,
+                  (unsigned long)st.disconnectedMs, (unsigned long)policy.currentBackoffMs());
+    Serial.printf("  policy: page %lu ms, backoff %lu..%lu ms x%u, discoverable %lu ms, scan %u%% of %lu ms\n",
+                  (unsigned long)cfg.attemptTimeoutMs, (unsigned long)cfg.initialBackoffMs,
+                  (unsigned long)cfg.maxBackoffMs, cfg.backoffFactor, (unsigned long)cfg.discoverableMs,
+                  cfg.maxScanDutyPct, (unsigned long)cfg.scanPeriodMs);
+}
+
+void deviceSwitcherBegin(BluetoothA2DPSink& sink, int defaultVolume) {
+    a2dp = &sink;
+    currentVolume = defaultVolume;
+    prefs.begin("speaker", false);
+
+    uint8_t blob[PairedDeviceList::blobSize(PAIRED_MAX_DEVICES)];
+    size_t size = prefs.getBytes("paired", blob, sizeof(blob));
+    if (size > 0 && !pairedDevices.deserialize(blob, size)) {
+        LOG_W("Paired device list in NVS is invalid, starting empty");
+        pairedDevices.clear();
+    }
+    LOG_I("%d paired device(s) remembered", pairedDevices.count());
+
+    consoleRegister("devices", "list paired phones [forget N]", devicesCommand);
+    consoleRegister("reconnect", "reconnect statistics [reset]", reconnectCommand);
+
+    // Walk the list from the most recent phone on boot
+    policy.begin(millis());
+}
+
+void deviceSwitcherOnConnection(esp_a2d_connection_state_t newState) {
+    linkState = newState;
+    linkChanged = true;
+}
+
+void deviceSwitcherUpdate(unsigned long now) {
+    if (linkChanged) {
+        linkChanged = false;
+        if (linkState == ESP_A2D_CONNECTION_STATE_CONNECTED) {
+            onConnected(now);
+        } else if (linkState == ESP_A2D_CONNECTION_STATE_DISCONNECTED) {
+            if (saveDirty) {
+                saveList();
+            }
+            policy.onDisconnected(now);
+        }
+    }
+
+    // Page the next phone when the policy says so, and duty-cycle scanning
+    int index = policy.poll(now, pairedDevices.count());
+    if (index >= 0) {
+        startAttempt(index, now);
+    }
+    if (!a2dp->is_connected()) {
+        applyRadioMode(now);
+    }
+
+    // Full length name; the list cuts it to PAIRED_NAME_LENGTH on a character boundary
+    uint8_t address[6];
+    char name[ESP_BT_GAP_MAX_BDNAME_LEN + 1];
+    if (nameResolverTake(address, name, sizeof(name), now)) {
+        if (pairedDevices.setName(address, name)) {
+            saveList();
+        }
+        if (pairedDevices.find(address) == 0 && a2dp->is_connected()) {
+            strcpy(pendingName, pairedDevices.at(0).name);
+            namePending = true;
+        }
+    }
+
+    if (saveDirty && now - lastChange > SWITCH_SAVE_DELAY) {
+        saveList();
+    }
+}
+
+void deviceSwitcherVolumeChanged(int volume) {
+    currentVolume = volume;
+    if (!a2dp->is_connected() || pairedDevices.count() == 0) {
+        return;
+    }
+    // The connected phone is always at the front of the list
+    pairedDevices.at(0).volume = (uint8_t)volume;
+    saveDirty = true;
+    lastChange = millis();
+}
+
+void deviceSwitcherEqPresetChanged(int preset) {
+    if (!a2dp->is_connected() || pairedDevices.count() == 0 || pairedDevices.at(0).eqPreset == preset) {
+        return;
+    }
+    pairedDevices.at(0).eqPreset = (uint8_t)preset;
+    saveDirty = true;
+    lastChange = millis();
+}
+
+void deviceSwitcherFlush() {
+    if (saveDirty) {
+        saveList();
+    }
+}
+
+bool deviceSwitcherTakeVolume(int& volume) {
+    if (!volumePending) {
+        return false;
+    }
+    volumePending = false;
+    volume = pendingVolume;
+    return true;
+}
+
+bool deviceSwitcherTakeEqPreset(int& preset) {
+    if (!eqPending) {
+        return false;
+    }
+    eqPending = false;
+    preset = pendingEqPreset;
+    return true;
+}
+
+bool deviceSwitcherTakeName(char* name, size_t size) {
+    if (!namePending) {
+        return false;
+    }
+    namePending = false;
+    snprintf(name, size, "%s", pendingName);
+    return true;
+}
+
+void deviceSwitcherSelect(int step) {
+    int count = pairedDevices.count();
+    if (count > 0) {
+        selected = ((selected + step) % count + count) % count;
+    }
+}
+
+void deviceSwitcherConnectSelected() {
+    if (selected >= pairedDevices.count()) {
+        return;
+    }
+    const uint8_t* address = pairedDevices.at(selected).address;
+    if (a2dp->is_connected()) {
+        esp_bd_addr_t* peer = a2dp->get_current_peer_address();
+        if (peer != nullptr && memcmp(*peer, address, 6) == 0) {
+            return;
+        }
+        // Drop the current phone first; the policy pages the selection once disconnected
+        policy.request(selected, millis());
+        a2dp->disconnect();
+    } else {
+        policy.request(selected, millis());
+    }
+}
+
+void deviceSwitcherDraw(Adafruit_GFX& gfx, int lines) {
+    gfx.setCursor(0, 0);
+    gfx.println(policy.isPaging() ? "Devices  connecting.." : "Devices  push=connect");
+    if (pairedDevices.count() == 0) {
+        gfx.println("No paired phones");
+        return;
+    }
+
+    // Scroll so the selection stays visible
+    int rows = lines - 1;
+    int first = selected >= rows ? selected - rows + 1 : 0;
+    for (int i = first; i < pairedDevices.count() && i < first + rows; i++) {
+        const PairedDevice& d = pairedDevices.at(i);
+        char label[18];
+        if (d.name[0] != '\0') {
+            snprintf(label, sizeof(label), "%s", d.name);
+        } else {
+            formatAddress(d.address, label, sizeof(label));
+        }
+        bool connected = i == 0 && a2dp->is_connected();
+        gfx.printf("%c%c%-19.19s\n", i == selected ? '>' : ' ', connected ? '*' : ' ', label);
+    }
+}
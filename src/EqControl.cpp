@@ -0,0 +1,149 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include "EqControl.h"
+#include "EqStage.h"
+#include "AudioChain.h"
+#include "DeviceSwitcher.h"
+#include "SerialConsole.h"
+#include "Logger.h"
+
+static Preferences prefs;
+
+static void saveUserSlots() {
+    uint8_t blob[EqPresetBank::blobSize()];
+    size_t size = audioChainEq().presets().serialize(blob, sizeof(blob));
+    prefs.putBytes("user", blob, size);
+}
+
+static void printPreset(int index) {
+    EqStage& eq = audioChainEq();
+    const EqPreset& preset = eq.presets().at(index);
+    Serial.printf(" %c%d %-11s%s\n", index == eq.preset() ? '*' : ' ', index, preset.name,
+                  EqPresetBank::isUser(index) ? " (user)" : "");
+    for (int b = 0; b < EQ_BANDS; b++) {
+        const EqBand& band = preset.bands[b];
+        if (band.type != EQ_OFF) {
+            Serial.printf("      %d %-9s %6.0f Hz %+5.1f dB q %.2f\n", b, eqBandTypeName(band.type), eqBandHz(band),
+                          eqBandGainDb(band), eqBandQ(band));
+        }
+    }
+}
+
+// Parses a user slot number; prints why not and returns -1 otherwise
+static int userSlot(const char* text) {
+    int index = atoi(text);
+    if (!EqPresetBank::isUser(index)) {
+        Serial.printf("eq: %s is not a user slot (%d-%d)\n", text, EQ_BUILTIN_PRESETS, EQ_PRESET_COUNT - 1);
+        return -1;
+    }
+    return index;
+}
+
+static void storeUserSlot(int index, const EqPreset& preset) {
+    EqStage& eq = audioChainEq();
+    eq.presets().setUser(index, preset);
+    saveUserSlots();
+    eq.reload(index);
+    printPreset(index);
+}
+
+static void eqCommand(const char* args) {
+    EqStage& eq = audioChainEq();
+    char word[8];
+    int used = 0;
+    if (sscanf(args, "%7s %n", word, &used) <= 0) {
+        for (int i = 0; i < EQ_PRESET_COUNT; i++) {
+            printPreset(i);
+        }
+        return;
+    }
+    const char* rest = args + used;
+
+    if (strcmp(word, "next") == 0) {
+        eqControlNext();
+        printPreset(eq.preset());
+    } else if (isdigit((unsigned char)word[0])) {
+        eqControlSelect(atoi(word));
+        printPreset(eq.preset());
+    } else if (strcmp(word, "show") == 0) {
+        int index = atoi(rest);
+        char text[EQ_TEXT_LENGTH];
+        eqPresetFormat(eq.presets().at(index), text, sizeof(text));
+        Serial.printf("eq load %d %s\n", EqPresetBank::isUser(index) ? index : EQ_BUILTIN_PRESETS, text);
+    } else if (strcmp(word, "load") == 0) {
+        int index = userSlot(rest);
+        const char* text = strchr(rest, ' ');
+        EqPreset preset;
+        if (index < 0) {
+            return;
+        }
+        if (text == nullptr || !eqPresetParse(text, preset)) {
+            Serial.println("eq: expected 5 bands of 8 hex digits, then a name");
+            return;
+        }
+        storeUserSlot(index, preset);
+    } else if (strcmp(word, "band") == 0) {
+        char slotText[4], typeName[12];
+        int band;
+        float hz, gain, q;
+        if (sscanf(rest, "%3s %d %11s %f %f %f", slotText, &band, typeName, &hz, &gain, &q) != 6 || band < 0 ||
+            band >= EQ_BANDS) {
+            Serial.println("eq: band <slot> <0-4> <off|peak|lowshelf|highshelf|lowpass|highpass> <hz> <dB> <q>");
+            return;
+        }
+        int index = userSlot(slotText);
+        uint8_t type = eqBandTypeFromName(typeName);
+        if (index < 0) {
+            return;
+        }
+        if (type == EQ_TYPE_COUNT) {
+            Serial.printf("eq: no band type '%s'\n", typeName);
+            return;
+        }
+        EqPreset preset = eq.presets().at(index);
+        preset.bands[band] = eqBand(type, hz, gain, q);
+        storeUserSlot(index, preset);
+    } else if (strcmp(word, "name") == 0) {
+        int index = userSlot(rest);
+        const char* name = strchr(rest, ' ');
+        if (index < 0) {
+            return;
+        }
+        EqPreset preset = eq.presets().at(index);
+        snprintf(preset.name, sizeof(preset.name), "%s", name != nullptr ? name + 1 : "");
+        storeUserSlot(index, preset);
+    } else {
+        Serial.printf("eq: unknown '%s'\n", word);
+    }
+}
+
+void eqControlBegin() {
+    prefs.begin("eq", false);
+    uint8_t blob[EqPresetBank::blobSize()];
+    size_t size = prefs.getBytes("user", blob, sizeof(blob));
+    if (size > 0 && !audioChainEq().presets().deserialize(blob, size)) {
+        LOG_W("EQ user presets in NVS are invalid, using flat");
+    }
+    consoleRegister("eq", "EQ presets [<n>|next | show <n> | load|band|name <slot> ...]", eqCommand);
+}
+
+void eqControlApply(int index) {
+    // Clamped to the bank; the switch starts on the audio task
+    audioChain().postParam(audioChainEq(), "preset", (float)index);
+}
+
+void eqControlSelect(int index) {
+    eqControlApply(index);
+    deviceSwitcherEqPresetChanged(audioChainEq().preset());
+}
+
+int eqControlNext() {
+    int index = (audioChainEq().preset() + 1) % EQ_PRESET_COUNT;
+    eqControlSelect(index);
+    return index;
+}
+
+const char* eqControlPresetName() {
+    EqStage& eq = audioChainEq();
+    return eq.presets().at(eq.preset()).name;
+}
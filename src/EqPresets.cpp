@@ -0,0 +1,158 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "EqPresets.h"
+
+// Band codes: { type, 20 Hz * 1000^(freq/255), gain / 0.5 dB, q / 0.05 }
+static const EqPreset builtinPresets[EQ_BUILTIN_PRESETS] = {
+    { {}, "Flat" },
+    // Low shelf 150 Hz +6 dB (into the virtual bass range), high shelf 10 kHz +2 dB
+    { { { EQ_LOW_SHELF, 74, 12, 14 }, { EQ_HIGH_SHELF, 229, 4, 14 } }, "Bass boost" },
+    // Rumble cut at 120 Hz, less chest at 300 Hz, presence at 2.5 kHz
+    { { { EQ_HIGH_PASS, 66, 0, 14 }, { EQ_LOW_SHELF, 100, -6, 14 }, { EQ_PEAK, 178, 8, 20 } }, "Voice" },
+    // Quiet listening: less bass and treble to disturb others, a little presence to stay intelligible
+    { { { EQ_LOW_SHELF, 85, -12, 14 }, { EQ_HIGH_SHELF, 211, -8, 14 }, { EQ_PEAK, 170, 4, 14 } }, "Night" },
+};
+
+static const char* const typeNames[EQ_TYPE_COUNT] = { "off", "peak", "lowshelf", "highshelf", "lowpass", "highpass" };
+
+static float clampf(float x, float lo, float hi) {
+    return x < lo ? lo : x > hi ? hi : x;
+}
+
+EqBand eqBand(uint8_t type, float hz, float gainDb, float q) {
+    EqBand band;
+    band.type = type < EQ_TYPE_COUNT ? type : (uint8_t)EQ_OFF;
+    band.freq = (uint8_t)lroundf(clampf(255 * log10f(hz / 20) / 3, 0, 255));
+    band.gain = (int8_t)lroundf(clampf(gainDb * 2, -128, 127));
+    band.q = (uint8_t)lroundf(clampf(q * 20, 1, 255));
+    return band;
+}
+
+float eqBandHz(const EqBand& band) {
+    return 20 * powf(1000, band.freq / 255.0f);
+}
+
+float eqBandGainDb(const EqBand& band) {
+    return band.gain * 0.5f;
+}
+
+float eqBandQ(const EqBand& band) {
+    return (band.q ? band.q : 1) * 0.05f;
+}
+
+const char* eqBandTypeName(uint8_t type) {
+    return type < EQ_TYPE_COUNT ? typeNames[type] : "?";
+}
+
+uint8_t eqBandTypeFromName(const char* name) {
+    for (uint8_t i = 0; i < EQ_TYPE_COUNT; i++) {
+        if (strcmp(name, typeNames[i]) == 0) {
+            return i;
+        }
+    }
+    return EQ_TYPE_COUNT;
+}
+
+BiquadCoeffs eqBandCoeffs(const EqBand& band, float sampleRate) {
+    // Keep the design below Nyquist for the rates the sink may run at
+    float hz = fminf(eqBandHz(band), sampleRate * 0.45f);
+    switch (band.type) {
+        case EQ_PEAK:
+            return biquadPeaking(sampleRate, hz, eqBandQ(band), eqBandGainDb(band));
+        case EQ_LOW_SHELF:
+            return biquadLowShelf(sampleRate, hz, eqBandGainDb(band));
+        case EQ_HIGH_SHELF:
+            return biquadHighShelf(sampleRate, hz, eqBandGainDb(band));
+        case EQ_LOW_PASS:
+            return biquadLowPass(sampleRate, hz, eqBandQ(band));
+        case EQ_HIGH_PASS:
+            return biquadHighPass(sampleRate, hz, eqBandQ(band));
+        default:
+            return BiquadCoeffs{ 1, 0, 0, 0, 0 };
+    }
+}
+
+int eqActiveBands(const EqPreset& preset) {
+    int count = 0;
+    for (const EqBand& band : preset.bands) {
+        bool gainOnly = band.type == EQ_PEAK || band.type == EQ_LOW_SHELF || band.type == EQ_HIGH_SHELF;
+        count += band.type != EQ_OFF && band.type < EQ_TYPE_COUNT && !(gainOnly && band.gain == 0);
+    }
+    return count;
+}
+
+void eqPresetFormat(const EqPreset& preset, char* text, size_t size) {
+    int length = 0;
+    for (const EqBand& band : preset.bands) {
+        length += snprintf(text + length, size > (size_t)length ? size - length : 0, "%02x%02x%02x%02x ",
+                           band.type, band.freq, (uint8_t)band.gain, band.q);
+    }
+    snprintf(text + length, size > (size_t)length ? size - length : 0, "%s", preset.name);
+}
+
+bool eqPresetParse(const char* text, EqPreset& preset) {
+    EqPreset parsed = {};
+    for (EqBand& band : parsed.bands) {
+        unsigned type, freq, gain, q;
+        int used = 0;
+        while (*text == ' ') {
+            text++;
+        }
+        if (sscanf(text, "%2x%2x%2x%2x%n", &type, &freq, &gain, &q, &used) != 4 || used != 8 ||
+            type >= EQ_TYPE_COUNT) {
+            return false;
+        }
+        band = { (uint8_t)type, (uint8_t)freq, (int8_t)(uint8_t)gain, (uint8_t)q };
+        text += used;
+    }
+    while (*text == ' ') {
+        text++;
+    }
+    snprintf(parsed.name, sizeof(parsed.name), "%s", *text ? text : "User");
+    preset = parsed;
+    return true;
+}
+
+EqPresetBank::EqPresetBank() {
+    for (int i = 0; i < EQ_USER_SLOTS; i++) {
+        user[i] = {};
+        snprintf(user[i].name, sizeof(user[i].name), "User %d", i + 1);
+    }
+}
+
+const EqPreset& EqPresetBank::at(int index) const {
+    if (isUser(index)) {
+        return user[index - EQ_BUILTIN_PRESETS];
+    }
+    return builtinPresets[index >= 0 && index < EQ_BUILTIN_PRESETS ? index : 0];
+}
+
+bool EqPresetBank::setUser(int index, const EqPreset& preset) {
+    if (!isUser(index)) {
+        return false;
+    }
+    user[index - EQ_BUILTIN_PRESETS] = preset;
+    user[index - EQ_BUILTIN_PRESETS].name[EQ_NAME_LENGTH - 1] = '\0';
+    return true;
+}
+
+size_t EqPresetBank::serialize(uint8_t* out, size_t capacity) const {
+    if (capacity < blobSize()) {
+        return 0;
+    }
+    out[0] = EQ_BLOB_VERSION;
+    memcpy(out + 1, user, sizeof(user));
+    return blobSize();
+}
+
+bool EqPresetBank::deserialize(const uint8_t* data, size_t length) {
+    if (length < blobSize() || data[0] != EQ_BLOB_VERSION) {
+        return false;
+    }
+    memcpy(user, data + 1, sizeof(user));
+    for (EqPreset& preset : user) {
+        preset.name[EQ_NAME_LENGTH - 1] = '\0';
+    }
+    return true;
+}
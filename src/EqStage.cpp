@@ -0,0 +1,149 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "EqStage.h"
+
+EqStage::EqStage()
+    : params{
+          { "preset", 0, 0, EQ_PRESET_COUNT - 1 },      // index into the bank, see "eq list"
+      } {
+    paramTable = params;
+    paramTotal = P_COUNT;
+}
+
+void EqStage::design(FilterBank& filters, int index) {
+    const EqPreset& preset = bank.at(index);
+    filters.bands = 0;
+    for (const EqBand& band : preset.bands) {
+        bool passFilter = band.type == EQ_LOW_PASS || band.type == EQ_HIGH_PASS;
+        if (band.type == EQ_OFF || band.type >= EQ_TYPE_COUNT || (!passFilter && band.gain == 0)) {
+            continue;
+        }
+        BiquadCoeffs c = eqBandCoeffs(band, rate);
+        filters.left[filters.bands] = Biquad{ c };
+        filters.right[filters.bands] = Biquad{ c };
+        filters.bands++;
+    }
+}
+
+int EqStage::latest() const {
+    return queued >= 0 ? queued : switching() ? target : current;
+}
+
+void EqStage::startSwitch(int index) {
+    if (switching()) {
+        queued = index == target ? -1 : index;
+        return;
+    }
+    // The idle bank is not touched by process() outside a switch
+    design(filters[active ^ 1], index);
+    target = index;
+    warmup = EQ_WARMUP_FRAMES;
+    fade = EQ_FADE_FRAMES;
+}
+
+void EqStage::finishSwitch() {
+    active ^= 1;
+    current = target;
+    warmup = fade = 0;
+    if (queued >= 0) {
+        int next = queued;
+        queued = -1;
+        startSwitch(next);
+    }
+}
+
+void EqStage::configure() {
+    int index = preset();
+    int changed = edited.exchange(-1);
+    if (rate != designedRate) {
+        // New stream: nothing to crossfade from
+        warmup = fade = 0;
+        queued = -1;
+        design(filters[active], index);
+        current = index;
+        designedRate = rate;
+    } else if (index != latest()) {
+        startSwitch(index);
+    } else if (changed == index && switching()) {
+        // Even if it is the switch target: that bank holds the old design
+        queued = index;
+    } else if (changed == index) {
+        startSwitch(index);
+    }
+}
+
+void EqStage::reload(int index) {
+    edited.store(index);
+    postConfigure();
+}
+
+void EqStage::reset() {
+    // A stream restart has no audio to hide the switch in; apply the latest request at once
+    if (switching()) {
+        active ^= 1;
+        current = target;
+        warmup = fade = 0;
+    }
+    if (queued >= 0) {
+        design(filters[active], queued);
+        current = queued;
+        queued = -1;
+    }
+    for (FilterBank& f : filters) {
+        for (int i = 0; i < EQ_BANDS; i++) {
+            f.left[i].reset();
+            f.right[i].reset();
+        }
+    }
+}
+
+void EqStage::run(FilterBank& f, float* left, float* right, size_t frames) {
+    for (int b = 0; b < f.bands; b++) {
+        Biquad& l = f.left[b];
+        Biquad& r = f.right[b];
+        for (size_t i = 0; i < frames; i++) {
+            left[i] = l.process(left[i]);
+            right[i] = r.process(right[i]);
+        }
+    }
+}
+
+void EqStage::process(float* left, float* right, size_t frames) {
+    if (!switching()) {
+        run(filters[active], left, right, frames);
+        return;
+    }
+
+    FilterBank& next = filters[active ^ 1];
+    memcpy(scratchLeft, left, frames * sizeof(float));
+    memcpy(scratchRight, right, frames * sizeof(float));
+    run(next, scratchLeft, scratchRight, frames);
+    run(filters[active], left, right, frames);
+
+    size_t i = 0;
+    if (warmup > 0) {
+        i = frames < (size_t)warmup ? frames : (size_t)warmup;
+        warmup -= (int)i;
+    }
+    for (; i < frames && fade > 0; i++, fade--) {
+        float t = 1 - (float)fade / EQ_FADE_FRAMES;
+        left[i] += t * (scratchLeft[i] - left[i]);
+        right[i] += t * (scratchRight[i] - right[i]);
+    }
+    if (fade == 0) {
+        // Rest of the block comes from the new bank alone
+        for (; i < frames; i++) {
+            left[i] = scratchLeft[i];
+            right[i] = scratchRight[i];
+        }
+        finishSwitch();
+    }
+}
+
+int EqStage::status(char* text, size_t size) const {
+    if (switching()) {
+        return snprintf(text, size, "%s -> %s", bank.at(current).name, bank.at(target).name);
+    }
+    return snprintf(text, size, "%s, %d band(s)", bank.at(current).name, filters[active].bands);
+}
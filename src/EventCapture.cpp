@@ -0,0 +1,100 @@
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include "EventCapture.h"
+#include "Player.h"
+#include "SerialConsole.h"
+
+volatile bool captureActive = false;
+
+// Hooks run on the Bluetooth task and the loop task
+static portMUX_TYPE captureLock = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t* buffer = nullptr;
+static size_t used = 0;
+static uint32_t lastUs = 0;
+static uint32_t dropped = 0;
+static const Player* capturePlayer = nullptr;
+
+void captureRecord(uint8_t type, const void* payload, uint8_t length) {
+    portENTER_CRITICAL(&captureLock);
+    if (captureActive) {
+        uint32_t now = micros();
+        size_t n = eventLogEncode(buffer + used, CAPTURE_BUFFER_BYTES - used, type, now - lastUs, payload, length);
+        if (n == 0) {
+            captureActive = false;
+            dropped++;
+        } else {
+            used += n;
+            lastUs = now;
+        }
+    }
+    portEXIT_CRITICAL(&captureLock);
+}
+
+static void captureStart() {
+    if (buffer == nullptr) {
+        buffer = (uint8_t*)malloc(CAPTURE_BUFFER_BYTES);
+        if (buffer == nullptr) {
+            Serial.println("capture: out of memory");
+            return;
+        }
+    }
+    uint8_t start[1 + sizeof(PlayerState)];
+    start[0] = EVENT_LOG_VERSION;
+    memcpy(start + 1, &capturePlayer->state(), sizeof(PlayerState));
+
+    portENTER_CRITICAL(&captureLock);
+    used = eventLogEncode(buffer, CAPTURE_BUFFER_BYTES, EVENT_START, 0, start, sizeof(start));
+    lastUs = micros();
+    dropped = 0;
+    captureActive = true;
+    portEXIT_CRITICAL(&captureLock);
+
+    // The limit is not part of PlayerState; replay needs it from the start
+    if (capturePlayer->volumeLimit() < 100) {
+        captureEvent(EVENT_VOLUME_LIMIT, (uint8_t)capturePlayer->volumeLimit());
+    }
+}
+
+static void captureDump() {
+    bool wasActive = captureActive;
+    captureActive = false;
+
+    Serial.printf("CAPTURE-BEGIN version=%d bytes=%lu full=%d\n", EVENT_LOG_VERSION,
+                  (unsigned long)used, dropped ? 1 : 0);
+    for (size_t i = 0; i < used; i += 32) {
+        char hex[32 * 2 + 1];
+        size_t n = used - i < 32 ? used - i : 32;
+        for (size_t b = 0; b < n; b++) {
+            sprintf(hex + b * 2, "%02x", buffer[i + b]);
+        }
+        Serial.printf("C %s\n", hex);
+    }
+    Serial.println("CAPTURE-END");
+
+    captureActive = wasActive;
+}
+
+static void captureCommand(const char* args) {
+    if (strcmp(args, "on") == 0) {
+        captureStart();
+    } else if (strcmp(args, "off") == 0) {
+        captureActive = false;
+    } else if (strcmp(args, "dump") == 0) {
+        captureDump();
+        return;
+    } else if (strcmp(args, "free") == 0) {
+        portENTER_CRITICAL(&captureLock);
+        captureActive = false;
+        portEXIT_CRITICAL(&captureLock);
+        free(buffer);
+        buffer = nullptr;
+        used = 0;
+    }
+    Serial.printf("capture: %s, %lu / %d bytes%s\n", captureActive ? "on" : "off", (unsigned long)used,
+                  CAPTURE_BUFFER_BYTES, dropped ? ", stopped when full" : "");
+}
+
+void captureBegin(const Player& player) {
+    capturePlayer = &player;
+    consoleRegister("capture", "record events for host replay [on|off|dump|free]", captureCommand);
+}
@@ -0,0 +1,59 @@
+#include <string.h>
+#include "EventLog.h"
+
+size_t eventLogEncode(uint8_t* buf, size_t size, uint8_t type, uint32_t deltaUs,
+                      const void* payload, uint8_t length) {
+    uint8_t header[7];
+    size_t n = 0;
+    header[n++] = type;
+    do {
+        uint8_t byte = deltaUs & 0x7F;
+        deltaUs >>= 7;
+        header[n++] = deltaUs ? (byte | 0x80) : byte;
+    } while (deltaUs);
+    header[n++] = length;
+
+    if (n + length > size) {
+        return 0;
+    }
+    memcpy(buf, header, n);
+    memcpy(buf + n, payload, length);
+    return n + length;
+}
+
+size_t eventLogDecode(const uint8_t* buf, size_t size, EventRecord& out) {
+    size_t n = 0;
+    if (size < 3) {
+        return 0;
+    }
+    out.type = buf[n++];
+    out.deltaUs = 0;
+    for (int shift = 0;; shift += 7) {
+        if (n >= size || shift > 28) {
+            return 0;
+        }
+        uint8_t byte = buf[n++];
+        out.deltaUs |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    if (n >= size) {
+        return 0;
+    }
+    out.length = buf[n++];
+    if (n + out.length > size || out.type >= EVENT_TYPE_COUNT) {
+        return 0;
+    }
+    out.payload = buf + n;
+    return n + out.length;
+}
+
+const char* eventTypeName(uint8_t type) {
+    static const char* const names[EVENT_TYPE_COUNT] = {
+        "start", "connection", "audio", "metadata", "device-name",
+        "volume-set", "volume-step", "track-step", "volume-button", "track-button",
+        "volume-limit",
+    };
+    return type < EVENT_TYPE_COUNT ? names[type] : "?";
+}
@@ -0,0 +1,58 @@
+#include <math.h>
+#include <string.h>
+#include "FirStage.h"
+#include "SpeakerFir.h"
+
+FirStage::FirStage()
+    : params{
+          { "gain", 0, -12, 6 },    // output level, dB (headroom for pre-ringing)
+      } {
+    paramTable = params;
+    paramTotal = P_COUNT;
+    enabled = false;
+}
+
+void FirStage::configure() {
+    gain = powf(10, params[P_GAIN].value / 20);
+}
+
+void FirStage::prepare() {
+    if (!ready) {
+        ready = convolver.begin(speakerFir, SPEAKER_FIR_TAPS, FIR_PARTITION, 2);
+    }
+}
+
+void FirStage::reset() {
+    // Host tools enable the stage directly and reset the chain
+    if (enabled) {
+        prepare();
+    }
+    convolver.reset();
+    memset(input, 0, sizeof(input));
+    memset(output, 0, sizeof(output));
+    fill = 0;
+}
+
+void FirStage::process(float* left, float* right, size_t frames) {
+    if (!ready || rate != SPEAKER_FIR_RATE) {
+        return;
+    }
+    while (frames > 0) {
+        size_t n = frames < FIR_PARTITION - fill ? frames : FIR_PARTITION - fill;
+        for (size_t i = 0; i < n; i++) {
+            input[0][fill + i] = left[i];
+            input[1][fill + i] = right[i];
+            left[i] = output[0][fill + i] * gain;
+            right[i] = output[1][fill + i] * gain;
+        }
+        fill += n;
+        left += n;
+        right += n;
+        frames -= n;
+        if (fill == FIR_PARTITION) {
+            convolver.process(0, input[0], output[0]);
+            convolver.process(1, input[1], output[1]);
+            fill = 0;
+        }
+    }
+}
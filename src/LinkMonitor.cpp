@@ -0,0 +1,105 @@
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <esp_gap_bt_api.h>
+#include "LinkMonitor.h"
+#include "LinkStats.h"
+#include "Logger.h"
+#include "Trace.h"
+#include "SerialConsole.h"
+
+// Written on the Bluetooth task and read by the loop for display only; a
+// torn window at most shows one inconsistent line
+static LinkStats linkStats;
+static BluetoothA2DPSink* linkSink = nullptr;
+static unsigned long lastRssiRead = 0;
+static uint32_t reportedUnderruns = 0;
+
+void linkMonitorOnPacket(uint32_t bytes) {
+    linkStats.onPacket(micros(), bytes);
+}
+
+void linkMonitorOnRssi(int8_t rssiDelta) {
+    linkStats.onRssi(micros(), rssiDelta);
+    TRACE(TRACE_LINK_RSSI, 0, (uint32_t)(int32_t)rssiDelta, 0);
+}
+
+void linkMonitorOnDisconnect() {
+    linkStats.onDisconnect();
+}
+
+void linkMonitorOnSuspend() {
+    linkStats.onSuspend();
+}
+
+void linkMonitorUpdate(unsigned long now) {
+    if (linkSink == nullptr || !linkSink->is_connected()) {
+        return;
+    }
+    if (now - lastRssiRead >= LINK_RSSI_INTERVAL) {
+        lastRssiRead = now;
+        esp_bd_addr_t* peer = linkSink->get_current_peer_address();
+        if (peer != nullptr) {
+            esp_bt_gap_read_rssi_delta(*peer);
+        }
+    }
+
+    const LinkTotals& t = linkStats.totals();
+    if (t.underruns != reportedUnderruns) {
+        LOG_W("Audio underrun (%lu total, %lu weak RSSI, %lu good RSSI), longest gap %lu ms",
+              (unsigned long)t.underruns, (unsigned long)t.underrunsWeakRssi,
+              (unsigned long)t.underrunsGoodRssi, (unsigned long)(t.worstGapUs / 1000));
+        reportedUnderruns = t.underruns;
+    }
+}
+
+static void linkCommand(const char* args) {
+    Serial.println("  age    kbit/s  pkts  avg ms  max ms  rssi  under");
+    LinkWindow w;
+    for (int age = 0; linkStats.window(age, w); age++) {
+        uint32_t avgGapUs = w.packets > 1 ? (uint32_t)(w.sumGapUs / (w.packets - 1)) : 0;
+        Serial.printf("  %3d %9lu %5lu %7.1f %7.1f ", age, (unsigned long)(w.bytes * 8 / 1000),
+                      (unsigned long)w.packets, avgGapUs / 1000.0f, w.maxGapUs / 1000.0f);
+        if (w.hasRssi) {
+            Serial.printf("%5d", w.rssi);
+        } else {
+            Serial.print("    -");
+        }
+        Serial.printf("  %5u\n", w.underruns);
+    }
+    const LinkTotals& t = linkStats.totals();
+    Serial.printf("  underruns %lu: weak RSSI %lu, good RSSI %lu, other %lu; worst gap %lu ms\n",
+                  (unsigned long)t.underruns, (unsigned long)t.underrunsWeakRssi,
+                  (unsigned long)t.underrunsGoodRssi,
+                  (unsigned long)(t.underruns - t.underrunsWeakRssi - t.underrunsGoodRssi),
+                  (unsigned long)(t.worstGapUs / 1000));
+}
+
+void linkMonitorDraw(Adafruit_GFX& gfx, int lines) {
+    gfx.setCursor(0, 0);
+    gfx.println("Link   kb/s max ms rs");
+    LinkWindow w;
+    int rows = lines >= 4 ? lines - 2 : lines - 1;
+    for (int age = 0; age < rows && linkStats.window(age, w); age++) {
+        gfx.printf("-%-2ds %7lu %6.1f ", age + 1, (unsigned long)(w.bytes * 8 / 1000), w.maxGapUs / 1000.0f);
+        if (w.hasRssi) {
+            gfx.printf("%d\n", w.rssi);
+        } else {
+            gfx.println("-");
+        }
+    }
+    if (lines >= 4) {
+        const LinkTotals& t = linkStats.totals();
+        gfx.setCursor(0, (lines - 1) * 8);
+        gfx.printf("Under %lu RF %lu\n", (unsigned long)t.underruns, (unsigned long)t.underrunsWeakRssi);
+    }
+}
+
+void linkMonitorBegin(BluetoothA2DPSink& sink, uint32_t bufferDepthMs) {
+    linkSink = &sink;
+    linkStats.setUnderrunGap(bufferDepthMs * 1000);
+    consoleRegister("link", "link throughput, packet gaps, RSSI and underruns per second", linkCommand);
+}
+
+void linkMonitorSetBufferDepth(uint32_t bufferDepthMs) {
+    linkStats.setUnderrunGap(bufferDepthMs * 1000);
+}
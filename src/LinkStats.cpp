@@ -0,0 +1,81 @@
+#include "LinkStats.h"
+
+void LinkStats::closeWindow(LinkWindow& w) {
+    if (w.underruns == 0) {
+        return;
+    }
+    sums.underruns += w.underruns;
+    if (w.hasRssi && w.rssi <= LINK_WEAK_RSSI) {
+        sums.underrunsWeakRssi += w.underruns;
+    } else if (w.hasRssi) {
+        sums.underrunsGoodRssi += w.underruns;
+    }
+}
+
+void LinkStats::advance(uint32_t nowUs) {
+    if (!started) {
+        started = true;
+        windowStartUs = nowUs;
+        open = LinkWindow();
+        open.startMs = nowUs / 1000;
+        return;
+    }
+    uint32_t elapsed = nowUs - windowStartUs;
+    if (elapsed < LINK_WINDOW_US) {
+        return;
+    }
+    closeWindow(open);
+    push(open);
+
+    // Empty windows for the periods without traffic; after a long silence
+    // only the last LINK_WINDOWS of them are still visible, so stop there
+    uint32_t steps = elapsed / LINK_WINDOW_US;
+    windowStartUs += steps * LINK_WINDOW_US;
+    uint32_t empty = steps - 1 > LINK_WINDOWS ? LINK_WINDOWS : steps - 1;
+    for (uint32_t i = empty; i > 0; i--) {
+        LinkWindow w = LinkWindow();
+        w.startMs = (windowStartUs - i * LINK_WINDOW_US) / 1000;
+        push(w);
+    }
+    open = LinkWindow();
+    open.startMs = windowStartUs / 1000;
+}
+
+void LinkStats::onPacket(uint32_t nowUs, uint32_t bytes) {
+    advance(nowUs);
+    LinkWindow& w = open;
+    w.bytes += bytes;
+    w.packets++;
+    if (havePacket) {
+        uint32_t gap = nowUs - lastPacketUs;
+        w.sumGapUs += gap;
+        if (gap > w.maxGapUs) {
+            w.maxGapUs = gap;
+        }
+        if (gap > sums.worstGapUs) {
+            sums.worstGapUs = gap;
+        }
+        if (gap > underrunGapUs) {
+            w.underruns++;
+        }
+    }
+    lastPacketUs = nowUs;
+    havePacket = true;
+}
+
+void LinkStats::onRssi(uint32_t nowUs, int8_t rssiDelta) {
+    advance(nowUs);
+    LinkWindow& w = open;
+    if (!w.hasRssi || rssiDelta < w.rssi) {
+        w.rssi = rssiDelta;
+    }
+    w.hasRssi = true;
+}
+
+bool LinkStats::window(int age, LinkWindow& out) const {
+    if (age < 0 || age >= LINK_WINDOWS || (uint32_t)age >= closed) {
+        return false;
+    }
+    out = windows[(closed - 1 - age) & (LINK_WINDOWS - 1)];
+    return true;
+}
@@ -0,0 +1,50 @@
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "Logger.h"
+#include "LogRing.h"
+
+static LogRing<LOG_RING_SLOTS, LOG_RECORD_TEXT> logRing;
+static TaskHandle_t logTaskHandle = nullptr;
+
+static const char levelTag[] = { '-', 'E', 'W', 'I', 'D' };
+
+void logWrite(uint8_t level, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    logRing.push(level, millis(), fmt, args);
+    va_end(args);
+}
+
+uint32_t logDroppedCount() {
+    return logRing.droppedCount();
+}
+
+static void logDrainTask(void* param) {
+    LogRing<LOG_RING_SLOTS, LOG_RECORD_TEXT>::Record record;
+    uint32_t reportedDrops = 0;
+
+    for (;;) {
+        while (logRing.pop(record)) {
+            Serial.printf("[%8lu][%c] %s\n", (unsigned long)record.timestamp,
+                          levelTag[record.level < sizeof(levelTag) ? record.level : 0], record.text);
+        }
+
+        // Report overflow once per drain pass instead of per lost message
+        uint32_t drops = logRing.droppedCount();
+        if (drops != reportedDrops) {
+            Serial.printf("[log] %lu message(s) dropped\n", (unsigned long)(drops - reportedDrops));
+            reportedDrops = drops;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
+}
+
+void logBegin() {
+    if (logTaskHandle != nullptr) {
+        return;
+    }
+    // Lowest useful priority on the application core, away from the Bluetooth stack on core 0
+    xTaskCreatePinnedToCore(logDrainTask, "log", 3072, nullptr, tskIDLE_PRIORITY + 1, &logTaskHandle, 1);
+}
@@ -0,0 +1,194 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "LoudnessMeter.h"
+
+// BS.1770 offset so that a full-scale 997 Hz sine in one channel reads -3.01 LUFS
+static const float LOUDNESS_OFFSET = -0.691f;
+
+// Passages this far below the target do not steer the AGC (pauses, fades)
+static const float AGC_GATE_LU = 20.0f;
+
+// Highest sample level the AGC boosts to
+static const float AGC_PEAK_LIMIT = 0.98f;
+
+LoudnessMeter::LoudnessMeter()
+    : params{
+          { "agc", 0, 0, 1 },           // 1 = normalize toward the target
+          { "target", -16, -30, -8 },   // LUFS
+          { "range", 12, 0, 20 },       // dB the AGC may boost or cut
+          { "rate", 1, 0.1f, 6 },       // dB/s gain slew
+          { "window", 10, 3, 60 },      // s the programme loudness averages over
+      } {
+    paramTable = params;
+    paramTotal = P_COUNT;
+}
+
+// K-weighting for any rate, from the analog prototypes of the BS.1770 filters
+void LoudnessMeter::configure() {
+    double fs = rate;
+    double f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+    double k = tan(M_PI * f0 / fs), vh = pow(10, gainDb / 20), vb = pow(vh, 0.4996667741545416);
+    double a0 = 1 + k / q + k * k;
+    BiquadCoeffs shelfCoeffs = {
+        (float)((vh + vb * k / q + k * k) / a0), (float)(2 * (k * k - vh) / a0),
+        (float)((vh - vb * k / q + k * k) / a0), (float)(2 * (k * k - 1) / a0), (float)((1 - k / q + k * k) / a0),
+    };
+    f0 = 38.13547087602444;
+    q = 0.5003270373238773;
+    k = tan(M_PI * f0 / fs);
+    a0 = 1 + k / q + k * k;
+    BiquadCoeffs highPassCoeffs = { 1, -2, 1, (float)(2 * (k * k - 1) / a0), (float)((1 - k / q + k * k) / a0) };
+    for (int c = 0; c < 2; c++) {
+        shelf[c].c = shelfCoeffs;
+        highPass[c].c = highPassCoeffs;
+    }
+    subBlockFrames = rate / 10;
+    if (params[P_AGC].value < 0.5f) {
+        agcDb = 0;
+    }
+}
+
+void LoudnessMeter::reset() {
+    for (int c = 0; c < 2; c++) {
+        shelf[c].reset();
+        highPass[c].reset();
+    }
+    subBlockFill = 0;
+    subBlockSum = 0;
+    memset(subBlocks, 0, sizeof(subBlocks));
+    subBlockHead = 0;
+    subBlockCount = 0;
+    memset(histogram, 0, sizeof(histogram));
+    // A new stream may be a new source: measure it afresh but keep the gain until it is known
+    programLufs = LOUDNESS_SILENCE;
+}
+
+float LoudnessMeter::loudnessOf(float energy, int blocks) const {
+    float meanSquare = energy / ((float)blocks * subBlockFrames);
+    return meanSquare > 0 ? LOUDNESS_OFFSET + 10 * log10f(meanSquare) : LOUDNESS_SILENCE;
+}
+
+// Sum of the newest `blocks` sub-blocks
+static float recentEnergy(const float* ring, int head, int available, int blocks) {
+    float sum = 0;
+    for (int i = 1; i <= blocks && i <= available; i++) {
+        sum += ring[(head - i + LOUDNESS_SHORT_BLOCKS) % LOUDNESS_SHORT_BLOCKS];
+    }
+    return sum;
+}
+
+void LoudnessMeter::closeSubBlock() {
+    subBlocks[subBlockHead] = subBlockSum;
+    subBlockHead = (subBlockHead + 1) % LOUDNESS_SHORT_BLOCKS;
+    if (subBlockCount < LOUDNESS_SHORT_BLOCKS) {
+        subBlockCount++;
+    }
+    subBlockSum = 0;
+    subBlockFill = 0;
+
+    // Every 100 ms a 400 ms gating block (75 % overlap) goes into the histogram
+    if (subBlockCount >= LOUDNESS_MOMENTARY) {
+        float block = loudnessOf(recentEnergy(subBlocks, subBlockHead, subBlockCount, LOUDNESS_MOMENTARY),
+                                 LOUDNESS_MOMENTARY);
+        if (block > LOUDNESS_MIN_LUFS) {
+            int bin = (int)((block - LOUDNESS_MIN_LUFS) / LOUDNESS_BIN_LU);
+            histogram[bin < LOUDNESS_BINS ? bin : LOUDNESS_BINS - 1]++;
+        }
+    }
+
+    if (params[P_AGC].value < 0.5f) {
+        return;
+    }
+    // Programme loudness from the short-term level of passages above the gate
+    float target = params[P_TARGET].value;
+    float shortLufs = shortTerm();
+    if (shortLufs > target - AGC_GATE_LU && shortLufs > LOUDNESS_MIN_LUFS) {
+        if (programLufs <= LOUDNESS_SILENCE) {
+            programLufs = shortLufs;
+        } else {
+            programLufs += (1 - expf(-0.1f / params[P_WINDOW].value)) * (shortLufs - programLufs);
+        }
+    }
+    if (programLufs > LOUDNESS_SILENCE) {
+        float range = params[P_RANGE].value, step = params[P_RATE].value * 0.1f;
+        float wanted = target - programLufs;
+        wanted = wanted > range ? range : wanted < -range ? -range : wanted;
+        agcDb += wanted > agcDb + step ? step : wanted < agcDb - step ? -step : wanted - agcDb;
+    }
+}
+
+void LoudnessMeter::process(float* left, float* right, size_t frames) {
+    float peak = 0;
+    for (size_t i = 0; i < frames; i++) {
+        float l = highPass[0].process(shelf[0].process(left[i]));
+        float r = highPass[1].process(shelf[1].process(right[i]));
+        subBlockSum += l * l + r * r;
+        if (++subBlockFill >= subBlockFrames) {
+            closeSubBlock();
+        }
+        peak = fmaxf(peak, fmaxf(fabsf(left[i]), fabsf(right[i])));
+    }
+
+    bool agc = params[P_AGC].value >= 0.5f;
+    if (!agc && gain == 1) {
+        return;
+    }
+    // Ramp to the AGC gain across the block, at once down to what the peak allows
+    float next = agc ? powf(10, agcDb / 20) : 1;
+    if (peak * next > AGC_PEAK_LIMIT) {
+        next = AGC_PEAK_LIMIT / peak;
+    }
+    if (peak * gain > AGC_PEAK_LIMIT) {
+        gain = next;
+    }
+    float step = (next - gain) / frames, g = gain;
+    for (size_t i = 0; i < frames; i++) {
+        g += step;
+        left[i] *= g;
+        right[i] *= g;
+    }
+    gain = next;
+}
+
+float LoudnessMeter::momentary() const {
+    if (subBlockCount < LOUDNESS_MOMENTARY) {
+        return LOUDNESS_SILENCE;
+    }
+    return loudnessOf(recentEnergy(subBlocks, subBlockHead, subBlockCount, LOUDNESS_MOMENTARY), LOUDNESS_MOMENTARY);
+}
+
+float LoudnessMeter::shortTerm() const {
+    if (subBlockCount < LOUDNESS_SHORT_BLOCKS) {
+        return LOUDNESS_SILENCE;
+    }
+    return loudnessOf(recentEnergy(subBlocks, subBlockHead, subBlockCount, LOUDNESS_SHORT_BLOCKS),
+                      LOUDNESS_SHORT_BLOCKS);
+}
+
+float LoudnessMeter::integrated() const {
+    // Mean energy of the blocks above a gate, with every block at its bin centre
+    auto gatedMean = [this](int firstBin) {
+        double energy = 0;
+        uint64_t count = 0;
+        for (int b = firstBin; b < LOUDNESS_BINS; b++) {
+            if (histogram[b]) {
+                float lufs = LOUDNESS_MIN_LUFS + (b + 0.5f) * LOUDNESS_BIN_LU;
+                energy += histogram[b] * pow(10, (lufs - LOUDNESS_OFFSET) / 10);
+                count += histogram[b];
+            }
+        }
+        return count ? LOUDNESS_OFFSET + 10 * (float)log10(energy / count) : LOUDNESS_SILENCE;
+    };
+    float absolute = gatedMean(0);
+    if (absolute <= LOUDNESS_SILENCE) {
+        return LOUDNESS_SILENCE;
+    }
+    int relativeBin = (int)ceilf((absolute - 10 - LOUDNESS_MIN_LUFS) / LOUDNESS_BIN_LU);
+    return gatedMean(relativeBin > 0 ? relativeBin : 0);
+}
+
+int LoudnessMeter::status(char* text, size_t size) const {
+    return snprintf(text, size, "M %.1f S %.1f I %.1f LUFS, agc %+.1f dB", momentary(), shortTerm(), integrated(),
+                    agcDb);
+}
@@ -0,0 +1,178 @@
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <esp_heap_caps.h>
+#include "MemoryMonitor.h"
+#include "Logger.h"
+#include "SerialConsole.h"
+
+struct WatchedTask {
+    const char* name;
+    TaskHandle_t handle;
+    uint32_t stackFree;     // bytes never used, 0 until first sample
+};
+
+enum MemoryWarning : uint8_t {
+    WARN_LOW_INTERNAL = 1 << 0,
+    WARN_FRAGMENTED   = 1 << 1,
+    WARN_LEAK_TREND   = 1 << 2,
+    WARN_LOW_STACK    = 1 << 3,
+};
+
+static MemorySnapshot snapshot;
+static WatchedTask tasks[MEMORY_MAX_TASKS];
+static int taskCount = 0;
+static uint32_t trend[MEMORY_TREND_SAMPLES];
+static int trendCount = 0;
+static int trendIndex = 0;
+static uint8_t activeWarnings = 0;
+static unsigned long lastSample = 0;
+
+static HeapStats sampleHeap(uint32_t caps) {
+    HeapStats stats;
+    stats.total = heap_caps_get_total_size(caps);
+    stats.free = heap_caps_get_free_size(caps);
+    stats.largestBlock = heap_caps_get_largest_free_block(caps);
+    stats.minFree = heap_caps_get_minimum_free_size(caps);
+    return stats;
+}
+
+void memoryMonitorWatchTask(const char* name, TaskHandle_t task) {
+    if (taskCount < MEMORY_MAX_TASKS) {
+        tasks[taskCount++] = { name, task, 0 };
+    }
+}
+
+const MemorySnapshot& memoryMonitorSnapshot() {
+    return snapshot;
+}
+
+static void updateWarning(uint8_t flag, bool condition, const char* message, uint32_t value) {
+    // Log on transitions only, so a persistent condition does not flood the log
+    if (condition && !(activeWarnings & flag)) {
+        LOG_W("Memory: %s (%lu)", message, (unsigned long)value);
+        activeWarnings |= flag;
+    } else if (!condition && (activeWarnings & flag)) {
+        LOG_I("Memory: recovered from %s", message);
+        activeWarnings &= ~flag;
+    }
+}
+
+static void sample() {
+    snapshot.internal = sampleHeap(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    snapshot.dma = sampleHeap(MALLOC_CAP_DMA);
+    snapshot.spiram = sampleHeap(MALLOC_CAP_SPIRAM);
+
+    uint32_t lowestStack = UINT32_MAX;
+    const char* lowestName = "";
+    for (int i = 0; i < taskCount; i++) {
+        if (tasks[i].handle == nullptr) {
+            tasks[i].handle = xTaskGetHandle(tasks[i].name);
+            if (tasks[i].handle == nullptr) {
+                continue;
+            }
+        }
+        tasks[i].stackFree = uxTaskGetStackHighWaterMark(tasks[i].handle);
+        if (tasks[i].stackFree < lowestStack) {
+            lowestStack = tasks[i].stackFree;
+            lowestName = tasks[i].name;
+        }
+    }
+
+    // Leak trend: free internal heap lower than a full window ago, and at its lowest now
+    trend[trendIndex] = snapshot.internal.free;
+    trendIndex = (trendIndex + 1) % MEMORY_TREND_SAMPLES;
+    if (trendCount < MEMORY_TREND_SAMPLES) {
+        trendCount++;
+    }
+    uint32_t oldest = trend[trendCount < MEMORY_TREND_SAMPLES ? 0 : trendIndex];
+    uint32_t lowest = UINT32_MAX;
+    for (int i = 0; i < trendCount; i++) {
+        lowest = min(lowest, trend[i]);
+    }
+    bool shrinking = trendCount == MEMORY_TREND_SAMPLES &&
+                     oldest > snapshot.internal.free + MEMORY_LEAK_BYTES &&
+                     snapshot.internal.free == lowest;
+
+    updateWarning(WARN_LOW_INTERNAL, snapshot.internal.free < MEMORY_LOW_INTERNAL,
+                  "internal heap low, free bytes", snapshot.internal.free);
+    updateWarning(WARN_FRAGMENTED, snapshot.internal.fragmentation() > MEMORY_FRAGMENTED_PCT,
+                  "internal heap fragmented, largest block", snapshot.internal.largestBlock);
+    updateWarning(WARN_LEAK_TREND, shrinking,
+                  "internal heap shrinking, bytes lost in window", oldest - snapshot.internal.free);
+    if (lowestStack != UINT32_MAX) {
+        updateWarning(WARN_LOW_STACK, lowestStack < MEMORY_LOW_STACK, lowestName, lowestStack);
+    }
+}
+
+void memoryMonitorUpdate(unsigned long now) {
+    if (now - lastSample >= MEMORY_SAMPLE_INTERVAL) {
+        lastSample = now;
+        sample();
+    }
+}
+
+static void printHeap(const char* name, const HeapStats& h) {
+    Serial.printf("  %-8s %8lu %8lu %8lu %8lu %4u%%\n", name, (unsigned long)h.total, (unsigned long)h.free,
+                  (unsigned long)h.largestBlock, (unsigned long)h.minFree, h.fragmentation());
+}
+
+static void memCommand(const char* args) {
+    sample();
+    Serial.println("  heap        total     free  largest  minfree frag");
+    printHeap("internal", snapshot.internal);
+    printHeap("dma", snapshot.dma);
+    printHeap("spiram", snapshot.spiram);
+    Serial.println("  task          stack never used");
+    for (int i = 0; i < taskCount; i++) {
+        if (tasks[i].handle != nullptr) {
+            Serial.printf("  %-14s %6lu\n", tasks[i].name, (unsigned long)tasks[i].stackFree);
+        }
+    }
+    Serial.printf("  warnings: 0x%02x\n", activeWarnings);
+}
+
+static void drawHeap(Adafruit_GFX& gfx, const char* name, const HeapStats& h) {
+    gfx.printf("%-3s%5lu/%5lu %3u%%\n", name, (unsigned long)(h.free / 1024),
+               (unsigned long)(h.minFree / 1024), h.fragmentation());
+}
+
+void memoryMonitorDraw(Adafruit_GFX& gfx, int lines) {
+    gfx.setCursor(0, 0);
+    gfx.println("Memory  free/min K fr");
+    drawHeap(gfx, "INT", snapshot.internal);
+    if (lines >= 3) {
+        drawHeap(gfx, "DMA", snapshot.dma);
+    }
+
+    // PSRAM and stack rows only where the panel has room for all six rows;
+    // short panels keep the warnings line
+    if (lines >= 6) {
+        drawHeap(gfx, "PSR", snapshot.spiram);
+
+        // Task closest to overflowing its stack
+        const WatchedTask* lowest = nullptr;
+        for (int i = 0; i < taskCount; i++) {
+            if (tasks[i].handle != nullptr && (lowest == nullptr || tasks[i].stackFree < lowest->stackFree)) {
+                lowest = &tasks[i];
+            }
+        }
+        if (lowest != nullptr) {
+            gfx.printf("Stk %-10.10s %5lu\n", lowest->name, (unsigned long)lowest->stackFree);
+        }
+    }
+    if (lines >= 4) {
+        gfx.printf("Warn 0x%02x\n", activeWarnings);
+    }
+}
+
+void memoryMonitorBegin() {
+    // Arduino loop task plus the Bluetooth stack and A2DP library tasks
+    memoryMonitorWatchTask("loopTask", xTaskGetCurrentTaskHandle());
+    memoryMonitorWatchTask("log");
+    memoryMonitorWatchTask("BTC_TASK");
+    memoryMonitorWatchTask("BTU_TASK");
+    memoryMonitorWatchTask("BtAppTask");
+    memoryMonitorWatchTask("BtI2STask");
+    consoleRegister("mem", "heap per capability and task stack high-water marks", memCommand);
+    sample();
+}
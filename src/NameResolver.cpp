@@ -0,0 +1,63 @@
+#include <Arduino.h>
+#include <esp_gap_bt_api.h>
+#include "NameResolver.h"
+#include "Logger.h"
+
+static portMUX_TYPE resultLock = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t requestAddress[6];
+static bool requestActive = false;
+static unsigned long requestStart = 0;
+
+// Filled on the Bluetooth task, read under resultLock
+static volatile bool resultReady = false;
+static char resultName[ESP_BT_GAP_MAX_BDNAME_LEN + 1];
+
+void nameResolverOnResult(bool ok, const char* name) {
+    portENTER_CRITICAL(&resultLock);
+    if (ok) {
+        strncpy(resultName, name, sizeof(resultName) - 1);
+        resultName[sizeof(resultName) - 1] = '\0';
+    } else {
+        resultName[0] = '\0';
+    }
+    resultReady = true;
+    portEXIT_CRITICAL(&resultLock);
+}
+
+void nameResolverRequest(const uint8_t address[6], unsigned long now) {
+    if (requestActive) {
+        return;
+    }
+    memcpy(requestAddress, address, 6);
+    resultReady = false;
+    if (esp_bt_gap_read_remote_name(requestAddress) == ESP_OK) {
+        requestActive = true;
+        requestStart = now;
+    } else {
+        LOG_W("Remote name request failed to start");
+    }
+}
+
+bool nameResolverTake(uint8_t address[6], char* name, size_t size, unsigned long now) {
+    if (!requestActive) {
+        return false;
+    }
+    if (!resultReady) {
+        if (now - requestStart > NAME_REQUEST_TIMEOUT) {
+            LOG_W("Remote name request timed out");
+            requestActive = false;
+        }
+        return false;
+    }
+
+    portENTER_CRITICAL(&resultLock);
+    strncpy(name, resultName, size - 1);
+    name[size - 1] = '\0';
+    resultReady = false;
+    portEXIT_CRITICAL(&resultLock);
+
+    requestActive = false;
+    memcpy(address, requestAddress, 6);
+    LOG_I("Remote name \"%s\" resolved in %lu ms", name, now - requestStart);
+    return name[0] != '\0';
+}
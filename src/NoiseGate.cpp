@@ -0,0 +1,83 @@
+#include <math.h>
+#include <stdio.h>
+#include "NoiseGate.h"
+
+NoiseGate::NoiseGate()
+    : params{
+          { "open", -70, -90, -30 },        // dBFS
+          { "hyst", 6, 0, 20 },             // dB below "open" to close
+          { "ratio", 2, 1, 8 },             // expansion below "open" while closed
+          { "depth", 30, 0, 80 },           // largest attenuation, dB
+          { "attack", 1, 0.1f, 20 },        // ms
+          { "release", 200, 10, 1000 },     // ms
+          { "hold", 300, 0, 2000 },         // ms
+      } {
+    paramTable = params;
+    paramTotal = P_COUNT;
+}
+
+void NoiseGate::configure() {
+    float fs = (float)rate;
+    float attackSeconds = params[P_ATTACK].value / 1000;
+    envelope.setTimes(fs, attackSeconds, GATE_DETECTOR_RELEASE);
+    gainAttack = 1 - expf(-1.0f / (attackSeconds * fs));
+    gainRelease = 1 - expf(-1.0f / (params[P_RELEASE].value / 1000 * fs));
+    openLevel = powf(10, params[P_OPEN].value / 20);
+    closeLevel = powf(10, (params[P_OPEN].value - params[P_HYST].value) / 20);
+    floorGain = powf(10, -params[P_DEPTH].value / 20);
+    holdFrames = (uint32_t)(params[P_HOLD].value / 1000 * fs);
+}
+
+void NoiseGate::reset() {
+    // A new stream starts from silence
+    envelope.reset();
+    open = false;
+    holdLeft = 0;
+    gain = floorGain;
+}
+
+void NoiseGate::process(float* left, float* right, size_t frames) {
+    // Expander gain while closed, from the envelope at the start of the block
+    float closedGain = 1;
+    if (envelope.value < openLevel) {
+        closedGain = envelope.value > 0 ? powf(envelope.value / openLevel, params[P_RATIO].value - 1) : 0;
+        closedGain = closedGain > floorGain ? closedGain : floorGain;
+    }
+
+    for (size_t i = 0; i < frames; i++) {
+        float level = envelope.process(fmaxf(fabsf(left[i]), fabsf(right[i])));
+        if (level >= openLevel) {
+            open = true;
+            holdLeft = holdFrames;
+        } else if (open && level < closeLevel) {
+            if (holdLeft > 0) {
+                holdLeft--;
+            } else {
+                open = false;
+            }
+        } else if (open) {
+            holdLeft = holdFrames;
+        }
+
+        float target = open ? 1 : closedGain;
+        gain += (target > gain ? gainAttack : gainRelease) * (target - gain);
+        left[i] *= gain;
+        right[i] *= gain;
+    }
+    // Settle exactly on unity so an open gate passes the samples unchanged
+    if (open && gain > 0.99999f) {
+        gain = 1;
+    }
+}
+
+float NoiseGate::gainDb() const {
+    return 20 * log10f(gain > 1e-6f ? gain : 1e-6f);
+}
+
+float NoiseGate::levelDb() const {
+    return 20 * log10f(envelope.value > 1e-6f ? envelope.value : 1e-6f);
+}
+
+int NoiseGate::status(char* text, size_t size) const {
+    return snprintf(text, size, "%s, gain %.1f dB, level %.1f dBFS", open ? "open" : "closed", gainDb(), levelDb());
+}
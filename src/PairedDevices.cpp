@@ -0,0 +1,112 @@
+#include <string.h>
+#include <stdio.h>
+#include "PairedDevices.h"
+
+int PairedDeviceList::find(const uint8_t address[6]) const {
+    for (int i = 0; i < deviceCount; i++) {
+        if (memcmp(devices[i].address, address, 6) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+PairedDevice& PairedDeviceList::touch(const uint8_t address[6], uint8_t defaultVolume) {
+    PairedDevice entry;
+    int index = find(address);
+    if (index >= 0) {
+        entry = devices[index];
+    } else {
+        memset(&entry, 0, sizeof(entry));
+        memcpy(entry.address, address, 6);
+        entry.volume = defaultVolume;
+        // Full: the last slot (least recently used) is overwritten by the shift
+        index = deviceCount < PAIRED_MAX_DEVICES ? deviceCount++ : PAIRED_MAX_DEVICES - 1;
+    }
+
+    memmove(&devices[1], &devices[0], index * sizeof(PairedDevice));
+    entry.lastSeen = ++sequence;
+    devices[0] = entry;
+    return devices[0];
+}
+
+bool PairedDeviceList::setName(const uint8_t address[6], const char* name) {
+    int index = find(address);
+    if (index < 0) {
+        return false;
+    }
+    char cut[PAIRED_NAME_LENGTH];
+    copyName(cut, sizeof(cut), name);
+    if (strcmp(devices[index].name, cut) == 0) {
+        return false;
+    }
+    strcpy(devices[index].name, cut);
+    return true;
+}
+
+bool PairedDeviceList::remove(const uint8_t address[6]) {
+    int index = find(address);
+    if (index < 0) {
+        return false;
+    }
+    memmove(&devices[index], &devices[index + 1], (deviceCount - index - 1) * sizeof(PairedDevice));
+    deviceCount--;
+    return true;
+}
+
+void PairedDeviceList::clear() {
+    deviceCount = 0;
+}
+
+size_t PairedDeviceList::serialize(uint8_t* out, size_t capacity) const {
+    size_t size = blobSize(deviceCount);
+    if (capacity < size) {
+        return 0;
+    }
+    PairedBlobHeader header = { PAIRED_BLOB_VERSION, (uint8_t)deviceCount, (uint16_t)sizeof(PairedDevice) };
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), devices, deviceCount * sizeof(PairedDevice));
+    return size;
+}
+
+bool PairedDeviceList::deserialize(const uint8_t* data, size_t length) {
+    PairedBlobHeader header;
+    if (length < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.version != PAIRED_BLOB_VERSION || header.recordSize != sizeof(PairedDevice) ||
+        header.count > PAIRED_MAX_DEVICES || length < blobSize(header.count)) {
+        return false;
+    }
+
+    memcpy(devices, data + sizeof(header), header.count * sizeof(PairedDevice));
+    deviceCount = header.count;
+    sequence = 0;
+    for (int i = 0; i < deviceCount; i++) {
+        devices[i].name[PAIRED_NAME_LENGTH - 1] = '\0';
+        if (devices[i].lastSeen > sequence) {
+            sequence = devices[i].lastSeen;
+        }
+    }
+    return true;
+}
+
+void formatAddress(const uint8_t address[6], char* out, size_t size) {
+    snprintf(out, size, "%02x:%02x:%02x:%02x:%02x:%02x",
+             address[0], address[1], address[2], address[3], address[4], address[5]);
+}
+
+void copyName(char* out, size_t size, const char* name) {
+    size_t length = strnlen(name, size);
+    if (length >= size) {
+        // Cut: back up over the continuation bytes (at most three) to the
+        // start of the sequence that would be split, and drop it whole
+        length = size - 1;
+        for (int i = 0; i < 3 && length > 0 && ((uint8_t)name[length] & 0xC0) == 0x80; i++) {
+            length--;
+        }
+    }
+    memcpy(out, name, length);
+    out[length] = '\0';
+}
@@ -0,0 +1,188 @@
+#include <string.h>
+#include <ctype.h>
+#include "Player.h"
+
+static void copyText(char* dst, size_t size, const char* src) {
+    size_t n = 0;
+    while (n < size - 1 && src[n] != '\0') {
+        dst[n] = src[n];
+        n++;
+    }
+    dst[n] = '\0';
+}
+
+// Remove every occurrence of pattern
+static void removeAll(char* text, const char* pattern) {
+    size_t patternLength = strlen(pattern);
+    char* hit;
+    while ((hit = strstr(text, pattern)) != nullptr) {
+        memmove(hit, hit + patternLength, strlen(hit + patternLength) + 1);
+    }
+}
+
+static void trim(char* text) {
+    size_t length = strlen(text);
+    while (length > 0 && isspace((unsigned char)text[length - 1])) {
+        length--;
+    }
+    text[length] = '\0';
+    size_t start = 0;
+    while (isspace((unsigned char)text[start])) {
+        start++;
+    }
+    memmove(text, text + start, length - start + 1);
+}
+
+// Last " - " that is not at the very start
+static char* lastDash(char* text) {
+    char* found = nullptr;
+    if (text[0] == '\0') {
+        return nullptr;
+    }
+    for (char* p = strstr(text + 1, " - "); p != nullptr; p = strstr(p + 1, " - ")) {
+        found = p;
+    }
+    return found;
+}
+
+void cleanTitle(char* title) {
+    // "Channel - Song": keep the part after the last dash (usually the song name)
+    char* dash = lastDash(title);
+    if (dash != nullptr && dash[3] != '\0') {
+        memmove(title, dash + 3, strlen(dash + 3) + 1);
+    }
+
+    static const char* const noise[] = {
+        "(Official Video)", "(Official Music Video)", "(Official Audio)", "(Lyric Video)", "(Lyrics)",
+        "[Official Video]", "[Official Music Video]", "[Official Audio]", "[Lyric Video]", "[Lyrics]",
+    };
+    for (const char* pattern : noise) {
+        removeAll(title, pattern);
+    }
+    trim(title);
+}
+
+void cleanArtist(char* artist) {
+    static const char* const noise[] = { "VEVO", "Records", "Music", " - Topic" };
+    for (const char* pattern : noise) {
+        removeAll(artist, pattern);
+    }
+    trim(artist);
+}
+
+void Player::begin(int volume) {
+    s = {};
+    setVolume(volume);
+    s.page = PAGE_PLAYER;
+    copyText(s.device, sizeof(s.device), "Not Connected");
+    copyText(s.title, sizeof(s.title), "No Track");
+    copyText(s.artist, sizeof(s.artist), "Unknown Artist");
+}
+
+void Player::onConnection(uint8_t state) {
+    if (state == LINK_CONNECTED) {
+        s.connected = true;
+        s.playing = false;
+        // Placeholder until the cached or resolved name arrives (DeviceSwitcher)
+        copyText(s.device, sizeof(s.device), "Phone Connected");
+    } else if (state == LINK_DISCONNECTED) {
+        s.connected = false;
+        s.playing = false;
+        copyText(s.device, sizeof(s.device), "Not Connected");
+        copyText(s.title, sizeof(s.title), "No Track");
+        copyText(s.artist, sizeof(s.artist), "Unknown Artist");
+    }
+}
+
+bool Player::onAudio() {
+    if (s.playing) {
+        return false;
+    }
+    s.playing = true;
+    return true;
+}
+
+void Player::onMetadata(uint8_t id, const char* text) {
+    if (id == METADATA_TITLE) {
+        copyText(s.title, sizeof(s.title), text);
+        cleanTitle(s.title);
+    } else if (id == METADATA_ARTIST) {
+        copyText(s.artist, sizeof(s.artist), text);
+        cleanArtist(s.artist);
+    }
+}
+
+void Player::setDeviceName(const char* name) {
+    copyText(s.device, sizeof(s.device), name);
+}
+
+void Player::setVolume(int volume) {
+    s.volume = (uint8_t)(volume < 0 ? 0 : volume > limit ? limit : volume);
+}
+
+PlayerAction Player::setVolumeLimit(int volumeLimit) {
+    limit = (uint8_t)(volumeLimit < 0 ? 0 : volumeLimit > 100 ? 100 : volumeLimit);
+    if (s.volume <= limit) {
+        return ACTION_NONE;
+    }
+    s.volume = limit;
+    return ACTION_SET_VOLUME;
+}
+
+PlayerAction Player::onVolumeStep(int direction) {
+    // Clockwise (negative encoder direction) raises the volume, like AV gear
+    setVolume(s.volume - direction * PLAYER_VOLUME_STEP);
+    return ACTION_SET_VOLUME;
+}
+
+PlayerAction Player::onTrackStep(int direction) {
+    if (s.page == PAGE_DEVICES) {
+        return direction > 0 ? ACTION_SELECT_NEXT : ACTION_SELECT_PREVIOUS;
+    }
+    if (s.page == PAGE_SIGNAL) {
+        return direction > 0 ? ACTION_SIGNAL_NEXT : ACTION_SIGNAL_PREVIOUS;
+    }
+    if (!s.connected) {
+        return ACTION_NONE;
+    }
+    return direction > 0 ? ACTION_NEXT_TRACK : ACTION_PREVIOUS_TRACK;
+}
+
+PlayerAction Player::onVolumeButton(bool pressed, uint32_t nowMs) {
+    PlayerAction action = ACTION_NONE;
+    if (pressed && !volumePressed) {
+        volumePressTime = nowMs;
+        volumeLongPress = false;
+    } else if (pressed && !volumeLongPress && nowMs - volumePressTime >= PLAYER_LONG_PRESS) {
+        volumeLongPress = true;
+        s.page = (s.page + 1) % PAGE_COUNT;
+        action = ACTION_NEXT_PAGE;
+    } else if (!pressed && volumePressed && !volumeLongPress && s.connected) {
+        s.paused = !s.paused;
+        action = s.paused ? ACTION_PAUSE : ACTION_PLAY;
+    }
+    volumePressed = pressed;
+    return action;
+}
+
+PlayerAction Player::onTrackButton(bool pressed, uint32_t nowMs) {
+    PlayerAction action = ACTION_NONE;
+    if (pressed && !trackPressed) {
+        trackPressTime = nowMs;
+        trackLongPress = false;
+    } else if (pressed && !trackLongPress && s.page == PAGE_PLAYER && nowMs - trackPressTime >= PLAYER_LONG_PRESS) {
+        trackLongPress = true;
+        action = ACTION_NEXT_EQ_PRESET;
+    } else if (!pressed && trackPressed && !trackLongPress) {
+        if (s.page == PAGE_DEVICES) {
+            action = ACTION_CONNECT_SELECTED;
+        } else if (s.page == PAGE_SIGNAL) {
+            action = ACTION_SIGNAL_TOGGLE;
+        } else if (s.connected) {
+            s.playing = false;
+            action = ACTION_STOP;
+        }
+    }
+    trackPressed = pressed;
+    return action;
+}
@@ -0,0 +1,136 @@
+#include <math.h>
+#include <stdlib.h>
+#include "RealFft.h"
+
+bool RealFft::begin(size_t size) {
+    if (size < 8 || size > FFT_MAX_SIZE || (size & (size - 1)) != 0) {
+        return false;
+    }
+    if (size == n) {
+        return true;
+    }
+    end();
+    size_t half = size / 2;
+    twiddle = (float*)malloc(half * 2 * sizeof(float));
+    bitReverse = (uint16_t*)malloc(half * sizeof(uint16_t));
+    if (twiddle == nullptr || bitReverse == nullptr) {
+        end();
+        return false;
+    }
+    for (size_t k = 0; k < half; k++) {
+        double phase = -2 * M_PI * k / size;
+        twiddle[2 * k] = (float)cos(phase);
+        twiddle[2 * k + 1] = (float)sin(phase);
+    }
+    int bits = 0;
+    while (((size_t)1 << bits) < half) {
+        bits++;
+    }
+    for (size_t i = 0; i < half; i++) {
+        size_t r = 0;
+        for (int b = 0; b < bits; b++) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        bitReverse[i] = (uint16_t)r;
+    }
+    n = size;
+    return true;
+}
+
+void RealFft::end() {
+    free(twiddle);
+    free(bitReverse);
+    twiddle = nullptr;
+    bitReverse = nullptr;
+    n = 0;
+}
+
+// Radix-2 decimation in time over n/2 complex values; twiddles of the
+// half-size transform are every other entry of the full-size table
+void RealFft::complexFft(float* data, bool inverse) const {
+    size_t m = n / 2;
+    for (size_t i = 0; i < m; i++) {
+        size_t j = bitReverse[i];
+        if (j > i) {
+            float re = data[2 * i], im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+    float sign = inverse ? -1.0f : 1.0f;
+    for (size_t len = 2; len <= m; len <<= 1) {
+        size_t half = len / 2, stride = 4 * (m / len);
+        for (size_t start = 0; start < m; start += len) {
+            for (size_t k = 0; k < half; k++) {
+                float wr = twiddle[k * stride], wi = sign * twiddle[k * stride + 1];
+                float* a = data + 2 * (start + k);
+                float* b = a + 2 * half;
+                float tr = b[0] * wr - b[1] * wi;
+                float ti = b[0] * wi + b[1] * wr;
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+void RealFft::forward(float* data) const {
+    size_t m = n / 2;
+    complexFft(data, false);
+
+    // Split the transform of the even/odd interleaved samples into bins 0 .. n/2
+    float re0 = data[0], im0 = data[1];
+    data[0] = re0 + im0;
+    data[1] = re0 - im0;
+    for (size_t k = 1; k <= m / 2; k++) {
+        size_t j = m - k;
+        float ar = data[2 * k], ai = data[2 * k + 1];
+        float br = data[2 * j], bi = data[2 * j + 1];
+        // Even part E = (Z[k] + conj Z[j]) / 2, odd part O = (Z[k] - conj Z[j]) / 2i
+        float er = 0.5f * (ar + br), ei = 0.5f * (ai - bi);
+        float or_ = 0.5f * (ai + bi), oi = -0.5f * (ar - br);
+        float wr = twiddle[2 * k], wi = twiddle[2 * k + 1];
+        float tr = or_ * wr - oi * wi, ti = or_ * wi + oi * wr;
+        data[2 * k] = er + tr;
+        data[2 * k + 1] = ei + ti;
+        // Bin j = conj(E[k]) - conj(w^k O[k]) by symmetry
+        data[2 * j] = er - tr;
+        data[2 * j + 1] = -(ei - ti);
+    }
+}
+
+void RealFft::inverse(float* data) const {
+    size_t m = n / 2;
+    float dc = data[0], nyquist = data[1];
+    data[0] = dc + nyquist;
+    data[1] = dc - nyquist;
+    for (size_t k = 1; k <= m / 2; k++) {
+        size_t j = m - k;
+        float ar = data[2 * k], ai = data[2 * k + 1];
+        float br = data[2 * j], bi = data[2 * j + 1];
+        // E = (X[k] + conj X[j]), O = (X[k] - conj X[j]) w^-k; Z[k] = E + iO
+        float er = ar + br, ei = ai - bi;
+        float dr = ar - br, di = ai + bi;
+        float wr = twiddle[2 * k], wi = -twiddle[2 * k + 1];
+        float or_ = dr * wr - di * wi, oi = dr * wi + di * wr;
+        data[2 * k] = er - oi;
+        data[2 * k + 1] = ei + or_;
+        data[2 * j] = er + oi;
+        data[2 * j + 1] = -(ei - or_);
+    }
+    complexFft(data, true);
+}
+
+void spectrumMultiplyAdd(float* acc, const float* a, const float* b, size_t n) {
+    acc[0] += a[0] * b[0];
+    acc[1] += a[1] * b[1];
+    for (size_t i = 2; i < n; i += 2) {
+        float ar = a[i], ai = a[i + 1], br = b[i], bi = b[i + 1];
+        acc[i] += ar * br - ai * bi;
+        acc[i + 1] += ar * bi + ai * br;
+    }
+}
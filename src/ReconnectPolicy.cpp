@@ -0,0 +1,104 @@
+#include "ReconnectPolicy.h"
+
+void ReconnectPolicy::account(uint32_t now) {
+    // Integrate radio time since the previous call while disconnected
+    uint32_t elapsed = now - lastAccounted;
+    lastAccounted = now;
+    if (state == STATE_CONNECTED) {
+        return;
+    }
+    counters.disconnectedMs += elapsed;
+    RadioMode mode = radioMode(now);
+    if (state == STATE_PAGING || mode.connectable) {
+        counters.radioBusyMs += elapsed;
+    }
+}
+
+void ReconnectPolicy::onConnected(uint32_t now) {
+    account(now);
+    if (state != STATE_CONNECTED) {
+        uint32_t took = now - disconnectedAt;
+        counters.reconnects++;
+        counters.lastReconnectMs = took;
+        counters.totalReconnectMs += took;
+        if (took > counters.worstReconnectMs) {
+            counters.worstReconnectMs = took;
+        }
+    }
+    state = STATE_CONNECTED;
+    backoff = 0;
+    nextIndex = 0;
+    requestedIndex = -1;
+}
+
+void ReconnectPolicy::onDisconnected(uint32_t now) {
+    account(now);
+    if (state != STATE_CONNECTED) {
+        return;
+    }
+    state = STATE_WAITING;
+    disconnectedAt = now;
+    nextAttemptAt = now;
+    backoff = 0;
+    nextIndex = 0;
+}
+
+void ReconnectPolicy::request(int index, uint32_t now) {
+    requestedIndex = index;
+    if (state == STATE_WAITING) {
+        nextAttemptAt = now;
+    }
+}
+
+int ReconnectPolicy::poll(uint32_t now, int knownDevices) {
+    account(now);
+
+    if (state == STATE_PAGING && (int32_t)(now - attemptDeadline) >= 0) {
+        counters.timeouts++;
+        state = STATE_WAITING;
+        if (++nextIndex < knownDevices) {
+            // Next phone in the same round right away
+            nextAttemptAt = now;
+        } else {
+            // Whole list tried: back off before the next round
+            nextIndex = 0;
+            backoff = backoff == 0 ? config.initialBackoffMs : backoff * config.backoffFactor;
+            if (backoff > config.maxBackoffMs) {
+                backoff = config.maxBackoffMs;
+            }
+            nextAttemptAt = now + backoff;
+        }
+    }
+
+    if (state != STATE_WAITING || knownDevices == 0 || (int32_t)(now - nextAttemptAt) < 0) {
+        return -1;
+    }
+
+    int index = nextIndex;
+    if (requestedIndex >= 0 && requestedIndex < knownDevices) {
+        index = requestedIndex;
+    }
+    requestedIndex = -1;
+    if (index >= knownDevices) {
+        index = 0;
+    }
+    nextIndex = index;
+
+    state = STATE_PAGING;
+    attemptDeadline = now + config.attemptTimeoutMs;
+    counters.attempts++;
+    return index;
+}
+
+RadioMode ReconnectPolicy::radioMode(uint32_t now) const {
+    if (state == STATE_CONNECTED) {
+        return { false, false };
+    }
+    uint32_t since = now - disconnectedAt;
+    if (since < config.discoverableMs) {
+        return { true, true };
+    }
+    // Duty-cycled page scan so a returning phone can still reach us
+    uint32_t window = config.scanPeriodMs * config.maxScanDutyPct / 100;
+    return { (since - config.discoverableMs) % config.scanPeriodMs < window, false };
+}
@@ -0,0 +1,61 @@
+#include <Arduino.h>
+#include "SerialConsole.h"
+
+struct ConsoleCommand {
+    const char* name;
+    const char* help;
+    ConsoleHandler handler;
+};
+
+static ConsoleCommand commands[CONSOLE_MAX_COMMANDS];
+static int commandCount = 0;
+static char line[CONSOLE_LINE_LENGTH];
+static int lineLength = 0;
+
+void consoleRegister(const char* name, const char* help, ConsoleHandler handler) {
+    if (commandCount < CONSOLE_MAX_COMMANDS) {
+        commands[commandCount++] = { name, help, handler };
+    }
+}
+
+static void dispatch(char* text) {
+    // Split "name args..." at the first space
+    char* args = strchr(text, ' ');
+    if (args != nullptr) {
+        *args++ = '\0';
+        while (*args == ' ') {
+            args++;
+        }
+    } else {
+        args = text + strlen(text);
+    }
+
+    if (*text == '\0') {
+        return;
+    }
+
+    for (int i = 0; i < commandCount; i++) {
+        if (strcmp(commands[i].name, text) == 0) {
+            commands[i].handler(args);
+            return;
+        }
+    }
+
+    Serial.println("Commands:");
+    for (int i = 0; i < commandCount; i++) {
+        Serial.printf("  %-10s %s\n", commands[i].name, commands[i].help);
+    }
+}
+
+void consolePoll() {
+    while (Serial.available() > 0) {
+        int c = Serial.read();
+        if (c == '\r' || c == '\n') {
+            line[lineLength] = '\0';
+            lineLength = 0;
+            dispatch(line);
+        } else if (lineLength < CONSOLE_LINE_LENGTH - 1) {
+            line[lineLength++] = (char)c;
+        }
+    }
+}
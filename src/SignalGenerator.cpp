@@ -0,0 +1,164 @@
+#include <math.h>
+#include <string.h>
+#include "SignalGenerator.h"
+
+static const char* const typeNames[SIGNAL_COUNT] = { "off", "tone", "sweep", "pink", "pulse" };
+
+const char* signalTypeName(uint8_t type) {
+    return type < SIGNAL_COUNT ? typeNames[type] : "?";
+}
+
+uint8_t signalTypeFromName(const char* name) {
+    for (uint8_t i = 0; i < SIGNAL_COUNT; i++) {
+        if (strcmp(name, typeNames[i]) == 0) {
+            return i;
+        }
+    }
+    return SIGNAL_COUNT;
+}
+
+void SignalGenerator::start(const SignalSettings& settings, uint32_t sampleRate) {
+    s = settings;
+    rate = sampleRate;
+    position = 0;
+    float nyquist = rate * 0.5f;
+    s.frequency = fminf(fmaxf(s.frequency, 1.0f), nyquist);
+    s.sweepStart = fminf(fmaxf(s.sweepStart, 1.0f), nyquist);
+    s.sweepEnd = fminf(fmaxf(s.sweepEnd, s.sweepStart), nyquist);
+    s.sweepSeconds = fminf(fmaxf(s.sweepSeconds, 0.1f), 60.0f);
+    amplitude = powf(10, fminf(s.level, 0.0f) / 20) * (s.invert ? -1 : 1);
+
+    double w = 2 * M_PI * s.frequency / rate;
+    re = 1;
+    im = 0;
+    rotRe = (float)cos(w);
+    rotIm = (float)sin(w);
+
+    sweepFrames = (uint32_t)(s.sweepSeconds * rate);
+    sweepCycle = sweepFrames + (uint32_t)(SIGNAL_SWEEP_GAP * rate);
+    fadeFrames = (uint32_t)(SIGNAL_FADE * rate);
+    growth = exp(log((double)s.sweepEnd / s.sweepStart) / sweepFrames);
+    phase = 0;
+    step = s.sweepStart / rate;
+
+    rowSum = 0;
+    for (float& row : rows) {
+        row = random() * (2.0f / 4294967296.0f) - 1;
+        rowSum += row;
+    }
+}
+
+uint32_t SignalGenerator::random() {
+    // xorshift32
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+float SignalGenerator::tone() {
+    float out = im;
+    float next = re * rotRe - im * rotIm;
+    im = re * rotIm + im * rotRe;
+    re = next;
+    return out;
+}
+
+// Exponential sweep: the frequency grows by a constant factor per sample, so
+// every octave takes the same time; half-cosine fades at both ends
+float SignalGenerator::sweep() {
+    uint32_t at = position % sweepCycle;
+    if (at >= sweepFrames) {
+        phase = 0;
+        step = s.sweepStart / rate;
+        return 0;
+    }
+    float out = sinf((float)(2 * M_PI * phase));
+    phase += step;
+    phase -= floor(phase);
+    step *= growth;
+    uint32_t edge = at < sweepFrames - at ? at : sweepFrames - at;
+    if (edge < fadeFrames) {
+        out *= 0.5f - 0.5f * cosf((float)M_PI * edge / fadeFrames);
+    }
+    return out;
+}
+
+// Voss-McCartney: row k changes every 2^(k+1) samples, so each row adds noise
+// an octave lower than the one before and the sum falls at about 3 dB/octave
+float SignalGenerator::pink() {
+    counter++;
+    if (counter != 0) {
+        int row = __builtin_ctz(counter);
+        if (row < SIGNAL_PINK_ROWS) {
+            float value = random() * (2.0f / 4294967296.0f) - 1;
+            rowSum += value - rows[row];
+            rows[row] = value;
+        }
+    }
+    return rowSum + random() * (2.0f / 4294967296.0f) - 1;
+}
+
+// Hann-shaped pulse, positive unless inverted: a polarity checker or a
+// microphone on each speaker in turn shows which way the cone moves first
+float SignalGenerator::pulse() {
+    uint32_t at = position % (uint32_t)(SIGNAL_PULSE_PERIOD * rate);
+    uint32_t width = (uint32_t)(SIGNAL_PULSE_WIDTH * rate);
+    if (at >= width) {
+        return 0;
+    }
+    return 0.5f - 0.5f * cosf(2 * (float)M_PI * (at + 0.5f) / width);
+}
+
+float SignalGenerator::sweepFrequency() const {
+    if (s.type != SIGNAL_SWEEP || position % sweepCycle >= sweepFrames) {
+        return 0;
+    }
+    return (float)(step * rate);
+}
+
+void SignalGenerator::generate(float* left, float* right, size_t frames) {
+    float* out = s.channels == SIGNAL_RIGHT ? right : left;
+    switch (s.type) {
+        case SIGNAL_TONE: {
+            for (size_t i = 0; i < frames; i++) {
+                out[i] = amplitude * tone();
+            }
+            // Keep the phasor on the unit circle against rounding drift
+            float correction = 1.5f - 0.5f * (re * re + im * im);
+            re *= correction;
+            im *= correction;
+            break;
+        }
+        case SIGNAL_SWEEP:
+            for (size_t i = 0; i < frames; i++, position++) {
+                out[i] = amplitude * sweep();
+            }
+            break;
+        case SIGNAL_PINK: {
+            float scale = amplitude / sqrtf((SIGNAL_PINK_ROWS + 1) / 3.0f);
+            for (size_t i = 0; i < frames; i++) {
+                out[i] = scale * pink();
+            }
+            break;
+        }
+        case SIGNAL_PULSE:
+            for (size_t i = 0; i < frames; i++, position++) {
+                out[i] = amplitude * pulse();
+            }
+            break;
+        default:
+            memset(left, 0, frames * sizeof(float));
+            memset(right, 0, frames * sizeof(float));
+            return;
+    }
+    if (s.type == SIGNAL_TONE || s.type == SIGNAL_PINK) {
+        position += frames;
+    }
+
+    if (s.channels == SIGNAL_BOTH) {
+        memcpy(right, left, frames * sizeof(float));
+    } else {
+        memset(out == left ? right : left, 0, frames * sizeof(float));
+    }
+}
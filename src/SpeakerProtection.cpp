@@ -0,0 +1,135 @@
+#include <math.h>
+#include <stdio.h>
+#include "SpeakerProtection.h"
+#include "BoardProfile.h"
+
+// Cone excursion of a full-scale DC level, mm
+static const float MM_PER_FULL_SCALE = Board::ampPeakVolts * Board::speakerMmPerVolt;
+
+// Power into one speaker of a full-scale DC level, W
+static const float WATTS_PER_FULL_SCALE = Board::ampPeakVolts * Board::ampPeakVolts / Board::speakerOhms;
+
+// Voice coil heating of a full-scale DC level, kelvin at steady state
+static const float KELVIN_PER_FULL_SCALE = WATTS_PER_FULL_SCALE * Board::speakerKelvinPerWatt;
+
+// Thermal gain reduction time constant, s
+static const float THERMAL_ATTACK = 0.1f;
+
+SpeakerProtection::SpeakerProtection()
+    : params{
+          { "margin", 0.9f, 0.5f, 1 },      // act above this share of Xmax and of the allowed coil rise
+          { "release", 1, 0.1f, 5 },        // s
+      } {
+    paramTable = params;
+    paramTotal = P_COUNT;
+}
+
+void SpeakerProtection::configure() {
+    float fs = (float)rate;
+    for (int c = 0; c < 2; c++) {
+        split[c].c = biquadHighPass(fs, Board::speakerResonanceHz, BIQUAD_BUTTERWORTH_Q);
+        modelHigh[c].c = biquadLowPass(fs, Board::speakerResonanceHz, Board::speakerQtc);
+        modelLow[c].c = modelHigh[c].c;
+    }
+    excursionLimit = params[P_MARGIN].value * Board::speakerXmaxMm / MM_PER_FULL_SCALE;
+}
+
+void SpeakerProtection::reset() {
+    for (int c = 0; c < 2; c++) {
+        split[c].reset();
+        modelHigh[c].reset();
+        modelLow[c].reset();
+    }
+    excursion = 0;
+    lowGain = 1;
+    excursionGain = 1;
+    gain = thermalGain;
+}
+
+void SpeakerProtection::process(float* left, float* right, size_t frames) {
+    float* channel[2] = { left, right };
+
+    // Split, and model the excursion of both parts; the high part replaces the input
+    float peakHigh = 0, peakLow = 0;
+    for (int c = 0; c < 2; c++) {
+        float* x = channel[c];
+        for (size_t i = 0; i < frames; i++) {
+            float high = split[c].process(x[i]);
+            float lowPart = x[i] - high;
+            peakHigh = fmaxf(peakHigh, fabsf(modelHigh[c].process(high)));
+            peakLow = fmaxf(peakLow, fabsf(modelLow[c].process(lowPart)));
+            x[i] = high;
+            low[c][i] = lowPart;
+        }
+    }
+
+    // Keep as much of the low part as the limit allows (|high + g low| <= |high| + g |low|);
+    // if the high part alone is too much, turn everything down
+    float blockSeconds = (float)frames / rate;
+    float release = 1 - expf(-blockSeconds / params[P_RELEASE].value);
+    float lowTarget = 1, excursionTarget = 1;
+    if (peakHigh + peakLow > excursionLimit) {
+        lowTarget = peakLow > 0 ? fmaxf(0, (excursionLimit - peakHigh) / peakLow) : 1;
+        if (peakHigh > excursionLimit) {
+            excursionTarget = excursionLimit / peakHigh;
+        }
+    }
+    float nextLow = lowTarget < lowGain ? lowTarget : lowGain + release * (lowTarget - lowGain);
+    excursionGain = excursionTarget < excursionGain ? excursionTarget
+                                                    : excursionGain + release * (excursionTarget - excursionGain);
+    excursion = (peakHigh + nextLow * peakLow) * excursionGain * MM_PER_FULL_SCALE;
+
+    // Past the margin, hold the power that keeps the coil at the margin
+    float riseLimit = params[P_MARGIN].value * Board::speakerMaxRiseK;
+    float thermalTarget = 1;
+    if (coilRise > riseLimit) {
+        float steadyRise = 0;
+        for (int c = 0; c < 2; c++) {
+            float sum = 0;
+            for (size_t i = 0; i < frames; i++) {
+                float y = channel[c][i] + nextLow * low[c][i];
+                sum += y * y;
+            }
+            steadyRise = fmaxf(steadyRise, sum / frames * KELVIN_PER_FULL_SCALE);
+        }
+        thermalTarget = steadyRise > riseLimit ? sqrtf(riseLimit / steadyRise) : 1;
+    }
+    float attack = 1 - expf(-blockSeconds / THERMAL_ATTACK);
+    thermalGain += (thermalTarget < thermalGain ? attack : release) * (thermalTarget - thermalGain);
+    float nextGain = excursionGain < thermalGain ? excursionGain : thermalGain;
+
+    // Apply with linear ramps and measure the power reaching the coil
+    float lowStep = (nextLow - lowGain) / frames, gainStep = (nextGain - gain) / frames;
+    float power = 0, total = 0;
+    for (int c = 0; c < 2; c++) {
+        float* x = channel[c];
+        float g = gain, gl = lowGain, sum = 0;
+        for (size_t i = 0; i < frames; i++) {
+            g += gainStep;
+            gl += lowStep;
+            x[i] = g * (x[i] + gl * low[c][i]);
+            sum += x[i] * x[i];
+        }
+        power = fmaxf(power, sum / frames);
+        total += sum / frames;
+    }
+    lowGain = nextLow;
+    gain = nextGain;
+
+    float heat = 1 - expf(-blockSeconds / Board::speakerThermalSeconds);
+    coilRise += heat * (power * KELVIN_PER_FULL_SCALE - coilRise);
+    watts += (1 - expf(-blockSeconds)) * (total * WATTS_PER_FULL_SCALE - watts);
+}
+
+float SpeakerProtection::lowGainDb() const {
+    return 20 * log10f(fmaxf(lowGain, 1e-5f));
+}
+
+float SpeakerProtection::gainDb() const {
+    return 20 * log10f(fmaxf(gain, 1e-5f));
+}
+
+int SpeakerProtection::status(char* text, size_t size) const {
+    return snprintf(text, size, "excursion %.2f mm, coil +%.1f K, bass %.1f dB, gain %.1f dB", excursion,
+                    coilRise, lowGainDb(), gainDb());
+}
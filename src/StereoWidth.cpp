@@ -0,0 +1,45 @@
+#include <math.h>
+#include "StereoWidth.h"
+
+StereoWidth::StereoWidth()
+    : params{
+          { "width", 1.5f, 0, 2 },      // 0 = mono, 1 = unchanged, 2 = side +6 dB re mid
+          { "mono", 120, 0, 300 },      // side high-pass, Hz (0 = off)
+      } {
+    paramTable = params;
+    paramTotal = P_COUNT;
+    enabled = false;
+}
+
+void StereoWidth::configure() {
+    float width = params[P_WIDTH].value;
+    midGain = sqrtf(2 / (1 + width * width));
+    sideGain = width * midGain;
+    // The 0.5 of the mid/side split is folded into the gains
+    midGain *= 0.5f;
+    sideGain *= 0.5f;
+
+    monoBass = params[P_MONO].value > 0;
+    if (monoBass) {
+        sideHighPass.c = biquadHighPass((float)rate, params[P_MONO].value, BIQUAD_BUTTERWORTH_Q);
+    }
+}
+
+void StereoWidth::process(float* left, float* right, size_t frames) {
+    float gm = midGain, gs = sideGain;
+    if (monoBass) {
+        for (size_t i = 0; i < frames; i++) {
+            float mid = gm * (left[i] + right[i]);
+            float side = gs * sideHighPass.process(left[i] - right[i]);
+            left[i] = mid + side;
+            right[i] = mid - side;
+        }
+    } else {
+        for (size_t i = 0; i < frames; i++) {
+            float mid = gm * (left[i] + right[i]);
+            float side = gs * (left[i] - right[i]);
+            left[i] = mid + side;
+            right[i] = mid - side;
+        }
+    }
+}
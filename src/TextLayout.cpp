@@ -0,0 +1,70 @@
+#include <string.h>
+#include "TextLayout.h"
+
+static bool isContinuation(char c) {
+    return ((uint8_t)c & 0xC0) == 0x80;
+}
+
+// Largest cut <= limit that does not split a UTF-8 sequence
+static size_t safeCut(const char* text, size_t limit) {
+    size_t cut = limit;
+    while (cut > 0 && isContinuation(text[cut])) {
+        cut--;
+    }
+    return cut > 0 ? cut : limit;
+}
+
+static void emit(TextLines& out, const char* text, size_t length, bool ellipsis) {
+    char* line = out.line[out.count++];
+    memcpy(line, text, length);
+    if (ellipsis) {
+        memcpy(line + length, "...", 3);
+        length += 3;
+    }
+    line[length] = '\0';
+}
+
+void layoutText(const char* text, int width, int maxLines, TextLines& out, size_t maxInput) {
+    width = width < 4 ? 4 : width > TEXT_MAX_WIDTH ? TEXT_MAX_WIDTH : width;
+    maxLines = maxLines < 1 ? 1 : maxLines > TEXT_MAX_LINES ? TEXT_MAX_LINES : maxLines;
+    out.count = 0;
+
+    size_t remaining = text != nullptr ? strnlen(text, maxInput) : 0;
+    if (remaining == 0) {
+        emit(out, "", 0, false);
+        return;
+    }
+
+    while (out.count < maxLines) {
+        if (remaining <= (size_t)width) {
+            emit(out, text, remaining, false);
+            return;
+        }
+        if (out.count == maxLines - 1) {
+            // Last line: cut and mark the truncation
+            emit(out, text, safeCut(text, width - 3), true);
+            return;
+        }
+
+        // Break at a space near the end of the line, else hard at the width
+        size_t breakPoint = safeCut(text, width);
+        for (size_t i = width; i + TEXT_BREAK_SEARCH >= (size_t)width && i > 0; i--) {
+            if (text[i] == ' ') {
+                breakPoint = i;
+                break;
+            }
+        }
+        emit(out, text, breakPoint, false);
+        text += breakPoint;
+        remaining -= breakPoint;
+
+        // The next line starts at the next word
+        while (remaining > 0 && *text == ' ') {
+            text++;
+            remaining--;
+        }
+        if (remaining == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include <Arduino.h>
+#include "Trace.h"
+#include "SerialConsole.h"
+
+TraceRecord traceRing[TRACE_RING_RECORDS];
+std::atomic<uint32_t> traceHead{0};
+bool traceActive = TRACE_ENABLED;
+
+static void traceDump() {
+    // Stop recording so the dump is a consistent snapshot
+    bool wasActive = traceActive;
+    traceActive = false;
+    delay(1);
+
+    uint32_t head = traceHead.load(std::memory_order_relaxed);
+    uint32_t count = head < TRACE_RING_RECORDS ? head : TRACE_RING_RECORDS;
+    uint32_t first = head - count;
+
+    Serial.printf("TRACE-BEGIN cpu_mhz=%lu records=%lu dropped=%lu\n",
+                  (unsigned long)getCpuFrequencyMhz(), (unsigned long)count, (unsigned long)first);
+    for (uint32_t i = first; i < head; i++) {
+        const uint8_t* bytes = (const uint8_t*)&traceRing[i & (TRACE_RING_RECORDS - 1)];
+        char hex[sizeof(TraceRecord) * 2 + 1];
+        for (size_t b = 0; b < sizeof(TraceRecord); b++) {
+            sprintf(hex + b * 2, "%02x", bytes[b]);
+        }
+        Serial.printf("T %s\n", hex);
+    }
+    Serial.println("TRACE-END");
+
+    traceActive = wasActive;
+}
+
+static void traceBench() {
+    // Cost of one TRACE() call in cycles, measured on this core
+    const int calls = 1000;
+    bool wasActive = traceActive;
+    traceActive = true;
+    uint32_t start = traceTimestamp();
+    for (int i = 0; i < calls; i++) {
+        TRACE(TRACE_BOOT, i, 0, 0);
+    }
+    uint32_t cycles = traceTimestamp() - start;
+    traceActive = wasActive;
+    Serial.printf("trace: %lu cycles/event\n", (unsigned long)(cycles / calls));
+}
+
+static void traceCommand(const char* args) {
+    if (strcmp(args, "on") == 0) {
+        traceActive = true;
+    } else if (strcmp(args, "off") == 0) {
+        traceActive = false;
+    } else if (strcmp(args, "clear") == 0) {
+        traceHead.store(0, std::memory_order_relaxed);
+    } else if (strcmp(args, "bench") == 0) {
+        traceBench();
+    } else {
+        traceDump();
+        return;
+    }
+    Serial.printf("trace: %s, %lu events recorded\n", traceActive ? "on" : "off",
+                  (unsigned long)traceHead.load(std::memory_order_relaxed));
+}
+
+void traceBegin() {
+    consoleRegister("trace", "dump event trace [on|off|clear|bench]", traceCommand);
+    TRACE(TRACE_BOOT, TRACE_RING_RECORDS, 0, 0);
+}
@@ -0,0 +1,90 @@
+#include <math.h>
+#include "VirtualBass.h"
+#include "BoardProfile.h"
+
+// Envelope floor: below about -80 dBFS the generator is not driven harder
+static const float ENVELOPE_FLOOR = 1e-4f;
+
+// Brings the band-limited harmonics to about the level of the low band they replace at gain 0 dB
+static const float HARMONIC_SCALE = 6.0f;
+
+// Harmonic high-pass (LR4) corner re the crossover: far enough above it that
+// the fundamental and the 2nd harmonic of notes an octave or more below the
+// crossover, which the drivers cannot play either, stay out
+static const float HARMONIC_HIGH_RATIO = 1.5f;
+
+VirtualBass::VirtualBass()
+    : params{
+          { "freq", Board::speakerLowCutHz, 40, 300 },    // crossover, Hz
+          { "gain", 0, -12, 12 },                         // harmonic level, dB
+          { "drive", 2, 1, 8 },                           // soft clipper drive (odd harmonics)
+          { "even", 0.5f, 0, 1 },                         // rectifier share (even harmonics)
+          { "cut", 1, 0, 1 },                             // 1 = remove the original sub-crossover band
+      } {
+    paramTable = params;
+    paramTotal = P_COUNT;
+    enabled = false;
+}
+
+void VirtualBass::configure() {
+    float fs = (float)rate, fc = params[P_FREQ].value;
+    for (int i = 0; i < 2; i++) {
+        lowBand[i].c = biquadLowPass(fs, fc, BIQUAD_BUTTERWORTH_Q);
+        cutLeft[i].c = biquadHighPass(fs, fc, BIQUAD_BUTTERWORTH_Q);
+        cutRight[i].c = biquadHighPass(fs, fc, BIQUAD_BUTTERWORTH_Q);
+        harmonicHigh[i].c = biquadHighPass(fs, HARMONIC_HIGH_RATIO * fc, BIQUAD_BUTTERWORTH_Q);
+    }
+    harmonicLow.c = biquadLowPass(fs, 4 * fc, BIQUAD_BUTTERWORTH_Q);
+    // Envelope follows the low band with about a 20 ms time constant
+    envelope.setTimes(fs, 0.020f, 0.020f);
+    // Fundamental the clipper passes at its nominal drive (u = +-drive), subtracted
+    // in process() so that mostly odd harmonics are left for the high-pass
+    float d = params[P_DRIVE].value, sum = 0;
+    for (int n = 0; n < 64; n++) {
+        float x = sinf(2 * (float)M_PI * (n + 0.5f) / 64);
+        float u = x * d > 1 ? 1 : x * d < -1 ? -1 : x * d;
+        sum += (u - u * u * u * (1.0f / 3)) * (1.5f / d) * x;
+    }
+    fundamentalGain = sum / 32;
+    mixGain = HARMONIC_SCALE * powf(10, params[P_GAIN].value / 20);
+}
+
+void VirtualBass::reset() {
+    for (int i = 0; i < 2; i++) {
+        lowBand[i].reset();
+        cutLeft[i].reset();
+        cutRight[i].reset();
+        harmonicHigh[i].reset();
+    }
+    harmonicLow.reset();
+    envelope.reset();
+}
+
+void VirtualBass::process(float* left, float* right, size_t frames) {
+    // Normalize the generator input once per block: u is about +-drive at any level
+    float env = envelope.value > ENVELOPE_FLOOR ? envelope.value : ENVELOPE_FLOOR;
+    float drive = params[P_DRIVE].value / (env * 1.4142f);
+    float evenMix = params[P_EVEN].value;
+    float oddMix = 1 - evenMix;
+    bool cut = params[P_CUT].value >= 0.5f;
+
+    for (size_t i = 0; i < frames; i++) {
+        float low = lowBand[1].process(lowBand[0].process(0.5f * (left[i] + right[i])));
+        float magnitude = fabsf(low);
+        envelope.process(magnitude);
+
+        // Cubic soft clip, flat at +-2/3 beyond |u| = 1; scaled back to the input level
+        float u = low * drive;
+        u = u > 1 ? 1 : u < -1 ? -1 : u;
+        float odd = (u - u * u * u * (1.0f / 3)) * (1.5f / drive) - fundamentalGain * low;
+        float generated = harmonicHigh[1].process(harmonicHigh[0].process(evenMix * magnitude + oddMix * odd));
+        float harmonics = harmonicLow.process(generated) * mixGain;
+
+        if (cut) {
+            left[i] = cutLeft[1].process(cutLeft[0].process(left[i]));
+            right[i] = cutRight[1].process(cutRight[0].process(right[i]));
+        }
+        left[i] += harmonics;
+        right[i] += harmonics;
+    }
+}
@@ -4,65 +4,80 @@
 #include <Wire.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
-#include <RotaryEncoder.h>
-
-// Pin definitions
-#define DSP_MODEL           DSP_SSD1306
-#define I2S_DOUT            25
-#define I2S_BCLK            27
-#define I2S_LRC             26
-#define ENC_BTNR            32
-#define ENC_BTNL            33
-#define ENC_BTNB            34
-#define ENC_INTERNALPULLUP  false
-#define ENC2_BTNR           35
-#define ENC2_BTNL           36
-#define ENC2_BTNB           39
-#define ENC2_INTERNALPULLUP false
-
-// OLED display settings
-#define SCREEN_WIDTH 128
-#define SCREEN_HEIGHT 64
-#define OLED_RESET -1
+#include <esp_sleep.h>
+#include <soc/rtc.h>
+#include "Logger.h"
+#include "Trace.h"
+#include "SerialConsole.h"
+#include "MemoryMonitor.h"
+#include "BtMemory.h"
+#include "DeviceSwitcher.h"
+#include "PairedDevices.h"
+#include "BtGap.h"
+#include "LinkMonitor.h"
+#include "AudioChain.h"
+#include "AudioControl.h"
+#include "Player.h"
+#include "EventCapture.h"
+#include "TextLayout.h"
+#include "BatteryMonitor.h"
+#include "Calibration.h"
+#include "EqControl.h"
+#include "AudioClock.h"
+#include "EncoderInput.h"
+#include "BoardProfile.h"     // Pin and feature settings for the selected board
 
 // Global objects
 BluetoothA2DPSink a2dp_sink;
 I2SStream i2s;
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
-RotaryEncoder volumeEncoder(ENC_BTNR, ENC_BTNL, RotaryEncoder::LatchMode::TWO03);
-RotaryEncoder trackEncoder(ENC2_BTNR, ENC2_BTNL, RotaryEncoder::LatchMode::TWO03);
+Adafruit_SSD1306 display(Board::screenWidth, Board::screenHeight, &Wire, Board::oledReset);
+EncoderInput<Board::encBtnR, Board::encBtnL, Board::encBtnB, Board::encInternalPullup> volumeEncoder;
+EncoderInput<Board::enc2BtnR, Board::enc2BtnL, Board::enc2BtnB, Board::enc2InternalPullup, Board::hasTrackEncoder>
+    trackEncoder;               // empty on profiles without the track encoder
+Player player;                  // Connection, playback, volume, page and track metadata
 
 // Global variables
-int volume = 50;                // Volume level (0-100)
-int lastVolumeEncoderPos = 0;
-int lastTrackEncoderPos = 0;
 String deviceName = "ESP32-Speaker";
-String connectedDevice = "Not Connected";
-String trackTitle = "No Track";
-String artist = "Unknown Artist";
-bool isPlaying = false;
 bool displayNeedsUpdate = true;
 bool showVolumeBar = false;     // Only show volume bar during changes
 unsigned long lastDisplayUpdate = 0;
 unsigned long lastButtonCheck = 0;
 unsigned long volumeBarShowTime = 0;
+unsigned long batteryNoticeTime = 0;
+bool batteryNotice = false;     // Low-battery notice on the player page
+unsigned long eqNoticeTime = 0;
+bool eqNotice = false;          // EQ preset name on the player page after a change
+int i2sBufferCount = AUDIO_DMA_BUFFER_COUNT;    // deepened with reclaimed BLE memory
 const unsigned long VOLUME_BAR_TIMEOUT = 3000; // Show for 3 seconds
+const unsigned long EQ_NOTICE_TIME = 2000;
 
 // Function declarations
 void setupDisplay();
 void setupBluetooth();
+void startI2s(uint32_t sampleRate);
+void onSampleRate(uint16_t rate);
 void setupEncoders();
-void updateDisplay();
+template <typename B> void updateDisplay();
+void updateDiagnosticsDisplay();
+template <typename L> int drawTextLines(const char* text, int lines, int y);
 void handleVolumeEncoder();
-void handleTrackEncoder();
-void handleButtons();
+template <typename B> void handleTrackEncoder();
+template <typename B> void handleButtons();
+void handleBatteryLevel();
+void batteryShutdown();
+void performAction(PlayerAction action);
 void onBluetoothConnected(esp_a2d_connection_state_t state, void* ptr);
+void onAudioStateChanged(esp_a2d_audio_state_t state, void* ptr);
 void read_data_stream(const uint8_t* data, uint32_t length);
+size_t writeAudio(const uint8_t* data, uint32_t length);
 void avrc_metadata_callback(uint8_t id, const uint8_t *text);
 
 void setup() {
     Serial.begin(115200);
-    Serial.println("ESP32 Bluetooth Speaker Starting...");
+    logBegin();
+    traceBegin();
+    LOG_I("ESP32 Bluetooth Speaker Starting...");
+    player.begin(50);
     
     // Initialize display
     setupDisplay();
@@ -73,7 +88,19 @@ void setup() {
     // Initialize Bluetooth
     setupBluetooth();
     
-    Serial.println("Setup complete!");
+    // Paired phone memory and boot-time reconnect through the list
+    deviceSwitcherBegin(a2dp_sink, player.state().volume);
+    
+    // Heap and stack health monitoring
+    memoryMonitorBegin();
+    
+    // Battery voltage and charge estimate
+    batteryMonitorBegin();
+    
+    // Event capture for host replay (tools/sim/replay.cpp)
+    captureBegin(player);
+    
+    LOG_I("Setup complete!");
     displayNeedsUpdate = true;
 }
 
@@ -82,17 +109,55 @@ void loop() {
     
     // Handle encoder inputs
     handleVolumeEncoder();
-    handleTrackEncoder();
+    handleTrackEncoder<Board>();
     
     // Handle button inputs (check every 50ms)
     if (currentTime - lastButtonCheck > 50) {
-        handleButtons();
+        handleButtons<Board>();
         lastButtonCheck = currentTime;
     }
     
+    // Serial commands (trace dump etc.)
+    consolePoll();
+    
+    // Paired device switching; apply the stored volume and name of a newly connected phone
+    deviceSwitcherUpdate(currentTime);
+    int deviceVolume;
+    if (deviceSwitcherTakeVolume(deviceVolume) && deviceVolume != player.state().volume) {
+        captureEvent(EVENT_VOLUME_SET, (uint8_t)deviceVolume);
+        player.setVolume(deviceVolume);
+        a2dp_sink.set_volume(player.state().volume);
+        displayNeedsUpdate = true;
+    }
+    char deviceNameText[PAIRED_NAME_LENGTH];
+    if (deviceSwitcherTakeName(deviceNameText, sizeof(deviceNameText))) {
+        captureEvent(EVENT_DEVICE_NAME, deviceNameText, (uint8_t)strlen(deviceNameText));
+        player.setDeviceName(deviceNameText);
+        LOG_I("Connected device: %s", deviceNameText);
+        displayNeedsUpdate = true;
+    }
+    int devicePreset;
+    if (deviceSwitcherTakeEqPreset(devicePreset)) {
+        eqControlApply(devicePreset);
+        LOG_I("EQ preset: %s", eqControlPresetName());
+    }
+    
+    // Sample heap and stack usage (every second)
+    memoryMonitorUpdate(currentTime);
+    
+    // Poll link RSSI and report underruns
+    linkMonitorUpdate(currentTime);
+    
+    // Battery charge; limit the volume, warn or shut down as it runs out (every second)
+    if (batteryMonitorUpdate(currentTime)) {
+        handleBatteryLevel();
+    }
+    
     // Update display (every 100ms)
     if (displayNeedsUpdate || (currentTime - lastDisplayUpdate > 100)) {
-        updateDisplay();
+        TRACE(TRACE_DISPLAY_BEGIN, 0, 0, 0);
+        updateDisplay<Board>();
+        TRACE(TRACE_DISPLAY_END, 0, 0, 0);
         lastDisplayUpdate = currentTime;
         displayNeedsUpdate = false;
     }
@@ -101,10 +166,10 @@ void loop() {
 }
 
 void setupDisplay() {
-    Wire.begin(21, 22); // SDA=21, SCL=22 for ESP32
+    Wire.begin(Board::i2cSda, Board::i2cScl);
     
-    if (!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
-        Serial.println("SSD1306 allocation failed");
+    if (!display.begin(SSD1306_SWITCHCAPVCC, Board::oledAddress)) {
+        LOG_E("SSD1306 allocation failed");
         for (;;); // Don't proceed, loop forever
     }
     
@@ -117,58 +182,101 @@ void setupDisplay() {
     display.println("Initializing...");
     display.display();
     
-    Serial.println("Display initialized");
+    LOG_I("Display initialized");
 }
 
 void setupBluetooth() {
-    // Initialize I2S output for PCM5102A DAC
-    auto config = i2s.defaultConfig(TX_MODE);
-    config.pin_bck = I2S_BCLK;
-    config.pin_ws = I2S_LRC;
-    config.pin_data = I2S_DOUT;
-    config.sample_rate = 44100;
-    config.bits_per_sample = 16;
-    config.channels = 2;
-    i2s.begin(config);
+    // Return BLE controller memory before the stack starts (Classic A2DP only)
+    uint32_t reclaimed = btReleaseUnusedMemory();
+    i2sBufferCount = audioBufferCount(reclaimed);
+    
+    // I2S output for the board's DAC, at the SBC default rate until a stream says otherwise
+    startI2s(44100);
+    audioControlBegin();
+    eqControlBegin();
+    calibrationBegin(writeAudio);
+    LOG_I("BLE memory reclaimed: %lu bytes, I2S buffers: %d x %d frames (%lu ms)", (unsigned long)reclaimed,
+          i2sBufferCount, AUDIO_DMA_BUFFER_FRAMES, (unsigned long)audioBufferDepthMs(i2sBufferCount, 44100));
     
     // Initialize Bluetooth A2DP sink with AVRCP support and auto-reconnect
     a2dp_sink.set_stream_reader(read_data_stream, false);
+    a2dp_sink.set_sample_rate_callback(onSampleRate);
     a2dp_sink.set_on_connection_state_changed(onBluetoothConnected);
+    a2dp_sink.set_on_audio_state_changed(onAudioStateChanged);
     a2dp_sink.set_avrc_metadata_callback(avrc_metadata_callback);
     
-    // Enable auto-reconnect and make device discoverable
-    a2dp_sink.set_auto_reconnect(true);
+    // Reconnection walks the paired device list (DeviceSwitcher), so the
+    // library's single-device auto-reconnect stays off
+    a2dp_sink.set_auto_reconnect(false);
+#if BT_CLASSIC_ONLY
+    a2dp_sink.set_default_bt_mode(ESP_BT_MODE_CLASSIC_BT);
+#endif
     a2dp_sink.start(deviceName.c_str());
+    btGapBegin();
+    linkMonitorBegin(a2dp_sink, audioBufferDepthMs(i2sBufferCount, 44100));
     
     // Set initial volume
-    a2dp_sink.set_volume(volume);
+    a2dp_sink.set_volume(player.state().volume);
     
-    Serial.println("Bluetooth A2DP initialized with auto-reconnect enabled");
+    LOG_I("Bluetooth A2DP initialized");
 }
 
-void setupEncoders() {
-    // Setup volume encoder pins
-    if (!ENC_INTERNALPULLUP) {
-        pinMode(ENC_BTNR, INPUT_PULLUP);
-        pinMode(ENC_BTNL, INPUT_PULLUP);
+// (Re)start I2S at a stream rate with MCLK from the APLL where the board uses
+// it, and run the processing chain at the same rate
+void startI2s(uint32_t sampleRate) {
+    // APLL fractional multiplier only from chip revision 1 on
+    const AudioClock& clock = audioClockSelect(sampleRate, Board::i2sApll, ESP.getChipRevision() > 0);
+    auto config = i2s.defaultConfig(TX_MODE);
+    config.pin_bck = Board::i2sBclk;
+    config.pin_ws = Board::i2sLrc;
+    config.pin_data = Board::i2sDout;
+    config.sample_rate = clock.sampleRate;
+    config.use_apll = clock.apll;
+    config.fixed_mclk = clock.apll ? clock.sampleRate * clock.mclkRatio : 0;
+    config.bits_per_sample = 16;
+    config.channels = 2;
+    config.buffer_size = AUDIO_DMA_BUFFER_FRAMES;     // reaches the driver as dma_buf_len, in frames
+    config.buffer_count = i2sBufferCount;
+    i2s.begin(config);
+    if (clock.apll) {
+        // The driver computed its own APLL setting for this MCLK; program the closest one over it
+        const ApllCoeffs& c = clock.coeffs;
+        rtc_clk_apll_enable(true, c.sdm0, c.sdm1, c.sdm2, c.oDiv);
     }
-    pinMode(ENC_BTNB, INPUT_PULLUP);
-    
-    // Setup track encoder pins
-    if (!ENC2_INTERNALPULLUP) {
-        pinMode(ENC2_BTNR, INPUT_PULLUP);
-        pinMode(ENC2_BTNL, INPUT_PULLUP);
+    audioChainBegin(clock.sampleRate);
+    LOG_I("I2S clock: %lu Hz from %s, %+.2f ppm (divider %+.2f ppm)", (unsigned long)clock.sampleRate,
+          clock.apll ? "APLL" : "PLL_D2 divider", clock.errorPpm, dividerErrorPpm(clock.sampleRate));
+}
+
+// Sample rate of a new stream (SBC: 16, 32, 44.1 or 48 kHz). Called on the
+// Bluetooth task, which also runs read_data_stream(), so no block is in flight
+void onSampleRate(uint16_t rate) {
+    if (rate == audioClock().sampleRate) {
+        return;
     }
-    pinMode(ENC2_BTNB, INPUT_PULLUP);
-    
-    // Initialize encoder positions
-    lastVolumeEncoderPos = volumeEncoder.getPosition();
-    lastTrackEncoderPos = trackEncoder.getPosition();
+    i2s.end();
+    startI2s(rate);
+    linkMonitorSetBufferDepth(audioBufferDepthMs(i2sBufferCount, rate));
+}
+
+void setupEncoders() {
+    // Pins and start positions; nothing for an encoder the board does not have
+    volumeEncoder.begin();
+    trackEncoder.begin();
     
-    Serial.println("Encoders initialized");
+    LOG_I("Encoders initialized");
 }
 
+// Player page, laid out for the profile's panel (DisplayLayout<B>)
+template <typename B>
 void updateDisplay() {
+    typedef DisplayLayout<B> L;
+    const PlayerState& state = player.state();
+    if (state.page != PAGE_PLAYER) {
+        updateDiagnosticsDisplay();
+        return;
+    }
+    
     display.clearDisplay();
     
     // Set monochrome white text
@@ -180,22 +288,22 @@ void updateDisplay() {
     
     // Connection status
     display.setCursor(0, currentYPos);
-    if (a2dp_sink.is_connected()) {
-        String deviceText = connectedDevice;
-        // Show more of the device name (up to 18 characters)
-        if (deviceText.length() > 18) {
-            deviceText = deviceText.substring(0, 15) + "...";
-        }
-        display.println(deviceText);
+    if (state.connected) {
+        // Show as much of the device name as fits, leaving a little margin
+        TextLines deviceText;
+        layoutText(state.device, L::charsPerLine - 3, 1, deviceText, sizeof(state.device));
+        display.println(deviceText.line[0]);
     } else {
-        display.println("Waiting for device...");
+        // 18 characters, like the device name: clear of the battery icon
+        display.println("Waiting for device");
     }
-    currentYPos += 10;
+    batteryMonitorDrawIcon(display, B::screenWidth - 14, 0, millis());
+    currentYPos += L::lineHeight;
     
     // Volume section - ALWAYS show volume bar
     display.setCursor(0, currentYPos);
     display.print("Vol: ");
-    display.print(volume);
+    display.print(state.volume);
     display.print("%");
     
     // Volume bar visualization - always visible
@@ -208,309 +316,364 @@ void updateDisplay() {
     display.drawRect(barX, barY, barWidth, barHeight, SSD1306_WHITE);
     
     // Fill volume bar
-    int fillWidth = (volume * (barWidth - 2)) / 100;
+    int fillWidth = (state.volume * (barWidth - 2)) / 100;
     if (fillWidth > 0) {
         display.fillRect(barX + 1, barY + 1, fillWidth, barHeight - 2, SSD1306_WHITE);
     }
     
-    currentYPos += 12; // Move content down
+    currentYPos = L::bodyTop; // Move content down
     
-    // Track info section - better text fitting
-    if (a2dp_sink.is_connected()) {
-        if (isPlaying) {
-            // Artist name with better word wrapping
-            display.setCursor(0, currentYPos);
-            String displayArtist = artist;
-            if (displayArtist == "Unknown Artist" || displayArtist == "" || displayArtist == "From Phone") {
-                displayArtist = "No artist info";
-            }
-            
-            // Better word wrap for artist name (21 chars per line)
-            int maxCharsPerLine = 21;
-            if (displayArtist.length() > maxCharsPerLine) {
-                // Try to break at word boundaries
-                int breakPoint = maxCharsPerLine;
-                String line1, line2;
-                
-                // Look for space near the break point
-                for (int i = maxCharsPerLine; i >= maxCharsPerLine - 5; i--) {
-                    if (i < displayArtist.length() && displayArtist.charAt(i) == ' ') {
-                        breakPoint = i;
-                        break;
-                    }
-                }
-                
-                line1 = displayArtist.substring(0, breakPoint);
-                line2 = displayArtist.substring(breakPoint);
-                line2.trim(); // Remove leading space
-                
-                // If second line is still too long, truncate it
-                if (line2.length() > maxCharsPerLine) {
-                    line2 = line2.substring(0, maxCharsPerLine - 3) + "...";
+    // Low-battery notice replaces the track info for a few seconds
+    if (batteryNotice && millis() - batteryNoticeTime < BATTERY_WARNING_TIME) {
+        const BatteryGauge& gauge = batteryGauge();
+        display.setCursor(0, currentYPos);
+        display.printf("Battery %s %d%%", gauge.levelName(), gauge.percent());
+        if constexpr (L::bodyLines >= 2) {
+            display.setCursor(0, currentYPos + 10);
+            display.printf("Max volume %d%%", gauge.volumeLimit());
+        }
+    } else if (eqNotice && millis() - eqNoticeTime < EQ_NOTICE_TIME) {
+        display.setCursor(0, currentYPos);
+        display.printf("EQ %s", eqControlPresetName());
+    } else if (state.connected) {
+        if (state.playing) {
+            // Artist name, wrapped onto two lines on tall panels (skipped on short ones)
+            if constexpr (L::showArtist) {
+                const char* displayArtist = state.artist;
+                if (!strcmp(displayArtist, "Unknown Artist") || !displayArtist[0] || !strcmp(displayArtist, "From Phone")) {
+                    displayArtist = "No artist info";
                 }
-                
-                display.println(line1);
-                currentYPos += 10;
-                display.setCursor(0, currentYPos);
-                display.println(line2);
-            } else {
-                display.println(displayArtist);
+                currentYPos = drawTextLines<L>(displayArtist, L::wrapText ? 2 : 1, currentYPos);
             }
-            currentYPos += 10;
-            
-            // Song title with better word wrapping
-            display.setCursor(0, currentYPos);
-            String displayTitle = trackTitle;
-            if (displayTitle == "No Track" || displayTitle == "Playing Music") {
-                displayTitle = "Loading...";
-            }
-            
-            // Improved word wrap for song titles (handles longer titles)
-            const int maxChars = 21;
-            if (displayTitle.length() > maxChars) {
-                // Try to break at word boundaries
-                int breakPoint = maxChars;
-                String line1, line2;
-                
-                // Look for space near the break point
-                for (int i = maxChars; i >= maxChars - 5; i--) {
-                    if (i < displayTitle.length() && displayTitle.charAt(i) == ' ') {
-                        breakPoint = i;
-                        break;
-                    }
-                }
-                
-                line1 = displayTitle.substring(0, breakPoint);
-                line2 = displayTitle.substring(breakPoint);
-                line2.trim(); // Remove leading space
                 
-                // If second line is still too long, truncate it
-                if (line2.length() > maxChars) {
-                    line2 = line2.substring(0, maxChars - 3) + "...";
-                }
-                
-                display.println(line1);
-                currentYPos += 10;
-                display.setCursor(0, currentYPos);
-                display.println(line2);
-            } else {
-                display.println(displayTitle);
+            // Song title, wrapped at word boundaries or truncated on one-line panels
+            const char* displayTitle = state.title;
+            if (!strcmp(displayTitle, "No Track") || !strcmp(displayTitle, "Playing Music")) {
+                displayTitle = "Loading...";
             }
+            drawTextLines<L>(displayTitle, L::wrapText ? 2 : 1, currentYPos);
             
         } else {
             display.setCursor(0, currentYPos);
             display.println("Ready - Press Vol knob");
-            display.setCursor(0, currentYPos + 10);
-            display.println("to Play/Pause");
+            if constexpr (L::bodyLines >= 2) {
+                display.setCursor(0, currentYPos + 10);
+                display.println("to Play/Pause");
+            }
         }
     } else {
         display.setCursor(0, currentYPos);
         display.println("Pair your device");
-        display.setCursor(0, currentYPos + 10);
-        display.println("Name: ESP32-Speaker");
+        if constexpr (L::bodyLines >= 2) {
+            display.setCursor(0, currentYPos + 10);
+            display.println("Name: ESP32-Speaker");
+        }
+    }
+    
+    display.display();
+}
+
+// Word-wrapped text starting at y; returns the y below the last line
+template <typename L>
+int drawTextLines(const char* text, int lines, int y) {
+    static_assert(L::charsPerLine <= TEXT_MAX_WIDTH, "panel is wider than the text layout buffers");
+    TextLines wrapped;
+    layoutText(text, L::charsPerLine, lines, wrapped, PLAYER_TEXT_LENGTH);
+    for (int i = 0; i < wrapped.count; i++) {
+        display.setCursor(0, y);
+        display.println(wrapped.line[i]);
+        y += L::lineHeight;
+    }
+    return y;
+}
+
+void updateDiagnosticsDisplay() {
+    display.clearDisplay();
+    display.setTextSize(1);
+    display.setTextColor(SSD1306_WHITE, SSD1306_BLACK);
+    
+    switch (player.state().page) {
+        case PAGE_DEVICES:
+            deviceSwitcherDraw(display, Board::screenHeight / 8);
+            break;
+        case PAGE_MEMORY:
+            memoryMonitorDraw(display, Board::screenHeight / 8);
+            break;
+        case PAGE_LINK:
+            linkMonitorDraw(display, Board::screenHeight / 8);
+            break;
+        case PAGE_SIGNAL:
+            calibrationDraw(display, Board::screenHeight / 8);
+            break;
     }
     
     display.display();
 }
 
 void handleVolumeEncoder() {
-    volumeEncoder.tick();
-    int newPos = volumeEncoder.getPosition();
-    
-    if (newPos != lastVolumeEncoderPos) {
-        int direction = newPos - lastVolumeEncoderPos;
-        // Reverse direction to match standard AV stereo controls
-        // Clockwise (right turn) should increase volume
-        volume -= direction * 5; // Reversed: subtract instead of add
-        
-        // Constrain volume to 0-100
-        volume = constrain(volume, 0, 100);
-        
-        // Set Bluetooth volume
-        a2dp_sink.set_volume(volume);
-        
-        lastVolumeEncoderPos = newPos;
-        displayNeedsUpdate = true;
-        
-        Serial.print("Volume: ");
-        Serial.print(volume);
-        Serial.println("%");
+    int direction = volumeEncoder.steps();
+    if (direction != 0) {
+        captureEvent(EVENT_VOLUME_STEP, (uint8_t)(int8_t)direction);
+        performAction(player.onVolumeStep(direction));
     }
 }
 
+template <typename B>
 void handleTrackEncoder() {
-    trackEncoder.tick();
-    int newPos = trackEncoder.getPosition();
-    
-    if (newPos != lastTrackEncoderPos) {
-        int direction = newPos - lastTrackEncoderPos;
-        
-        if (a2dp_sink.is_connected()) {
-            if (direction > 0) {
-                // Next track (clockwise)
-                Serial.println("Next track command sent");
-                a2dp_sink.next();
-                displayNeedsUpdate = true;
-            } else {
-                // Previous track (counter-clockwise)
-                Serial.println("Previous track command sent");
-                a2dp_sink.previous();
-                displayNeedsUpdate = true;
+    if constexpr (B::hasTrackEncoder) {
+        int direction = trackEncoder.steps();
+        if (direction != 0) {
+            TRACE(TRACE_TRACK_STEP, 0, direction, 0);
+            captureEvent(EVENT_TRACK_STEP, (uint8_t)(int8_t)direction);
+            PlayerAction action = player.onTrackStep(direction);
+            if (action == ACTION_NONE) {
+                LOG_I("Track control: No device connected");
             }
-        } else {
-            Serial.println("Track control: No device connected");
+            performAction(action);
         }
-        
-        lastTrackEncoderPos = newPos;
     }
 }
 
+template <typename B>
 void handleButtons() {
-    // Volume encoder button (play/pause)
-    static bool lastVolumeButton = HIGH;
-    bool volumeButton = digitalRead(ENC_BTNB);
-    
-    if (volumeButton == LOW && lastVolumeButton == HIGH) {
-        if (a2dp_sink.is_connected()) {
-            Serial.println("Play/Pause button pressed");
-            // Toggle play/pause state
-            static bool isPaused = false;
-            if (isPaused) {
+    // Volume encoder button (short press = play/pause, long press = next page)
+    static bool lastVolumeButton = false;
+    bool volumeButton = volumeEncoder.pressed();
+    if (volumeButton != lastVolumeButton) {
+        captureEvent(EVENT_VOLUME_BUTTON, volumeButton);
+        if (!volumeButton) {
+            TRACE(TRACE_BUTTON, B::encBtnB, 0, 0);
+        }
+    }
+    performAction(player.onVolumeButton(volumeButton, millis()));
+    lastVolumeButton = volumeButton;
+    
+    // Track encoder button (stop, or connect on the devices page)
+    if constexpr (B::hasTrackEncoder) {
+        static bool lastTrackButton = false;
+        bool trackButton = trackEncoder.pressed();
+        if (trackButton != lastTrackButton) {
+            captureEvent(EVENT_TRACK_BUTTON, trackButton);
+            if (trackButton) {
+                TRACE(TRACE_BUTTON, B::enc2BtnB, 0, 0);
+            }
+        }
+        performAction(player.onTrackButton(trackButton, millis()));
+        lastTrackButton = trackButton;
+    }
+}
+
+// Carry out what the player logic decided on the sink and the other modules
+void performAction(PlayerAction action) {
+    const PlayerState& state = player.state();
+    switch (action) {
+        case ACTION_NONE:
+            return;
+        case ACTION_SET_VOLUME:
+            // Set Bluetooth volume and remember it for this phone
+            a2dp_sink.set_volume(state.volume);
+            deviceSwitcherVolumeChanged(state.volume);
+            TRACE(TRACE_VOLUME_CHANGE, state.volume, 0, 0);
+            LOG_I("Volume: %d%%", state.volume);
+            break;
+        case ACTION_PLAY:
+        case ACTION_PAUSE:
+            LOG_I("Play/Pause button pressed");
+            if (action == ACTION_PLAY) {
                 a2dp_sink.play();
-                isPaused = false;
             } else {
                 a2dp_sink.pause();
-                isPaused = true;
             }
-            displayNeedsUpdate = true;
-        } else {
-            Serial.println("Play/Pause: No device connected");
-        }
+            break;
+        case ACTION_STOP:
+            LOG_I("Stop button pressed");
+            a2dp_sink.stop();
+            break;
+        case ACTION_NEXT_TRACK:
+            LOG_I("Next track command sent");
+            a2dp_sink.next();
+            break;
+        case ACTION_PREVIOUS_TRACK:
+            LOG_I("Previous track command sent");
+            a2dp_sink.previous();
+            break;
+        case ACTION_NEXT_PAGE:
+            LOG_I("Display page %d", state.page);
+            break;
+        case ACTION_SELECT_NEXT:
+            deviceSwitcherSelect(1);
+            break;
+        case ACTION_SELECT_PREVIOUS:
+            deviceSwitcherSelect(-1);
+            break;
+        case ACTION_CONNECT_SELECTED:
+            deviceSwitcherConnectSelected();
+            break;
+        case ACTION_SIGNAL_NEXT:
+            calibrationSelect(1);
+            break;
+        case ACTION_SIGNAL_PREVIOUS:
+            calibrationSelect(-1);
+            break;
+        case ACTION_SIGNAL_TOGGLE:
+            calibrationToggle();
+            break;
+        case ACTION_NEXT_EQ_PRESET:
+            // Remembered for the connected phone; the stage crossfades to it
+            eqControlNext();
+            LOG_I("EQ preset: %s", eqControlPresetName());
+            eqNotice = true;
+            eqNoticeTime = millis();
+            break;
     }
-    lastVolumeButton = volumeButton;
+    displayNeedsUpdate = true;
+}
+
+// Apply a battery level change: volume limit and notice, or shutdown when empty
+void handleBatteryLevel() {
+    const BatteryGauge& gauge = batteryGauge();
+    if (gauge.level() == BATTERY_EMPTY) {
+        batteryShutdown();
+        return;
+    }
+    captureEvent(EVENT_VOLUME_LIMIT, (uint8_t)gauge.volumeLimit());
+    performAction(player.setVolumeLimit(gauge.volumeLimit()));
+    batteryNotice = gauge.level() != BATTERY_OK;
+    batteryNoticeTime = millis();
+    displayNeedsUpdate = true;
+}
+
+// Save state, release the phone and sleep until the volume knob is pressed
+// (after charging); running on would end in brownout resets
+void batteryShutdown() {
+    LOG_W("Battery empty, shutting down");
+    display.clearDisplay();
+    display.setCursor(0, 0);
+    display.println("Battery empty");
+    display.println("Charge, then press");
+    display.println("the volume knob");
+    display.display();
     
-    // Track encoder button (stop)
-    static bool lastTrackButton = HIGH;
-    bool trackButton = digitalRead(ENC2_BTNB);
+    deviceSwitcherFlush();
+    a2dp_sink.end();
+    i2s.end();
+    delay(3000);    // Notice on screen, log drained
     
-    if (trackButton == LOW && lastTrackButton == HIGH) {
-        if (a2dp_sink.is_connected()) {
-            Serial.println("Stop button pressed");
-            a2dp_sink.stop();
-            isPlaying = false;
-            displayNeedsUpdate = true;
-        } else {
-            Serial.println("Stop: No device connected");
-        }
-    }
-    lastTrackButton = trackButton;
+    display.ssd1306_command(SSD1306_DISPLAYOFF);
+    esp_sleep_enable_ext0_wakeup((gpio_num_t)Board::encBtnB, 0);
+    esp_deep_sleep_start();
 }
 
 void onBluetoothConnected(esp_a2d_connection_state_t state, void* ptr) {
+    TRACE(TRACE_A2DP_CONNECTION, state, 0, 0);
+    captureEvent(EVENT_CONNECTION, (uint8_t)state);
+    deviceSwitcherOnConnection(state);
+    player.onConnection(state);
     if (state == ESP_A2D_CONNECTION_STATE_CONNECTED) {
-        // Try to get device name or use default
-        connectedDevice = "Phone Connected";
-        isPlaying = false;
-        Serial.print("Bluetooth device connected: ");
-        Serial.println(connectedDevice);
+        LOG_I("Bluetooth device connected");
     } else if (state == ESP_A2D_CONNECTION_STATE_DISCONNECTED) {
-        connectedDevice = "Not Connected";
-        isPlaying = false;
-        trackTitle = "No Track";
-        artist = "Unknown Artist";
-        Serial.println("Bluetooth device disconnected");
+        linkMonitorOnDisconnect();
+        LOG_I("Bluetooth device disconnected");
     }
     displayNeedsUpdate = true;
 }
 
+void onAudioStateChanged(esp_a2d_audio_state_t state, void* ptr) {
+    // Suspended on pause: the silence until the phone resumes is not an underrun
+    if (state != ESP_A2D_AUDIO_STATE_STARTED) {
+        linkMonitorOnSuspend();
+    }
+}
+
 void read_data_stream(const uint8_t* data, uint32_t length) {
     // This function is called when audio data is received
     // Write the audio data to I2S output
-    i2s.write(data, length);
+    TRACE(TRACE_A2DP_DATA, 0, length, 0);
+    linkMonitorOnPacket(length);
+    if (captureActive) {
+        uint16_t packetBytes = length > 0xFFFF ? 0xFFFF : length;
+        captureRecord(EVENT_AUDIO, &packetBytes, sizeof(packetBytes));
+    }
+    TRACE(TRACE_I2S_WRITE_BEGIN, 0, length, 0);
+    bool streamStarted = player.onAudio();
+    // Phone audio is dropped while a calibration signal plays
+    bool calibrating = calibrationActive();
+    if (streamStarted && !calibrating) {
+        audioChain().reset();
+    }
+    size_t written = calibrating ? length : writeAudio(data, length);
+    TRACE(TRACE_I2S_WRITE_END, 0, written, 0);
     
-    if (!isPlaying) {
-        isPlaying = true;
+    if (streamStarted) {
         displayNeedsUpdate = true;
-        Serial.println("Audio stream started");
+        LOG_I("Audio stream started");
     }
 }
 
+size_t writeAudio(const uint8_t* data, uint32_t length) {
+    AudioPipeline& chain = audioChain();
+    if (!chain.active()) {
+        return i2s.write(data, length);
+    }
+    
+    // Run the processing chain block by block (tools/sim/audio_sim.cpp mirrors this loop)
+    static int16_t block[AUDIO_BLOCK_FRAMES * 2];
+    const int16_t* samples = (const int16_t*)data;
+    size_t frames = length / 4;
+    size_t written = 0;
+    for (size_t done = 0; done < frames; done += AUDIO_BLOCK_FRAMES) {
+        size_t n = frames - done < AUDIO_BLOCK_FRAMES ? frames - done : AUDIO_BLOCK_FRAMES;
+        chain.process(samples + done * 2, block, n);
+        written += i2s.write((const uint8_t*)block, n * 4);
+    }
+    return written;
+}
+
 void avrc_metadata_callback(uint8_t id, const uint8_t *text) {
     // This function receives metadata from the connected device
-    String metadata = String((char*)text);
+    // Read at most PLAYER_TEXT_LENGTH - 1 bytes, whether or not text is NUL terminated
+    if (text == nullptr) {
+        return;
+    }
+    const char* metadata = (const char*)text;
+    size_t length = strnlen(metadata, PLAYER_TEXT_LENGTH - 1);
+    TRACE(TRACE_AVRC_METADATA, id, length, 0);
+    if (captureActive) {
+        uint8_t record[PLAYER_TEXT_LENGTH];
+        record[0] = id;
+        memcpy(record + 1, metadata, length);
+        captureRecord(EVENT_METADATA, record, (uint8_t)(1 + length));
+    }
+    
+    // Title and artist are cleaned up by the player (channel names, "(Official Video)" etc.)
+    player.onMetadata(id, metadata);
     
     switch (id) {
         case ESP_AVRC_MD_ATTR_TITLE:
-            // Clean up YouTube titles - remove channel names
-            trackTitle = metadata;
-            
-            // Remove common YouTube patterns
-            if (trackTitle.indexOf(" - ") > 0) {
-                // If there's " - ", keep only the part after it (usually the song name)
-                int dashPos = trackTitle.lastIndexOf(" - ");
-                if (dashPos > 0 && dashPos < trackTitle.length() - 3) {
-                    trackTitle = trackTitle.substring(dashPos + 3);
-                }
-            }
-            
-            // Remove "(Official Video)", "(Official Music Video)", etc.
-            trackTitle.replace("(Official Video)", "");
-            trackTitle.replace("(Official Music Video)", "");
-            trackTitle.replace("(Official Audio)", "");
-            trackTitle.replace("(Lyric Video)", "");
-            trackTitle.replace("(Lyrics)", "");
-            trackTitle.replace("[Official Video]", "");
-            trackTitle.replace("[Official Music Video]", "");
-            trackTitle.replace("[Official Audio]", "");
-            trackTitle.replace("[Lyric Video]", "");
-            trackTitle.replace("[Lyrics]", "");
-            
-            // Trim whitespace
-            trackTitle.trim();
-            
-            Serial.print("Clean Track Title: ");
-            Serial.println(trackTitle);
+            LOG_I("Clean Track Title: %s", player.state().title);
             break;
             
         case ESP_AVRC_MD_ATTR_ARTIST:
-            artist = metadata;
-            
-            // Clean up artist name - remove "VEVO", "Records", etc.
-            artist.replace("VEVO", "");
-            artist.replace("Records", "");
-            artist.replace("Music", "");
-            artist.replace(" - Topic", "");
-            artist.trim();
-            
-            Serial.print("Clean Artist: ");
-            Serial.println(artist);
+            LOG_I("Clean Artist: %s", player.state().artist);
             break;
             
         case ESP_AVRC_MD_ATTR_ALBUM:
-            Serial.print("Album: ");
-            Serial.println(metadata);
+            LOG_I("Album: %.*s", (int)length, metadata);
             break;
         case ESP_AVRC_MD_ATTR_TRACK_NUM:
-            Serial.print("Track Number: ");
-            Serial.println(metadata);
+            LOG_I("Track Number: %.*s", (int)length, metadata);
             break;
         case ESP_AVRC_MD_ATTR_NUM_TRACKS:
-            Serial.print("Total Tracks: ");
-            Serial.println(metadata);
+            LOG_I("Total Tracks: %.*s", (int)length, metadata);
             break;
         case ESP_AVRC_MD_ATTR_GENRE:
-            Serial.print("Genre: ");
-            Serial.println(metadata);
+            LOG_I("Genre: %.*s", (int)length, metadata);
             break;
         case ESP_AVRC_MD_ATTR_PLAYING_TIME:
-            Serial.print("Playing Time: ");
-            Serial.println(metadata);
+            LOG_I("Playing Time: %.*s", (int)length, metadata);
             break;
         default:
-            Serial.print("Unknown metadata (ID ");
-            Serial.print(id);
-            Serial.print("): ");
-            Serial.println(metadata);
+            LOG_I("Unknown metadata (ID %u): %.*s", id, (int)length, metadata);
             break;
     }
     
@@ -0,0 +1,70 @@
+// Host check for the I2S clock plan (include/AudioClock.h).
+//
+// For every supported sample rate: the APLL coefficients are in range, the
+// VCO stays between 350 and 500 MHz, MCLK is a whole multiple of the bit
+// clock, and the achieved rate is within 1 ppm (within half a multiplier
+// step of the best possible). The table also lists the rate error of the
+// default PLL_D2 divider and of the APLL on revision 0 chips (integer
+// multiplier only). Printed with the expected range; failures give exit
+// status 1.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/bench/bench_clock.cpp src/AudioClock.cpp -o bench_clock
+//   ./bench_clock
+
+#include <stdio.h>
+#include <math.h>
+#include "AudioClock.h"
+
+// A2DP SBC rates plus the double rates the chain supports
+static const uint32_t RATES[] = { 16000, 22050, 24000, 32000, 44100, 48000, 88200, 96000 };
+static const int BCK_PER_FRAME = 32;    // 16-bit stereo
+static int failures = 0;
+
+static void check(const char* what, double value, double lo, double hi) {
+    bool ok = value >= lo && value <= hi;
+    printf("  %-44s %9.3f   [%g, %g] %s\n", what, value, lo, hi, ok ? "ok" : "FAIL");
+    failures += !ok;
+}
+
+int main() {
+    printf("%8s %5s %4s %4s %4s %4s %14s %10s %10s %10s\n", "rate", "mclk", "odiv", "sdm2", "sdm1", "sdm0",
+           "apll Hz", "apll ppm", "rev0 ppm", "div ppm");
+    for (uint32_t rate : RATES) {
+        AudioClock clock = audioClockSelect(rate, true);
+        AudioClock rev0 = audioClockSelect(rate, true, false);
+        const ApllCoeffs& c = clock.coeffs;
+        printf("%8lu %5u %4u %4u %4u %4u %14.3f %+10.3f %+10.2f %+10.2f\n", (unsigned long)rate, clock.mclkRatio,
+               c.oDiv, c.sdm2, c.sdm1, c.sdm0, c.outputHz, clock.errorPpm, rev0.apll ? rev0.errorPpm : NAN,
+               dividerErrorPpm(rate));
+    }
+    printf("\n");
+
+    for (uint32_t rate : RATES) {
+        printf("%lu Hz\n", (unsigned long)rate);
+        AudioClock clock = audioClockSelect(rate, true);
+        const ApllCoeffs& c = clock.coeffs;
+        check("APLL selected", clock.apll, 1, 1);
+        check("oDiv", c.oDiv, 0, AUDIO_CLOCK_MAX_ODIV);
+        check("sdm2", c.sdm2, 0, AUDIO_CLOCK_MAX_SDM2);
+        // Recomputed here from the register fields, independent of the search
+        double multiplier = 4 + c.sdm2 + c.sdm1 / 256.0 + c.sdm0 / 65536.0;
+        double vco = AUDIO_CLOCK_XTAL_HZ * multiplier;
+        double mclk = vco / (2 * (c.oDiv + 2));
+        check("VCO, MHz", vco / 1e6, AUDIO_CLOCK_VCO_MIN_HZ / 1e6, AUDIO_CLOCK_VCO_MAX_HZ / 1e6);
+        check("MCLK / BCK (whole)", fmod((double)clock.mclkRatio, BCK_PER_FRAME), 0, 0);
+        double ppm = (mclk / ((double)rate * clock.mclkRatio) - 1) * 1e6;
+        check("rate error, ppm", fabs(ppm), 0, 1);
+        check("reported error matches, ppm", fabs(ppm - clock.errorPpm), 0, 1e-6);
+        double halfStep = AUDIO_CLOCK_XTAL_HZ / 65536 / (2 * (c.oDiv + 2)) / 2;
+        check("error within half a multiplier step", fabs(mclk - (double)rate * clock.mclkRatio) / halfStep, 0, 1);
+    }
+
+    printf("divider\n");
+    check("44.1 kHz from PLL_D2, |ppm| (why the APLL)", fabs(dividerErrorPpm(44100)), 1, 1e6);
+    check("48 kHz from PLL_D2, |ppm|", fabs(dividerErrorPpm(48000)), 0, 1e-6);
+    AudioClock plain = audioClockSelect(44100, false);
+    check("APLL off: divider selected", !plain.apll && plain.errorPpm == dividerErrorPpm(44100), 1, 1);
+
+    printf("\n%s\n", failures ? "checks FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,769 @@
+// Host benchmark and behaviour check for the AudioChain stages.
+//
+// Cost: every stage is enabled on its own and run over pink-ish stereo noise
+// in AUDIO_BLOCK_FRAMES blocks; ns per frame and per block are reported next
+// to the share of a 44.1 kHz stereo stream it would use on this machine. Run with
+// --cpu-factor (about 10 for an ESP32 at 240 MHz) to estimate the target load.
+//
+// Checks: stage-specific measurements on synthetic signals, printed with the
+// expected range and counted as failures (exit status 1) when outside it.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/bench/bench_dsp.cpp src/AudioPipeline.cpp src/AudioChain.cpp src/Biquad.cpp src/VirtualBass.cpp src/StereoWidth.cpp src/FirStage.cpp src/Convolver.cpp src/RealFft.cpp src/SpeakerProtection.cpp src/LoudnessMeter.cpp src/ChannelAlign.cpp src/EqPresets.cpp src/EqStage.cpp src/NoiseGate.cpp -o bench_dsp
+//   ./bench_dsp [--cpu-factor 10]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "AudioChain.h"
+#include "FirStage.h"
+#include "SpeakerFir.h"
+#include "SpeakerProtection.h"
+#include "LoudnessMeter.h"
+#include "EqStage.h"
+#include "NoiseGate.h"
+#include "ChannelAlign.h"
+#include "BoardProfile.h"
+
+static const uint32_t SAMPLE_RATE = 44100;
+static int failures = 0;
+
+static void check(const char* what, double value, double lo, double hi) {
+    bool ok = value >= lo && value <= hi;
+    printf("  %-44s %9.2f   [%g, %g] %s\n", what, value, lo, hi, ok ? "ok" : "FAIL");
+    failures += !ok;
+}
+
+// Runs only the named stage(s) (or none) over interleaved 16-bit stereo
+static void runStage(const char* name, std::vector<int16_t>& pcm, const char* also = nullptr) {
+    AudioPipeline& chain = audioChain();
+    for (int i = 0; i < chain.count(); i++) {
+        const char* stage = chain.stage(i)->name();
+        chain.stage(i)->enabled = (name != nullptr && strcmp(stage, name) == 0) ||
+                                  (also != nullptr && strcmp(stage, also) == 0);
+    }
+    chain.reset();
+    chain.process(pcm.data(), pcm.data(), pcm.size() / 2);
+}
+
+static std::vector<int16_t> tone(double hz, double dbfs, double seconds) {
+    size_t frames = (size_t)(seconds * SAMPLE_RATE);
+    std::vector<int16_t> pcm(frames * 2);
+    double amplitude = 32767 * pow(10, dbfs / 20);
+    for (size_t i = 0; i < frames; i++) {
+        pcm[2 * i] = pcm[2 * i + 1] = (int16_t)lround(amplitude * sin(2 * M_PI * hz * i / SAMPLE_RATE));
+    }
+    return pcm;
+}
+
+// Level of one frequency in the left channel over the second half, dBFS (Goertzel)
+static double levelAt(const std::vector<int16_t>& pcm, double hz) {
+    size_t frames = pcm.size() / 2, start = frames / 2, n = frames - start;
+    double k = 2 * cos(2 * M_PI * hz / SAMPLE_RATE), s1 = 0, s2 = 0;
+    for (size_t i = start; i < frames; i++) {
+        double w = 0.5 - 0.5 * cos(2 * M_PI * (i - start) / (n - 1));      // Hann
+        double s = pcm[2 * i] / 32768.0 * w + k * s1 - s2;
+        s2 = s1;
+        s1 = s;
+    }
+    double power = s1 * s1 + s2 * s2 - k * s1 * s2;
+    return 10 * log10(power / (n * n / 16.0) + 1e-30);
+}
+
+static void checkVirtualBass() {
+    printf("bass\n");
+    // 60 Hz below a 150 Hz crossover: fundamental removed, harmonics above the crossover
+    std::vector<int16_t> pcm = tone(60, -12, 1.0);
+    runStage("bass", pcm);
+    check("60 Hz fundamental after cut, dB re input", levelAt(pcm, 60) + 12, -90, -30);
+    double h2 = levelAt(pcm, 120) + 12, h3 = levelAt(pcm, 180) + 12, h4 = levelAt(pcm, 240) + 12;
+    double h5 = levelAt(pcm, 300) + 12;
+    double strongest = fmax(fmax(h3, h4), h5);
+    check("strongest harmonic 180-300 Hz, dB re input", strongest, -20, 0);
+    check("2nd harmonic re strongest 180-300 Hz, dB", h2 - strongest, -60, -1);
+
+    // Level independence: harmonic level follows the input level 1:1 (+-3 dB over 24 dB)
+    std::vector<int16_t> quiet = tone(60, -36, 1.0);
+    runStage("bass", quiet);
+    check("harmonic tracking -12 vs -36 dBFS input, dB", (levelAt(quiet, 180) + 36) - h3, -3, 3);
+
+    // After the EQ: a preset's bass shelf moves the harmonics with the fundamental
+    EqStage& eq = audioChainEq();
+    std::vector<int16_t> shelf = tone(60, -24, 1.0), plain = shelf, shaped = shelf;
+    eq.setParam("preset", 3);               // night: bass shelf down
+    runStage("eq", shelf);
+    double eqGain = levelAt(shelf, 60) + 24;
+    runStage("bass", plain);
+    runStage("eq", shaped, "bass");
+    check("night preset: harmonics less EQ gain, dB", (levelAt(shaped, 180) - levelAt(plain, 180)) - eqGain, -1.5, 1.5);
+    eq.setParam("preset", 0);
+
+    // 1 kHz is above the band: passes unchanged
+    std::vector<int16_t> mid = tone(1000, -12, 0.5);
+    runStage("bass", mid);
+    check("1 kHz gain, dB", levelAt(mid, 1000) + 12, -0.5, 0.5);
+}
+
+// Uncorrelated white noise in both channels, about -15 dBFS RMS
+static std::vector<int16_t> stereoNoise(double seconds) {
+    std::vector<int16_t> pcm((size_t)(seconds * SAMPLE_RATE) * 2);
+    uint32_t seed = 7;
+    for (int16_t& sample : pcm) {
+        seed = seed * 1664525u + 1013904223u;
+        sample = (int16_t)(((int32_t)(seed >> 16) - 32768) / 5);
+    }
+    return pcm;
+}
+
+static double energyDb(const std::vector<int16_t>& pcm) {
+    double sum = 0;
+    for (int16_t sample : pcm) {
+        sum += (double)sample * sample;
+    }
+    return 10 * log10(sum + 1e-30);
+}
+
+// Largest |L - R| sample difference
+static int maxSide(const std::vector<int16_t>& pcm) {
+    int peak = 0;
+    for (size_t i = 0; i < pcm.size(); i += 2) {
+        peak = std::max(peak, abs(pcm[i] - pcm[i + 1]));
+    }
+    return peak;
+}
+
+// Level of one frequency in the side signal (L - R) / 2, dBFS
+static double sideLevelAt(const std::vector<int16_t>& pcm, double hz) {
+    std::vector<int16_t> side(pcm.size());
+    for (size_t i = 0; i < pcm.size(); i += 2) {
+        side[i] = (int16_t)((pcm[i] - pcm[i + 1]) / 2);
+    }
+    return levelAt(side, hz);
+}
+
+static void checkStereoWidth() {
+    printf("width\n");
+    AudioStage* width = audioChain().find("width");
+    width->setParam("mono", 0);
+
+    // Width 1 without the side filter is the identity
+    std::vector<int16_t> noise = stereoNoise(0.5), pcm = noise;
+    width->setParam("width", 1);
+    runStage("width", pcm);
+    int diff = 0;
+    for (size_t i = 0; i < pcm.size(); i++) {
+        diff = std::max(diff, abs(pcm[i] - noise[i]));
+    }
+    check("width 1: largest sample change", diff, 0, 0);
+
+    // Constant power: uncorrelated material keeps its energy at any width
+    const float widths[] = { 0, 0.5f, 1.5f, 2 };
+    for (float w : widths) {
+        pcm = noise;
+        width->setParam("width", w);
+        runStage("width", pcm);
+        char label[64];
+        snprintf(label, sizeof(label), "width %.1f: energy change, dB", w);
+        check(label, energyDb(pcm) - energyDb(noise), -0.1, 0.1);
+    }
+
+    // Mono in stays mono
+    pcm = tone(440, -6, 0.2);
+    width->setParam("width", 2);
+    runStage("width", pcm);
+    check("width 2, mono input: largest |L - R|", maxSide(pcm), 0, 1);
+
+    // Side high-pass: left-only bass becomes centred, left-only mids keep their side level
+    width->setParam("width", 1);
+    width->setParam("mono", 120);
+    std::vector<int16_t> bass = tone(50, -12, 1.0), mid = tone(1000, -12, 0.5);
+    for (size_t i = 1; i < bass.size(); i += 2) bass[i] = 0;
+    for (size_t i = 1; i < mid.size(); i += 2) mid[i] = 0;
+    runStage("width", bass);
+    runStage("width", mid);
+    check("mono 120 Hz: 50 Hz side, dB re input side", sideLevelAt(bass, 50) + 18, -60, -12);
+    check("mono 120 Hz: 1 kHz side, dB re input side", sideLevelAt(mid, 1000) + 18, -0.5, 0.5);
+}
+
+static void checkFir() {
+    printf("fir\n");
+    // The flash filter corrects phase only: level unchanged across the band
+    const double freqs[] = { 100, 1000, 8000 };
+    for (double hz : freqs) {
+        std::vector<int16_t> pcm = tone(hz, -12, 1.0);
+        runStage("fir", pcm);
+        char label[64];
+        snprintf(label, sizeof(label), "%.0f Hz gain, dB", hz);
+        check(label, levelAt(pcm, hz) + 12, -0.5, 0.5);
+    }
+
+    // A click comes out after the partition plus the filter's own centre delay
+    std::vector<int16_t> click(2 * SAMPLE_RATE / 4, 0);
+    click[0] = click[1] = 16384;
+    runStage("fir", click);
+    size_t peak = 0;
+    for (size_t i = 0; i < click.size(); i += 2) {
+        if (abs(click[i]) > abs(click[peak])) peak = i;
+    }
+    check("click delay, frames", peak / 2, FIR_PARTITION + SPEAKER_FIR_TAPS / 2, FIR_PARTITION + SPEAKER_FIR_TAPS / 2);
+}
+
+// Peak cone excursion of the left channel over the second half, mm, from the board's closed-box model
+static double peakExcursion(const std::vector<int16_t>& pcm) {
+    Biquad model;
+    model.c = biquadLowPass(SAMPLE_RATE, Board::speakerResonanceHz, Board::speakerQtc);
+    double peak = 0;
+    for (size_t i = 0; i < pcm.size(); i += 2) {
+        double x = model.process(pcm[i] / 32768.0f);
+        if (i >= pcm.size() / 2) peak = fmax(peak, fabs(x));
+    }
+    return peak * Board::ampPeakVolts * Board::speakerMmPerVolt;
+}
+
+static void checkProtection() {
+    printf("protect\n");
+    SpeakerProtection* protect = (SpeakerProtection*)audioChain().find("protect");
+    const double xmax = Board::speakerXmaxMm;
+
+    // Full-scale bass at and below resonance: stays within Xmax
+    const double stress[] = { 40, 80, Board::speakerResonanceHz };
+    for (double hz : stress) {
+        std::vector<int16_t> pcm = tone(hz, 0, 2.0);
+        double before = peakExcursion(pcm);
+        runStage("protect", pcm);
+        char label[64];
+        snprintf(label, sizeof(label), "%.0f Hz 0 dBFS excursion, mm (%.2f unprotected)", hz, before);
+        check(label, peakExcursion(pcm), 0, xmax);
+    }
+
+    // Below the margin nothing changes
+    std::vector<int16_t> bass = tone(50, -8, 1.0), mid = tone(1000, -6, 1.0);
+    runStage("protect", bass);
+    runStage("protect", mid);
+    check("50 Hz -8 dBFS gain, dB", levelAt(bass, 50) + 8, -0.1, 0.1);
+    check("1 kHz -6 dBFS gain, dB", levelAt(mid, 1000) + 6, -0.1, 0.1);
+
+    // A minute of full-scale 1 kHz heats the coil past the margin: held below the allowed rise
+    std::vector<int16_t> hot = tone(1000, 0, 60.0);
+    runStage("protect", hot);
+    check("coil rise after 60 s full scale, K", protect->coilRiseK(), 0, Board::speakerMaxRiseK);
+    check("thermal gain after 60 s full scale, dB", protect->gainDb(), -6, -0.5);
+
+    // ... and recovers once the music gets quieter
+    std::vector<int16_t> quiet(2 * SAMPLE_RATE * 30, 0);
+    audioChain().process(quiet.data(), quiet.data(), quiet.size() / 2);
+    check("gain after 30 s of silence, dB", protect->gainDb(), -0.1, 0);
+}
+
+// Stereo 1 kHz sine segments (dBFS, seconds) as in EBU Tech 3341
+static std::vector<int16_t> segments(std::initializer_list<std::pair<double, double>> parts) {
+    std::vector<int16_t> pcm;
+    for (const auto& part : parts) {
+        std::vector<int16_t> t = tone(1000, part.first, part.second);
+        pcm.insert(pcm.end(), t.begin(), t.end());
+    }
+    return pcm;
+}
+
+static void checkLoudness() {
+    printf("loudness\n");
+    LoudnessMeter* meter = (LoudnessMeter*)audioChain().find("loudness");
+    meter->setParam("agc", 0);
+
+    // EBU Tech 3341 cases 1-5: integrated -23.0 +-0.1 LUFS; momentary and short-term of steady tones
+    std::vector<int16_t> pcm = segments({ { -23, 20 } });
+    runStage("loudness", pcm);
+    check("3341-1 -23 dBFS: momentary, LUFS", meter->momentary(), -23.1, -22.9);
+    check("3341-1 -23 dBFS: short-term, LUFS", meter->shortTerm(), -23.1, -22.9);
+    check("3341-1 -23 dBFS: integrated, LUFS", meter->integrated(), -23.1, -22.9);
+    pcm = segments({ { -33, 20 } });
+    runStage("loudness", pcm);
+    check("3341-2 -33 dBFS: integrated, LUFS", meter->integrated(), -33.1, -32.9);
+    pcm = segments({ { -36, 10 }, { -23, 60 }, { -36, 10 } });
+    runStage("loudness", pcm);
+    check("3341-3 relative gate: integrated, LUFS", meter->integrated(), -23.1, -22.9);
+    pcm = segments({ { -72, 10 }, { -36, 10 }, { -23, 60 }, { -36, 10 }, { -72, 10 } });
+    runStage("loudness", pcm);
+    check("3341-4 absolute gate: integrated, LUFS", meter->integrated(), -23.1, -22.9);
+    pcm = segments({ { -26, 20 }, { -20, 20.1 }, { -26, 20 } });
+    runStage("loudness", pcm);
+    check("3341-5 -26/-20/-26 dBFS: integrated, LUFS", meter->integrated(), -23.1, -22.9);
+
+    // Meter only: the samples pass untouched
+    pcm = tone(1000, -12, 0.5);
+    std::vector<int16_t> original = pcm;
+    runStage("loudness", pcm);
+    check("meter only: samples changed", pcm != original, 0, 0);
+
+    // AGC: a quiet and a loud source both end up near the target, without clipping
+    meter->setParam("agc", 1);
+    meter->setParam("target", -16);
+    uint32_t clipped = audioChain().clippedSamples();
+    const double sources[] = { -26, -8 };
+    for (double dbfs : sources) {
+        pcm = segments({ { dbfs, 60 } });
+        runStage("loudness", pcm);
+        // Loudness of the output over the last 10 s, through a fresh meter
+        LoudnessMeter out;
+        out.begin(SAMPLE_RATE);
+        std::vector<float> l(AUDIO_BLOCK_FRAMES), r(AUDIO_BLOCK_FRAMES);
+        size_t frames = pcm.size() / 2, start = frames - 10 * SAMPLE_RATE;
+        for (size_t i = start; i + AUDIO_BLOCK_FRAMES <= frames; i += AUDIO_BLOCK_FRAMES) {
+            for (size_t j = 0; j < AUDIO_BLOCK_FRAMES; j++) {
+                l[j] = pcm[2 * (i + j)] / 32768.0f;
+                r[j] = pcm[2 * (i + j) + 1] / 32768.0f;
+            }
+            out.process(l.data(), r.data(), AUDIO_BLOCK_FRAMES);
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "agc %.0f LUFS source after 60 s, LUFS", dbfs);
+        check(label, out.integrated(), -17, -15);
+    }
+    check("agc: clipped samples", audioChain().clippedSamples() - clipped, 0, 0);
+    meter->setParam("agc", 0);
+}
+
+// Error of the left channel's delay behind the right at one frequency against
+// the expected delay, samples (phase difference of the DFT bins over the second half)
+static double delayError(const std::vector<int16_t>& pcm, double hz, double expected) {
+    size_t frames = pcm.size() / 2, start = frames / 2;
+    double w = 2 * M_PI * hz / SAMPLE_RATE, lr = 0, li = 0, rr = 0, ri = 0;
+    for (size_t i = start; i < frames; i++) {
+        lr += pcm[2 * i] * cos(w * i);
+        li -= pcm[2 * i] * sin(w * i);
+        rr += pcm[2 * i + 1] * cos(w * i);
+        ri -= pcm[2 * i + 1] * sin(w * i);
+    }
+    double phase = atan2(ri, rr) - atan2(li, lr) - w * expected;
+    phase -= 2 * M_PI * floor(phase / (2 * M_PI) + 0.5);
+    return phase / w;
+}
+
+// Largest second difference of the left channel, a click detector for smooth signals
+static double largestStep(const std::vector<int16_t>& pcm, size_t from, size_t to) {
+    double worst = 0;
+    for (size_t i = from + 2; i < to; i++) {
+        worst = fmax(worst, fabs(pcm[2 * i] - 2.0 * pcm[2 * i - 2] + pcm[2 * i - 4]));
+    }
+    return worst;
+}
+
+static void checkAlign() {
+    printf("align\n");
+    AudioStage* align = audioChain().find("align");
+    auto set = [align](float ltrim, float rinvert, float ldelay) {
+        align->setParam("ltrim", ltrim);
+        align->setParam("rtrim", 0);
+        align->setParam("linvert", 0);
+        align->setParam("rinvert", rinvert);
+        align->setParam("ldelay", ldelay);
+        align->setParam("rdelay", 0);
+    };
+
+    // Fractional delays: phase delay up to 4 kHz against the setting; the allpass
+    // is exact at low frequencies and drifts slowly above
+    const double delaysMs[] = { 0.01, 0.1, 0.25, 1.0 };
+    const double freqs[] = { 100, 1000, 4000 };
+    for (double ms : delaysMs) {
+        set(0, 0, (float)ms);
+        double expected = ms * SAMPLE_RATE / 1000, worst = 0;
+        for (double hz : freqs) {
+            std::vector<int16_t> pcm = tone(hz, -6, 0.5);
+            runStage("align", pcm);
+            worst = fmax(worst, fabs(delayError(pcm, hz, expected)));
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "%.2f ms (%.2f samples): error to 4 kHz, samples", ms, expected);
+        check(label, worst, 0, 0.05);      // about 1 us, 0.4 mm of path
+    }
+    std::vector<int16_t> pcm = tone(10000, -6, 0.5);
+    runStage("align", pcm);
+    check("1.00 ms: error at 10 kHz, samples", fabs(delayError(pcm, 10000, SAMPLE_RATE / 1000.0)), 0, 0.2);
+
+    // Trim and polarity
+    set(-6, 1, 0);
+    pcm = tone(1000, -6, 0.5);
+    runStage("align", pcm);
+    check("ltrim -6: 1 kHz gain, dB", levelAt(pcm, 1000) + 6, -6.05, -5.95);
+    set(0, 1, 0);
+    pcm = tone(1000, -6, 0.5);
+    runStage("align", pcm);
+    int worst = 0;
+    for (size_t i = pcm.size() / 2; i < pcm.size(); i += 2) {
+        worst = std::max(worst, abs(pcm[i] + pcm[i + 1]));
+    }
+    check("rinvert: largest |L + R|", worst, 0, 1);
+
+    // Changes while playing ramp or crossfade: the output may bend a little
+    // more than the tone itself, a click would be about 100 times as much
+    pcm = tone(1000, -6, 0.5);
+    size_t frames = pcm.size() / 2, change = frames / 4;
+    double steady = largestStep(pcm, 0, frames);
+    std::vector<int16_t> none;
+    set(0, 0, 0);
+    runStage("align", none);
+    audioChain().process(pcm.data(), pcm.data(), change);
+    set(0, 0, 0.37f);
+    audioChain().process(pcm.data() + 2 * change, pcm.data() + 2 * change, frames - change);
+    check("delay 0 -> 0.37 ms while playing: step re input", largestStep(pcm, 0, frames) / steady, 0, 1.5);
+    pcm = tone(1000, -6, 0.5);
+    set(0, 0, 0);
+    runStage("align", none);
+    audioChain().process(pcm.data(), pcm.data(), change);
+    align->setParam("linvert", 1);
+    audioChain().process(pcm.data() + 2 * change, pcm.data() + 2 * change, frames - change);
+    check("polarity flip while playing: step re input", largestStep(pcm, 0, frames) / steady, 0, 1.5);
+
+    // A second change in the middle of a crossfade (posted, as "dsp" does)
+    pcm = tone(1000, -6, 0.5);
+    set(0, 0, 0);
+    runStage("align", none);
+    audioChain().process(pcm.data(), pcm.data(), change);
+    audioChain().postParam(*align, "ldelay", 0.37f);
+    audioChain().process(pcm.data() + 2 * change, pcm.data() + 2 * change, ALIGN_FADE_FRAMES / 2);
+    audioChain().postParam(*align, "ldelay", 0.9f);
+    audioChain().postParam(*align, "ltrim", -3);
+    size_t rest = change + ALIGN_FADE_FRAMES / 2;
+    audioChain().process(pcm.data() + 2 * rest, pcm.data() + 2 * rest, frames - rest);
+    check("delay change during a crossfade: step re input", largestStep(pcm, 0, frames) / steady, 0, 1.5);
+    check("then settles on the last setting: error, samples", fabs(delayError(pcm, 1000, 0.9 * SAMPLE_RATE / 1000)),
+          0, 0.05);
+    set(0, 0, 0);
+}
+
+// Magnitude of a preset's designed response at one frequency, dB
+static double presetResponseDb(const EqPreset& preset, double hz) {
+    double w = 2 * M_PI * hz / SAMPLE_RATE, db = 0;
+    for (const EqBand& band : preset.bands) {
+        BiquadCoeffs c = eqBandCoeffs(band, SAMPLE_RATE);
+        double nr = c.b0 + c.b1 * cos(w) + c.b2 * cos(2 * w), ni = -c.b1 * sin(w) - c.b2 * sin(2 * w);
+        double dr = 1 + c.a1 * cos(w) + c.a2 * cos(2 * w), di = -c.a1 * sin(w) - c.a2 * sin(2 * w);
+        db += 10 * log10((nr * nr + ni * ni) / (dr * dr + di * di));
+    }
+    return db;
+}
+
+static void checkEq() {
+    printf("eq\n");
+    EqStage& eq = audioChainEq();
+    const int flat = 0, bassBoost = 1, night = 3;
+
+    // Flat is the identity
+    std::vector<int16_t> noise = stereoNoise(0.5), pcm = noise;
+    eq.setParam("preset", flat);
+    runStage("eq", pcm);
+    int diff = 0;
+    for (size_t i = 0; i < pcm.size(); i++) {
+        diff = std::max(diff, abs(pcm[i] - noise[i]));
+    }
+    check("flat: largest difference to input, LSB", diff, 0, 0);
+
+    // Bass boost follows its design
+    eq.setParam("preset", bassBoost);
+    const double freqs[] = { 50, 150, 1000, 10000 };
+    double worst = 0;
+    for (double hz : freqs) {
+        pcm = tone(hz, -20, 0.5);
+        runStage("eq", pcm);
+        worst = fmax(worst, fabs(levelAt(pcm, hz) + 20 - presetResponseDb(eq.presets().at(bassBoost), hz)));
+    }
+    check("bass boost: gain error 50 Hz-10 kHz, dB", worst, 0, 0.05);
+    check("bass boost: designed gain at 50 Hz, dB", presetResponseDb(eq.presets().at(bassBoost), 50), 5, 6.5);
+
+    // Serial text and NVS blob round trips
+    int mismatches = 0;
+    EqPresetBank bank;
+    for (int i = 0; i < EQ_BUILTIN_PRESETS; i++) {
+        char text[EQ_TEXT_LENGTH];
+        EqPreset parsed;
+        eqPresetFormat(bank.at(i), text, sizeof(text));
+        mismatches += !eqPresetParse(text, parsed) || memcmp(&parsed, &bank.at(i), sizeof(parsed)) != 0;
+        bank.setUser(EQ_BUILTIN_PRESETS + i % EQ_USER_SLOTS, parsed);
+    }
+    EqPreset parsed;
+    mismatches += eqPresetParse("0148 Short", parsed) + eqPresetParse("zz441003 Bad hex", parsed);
+    uint8_t blob[EqPresetBank::blobSize()];
+    EqPresetBank loaded;
+    mismatches += !loaded.deserialize(blob, bank.serialize(blob, sizeof(blob)));
+    for (int i = EQ_BUILTIN_PRESETS; i < EQ_PRESET_COUNT; i++) {
+        mismatches += memcmp(&loaded.at(i), &bank.at(i), sizeof(EqPreset)) != 0;
+    }
+    blob[0]++;
+    mismatches += loaded.deserialize(blob, sizeof(blob));
+    check("text and blob round trips: mismatches", mismatches, 0, 0);
+
+    // Switching while playing: the crossfade bends the tone no more than the
+    // presets do themselves, and the result matches the new preset run from the start
+    const double hz = 200;
+    std::vector<int16_t> before = tone(hz, -12, 1.0), after = before, none;
+    size_t frames = before.size() / 2, change = frames / 4;
+    eq.setParam("preset", night);
+    runStage("eq", before);
+    eq.setParam("preset", bassBoost);
+    runStage("eq", after);
+    double steady = fmax(largestStep(before, 0, frames), largestStep(after, 0, frames));
+    pcm = tone(hz, -12, 1.0);
+    eq.setParam("preset", night);
+    runStage("eq", none);
+    audioChain().process(pcm.data(), pcm.data(), change);
+    // As the firmware does it from the loop task: picked up at the next block
+    audioChain().postParam(eq, "preset", bassBoost);
+    check("posted request: selected at once", eq.preset(), bassBoost, bassBoost);
+    check("posted request: switch waits for next block", eq.switching(), 0, 0);
+    audioChain().process(pcm.data() + 2 * change, pcm.data() + 2 * change, frames - change);
+    check("switch night -> bass boost: step re presets", largestStep(pcm, 0, frames) / steady, 0, 1.05);
+    diff = 0;
+    for (size_t i = 2 * (change + EQ_WARMUP_FRAMES + EQ_FADE_FRAMES); i < pcm.size(); i++) {
+        diff = std::max(diff, abs(pcm[i] - after[i]));
+    }
+    check("after the switch: diff to bass boost, LSB", diff, 0, 1);
+
+    // For comparison, new coefficients in the running filters: the check above would catch this
+    std::vector<int16_t> swapped = tone(hz, -12, 1.0);
+    Biquad filters[EQ_BANDS];
+    for (size_t i = 0; i < frames; i++) {
+        const EqPreset& preset = eq.presets().at(i < change ? night : bassBoost);
+        float x = swapped[2 * i] / 32768.0f;
+        for (int b = 0; b < EQ_BANDS; b++) {
+            filters[b].c = eqBandCoeffs(preset.bands[b], SAMPLE_RATE);
+            x = filters[b].process(x);
+        }
+        swapped[2 * i] = (int16_t)lrintf(fmaxf(-32768, fminf(32767, x * 32768)));
+    }
+    check("plain coefficient swap: step re presets", largestStep(swapped, 0, frames) / steady, 5, 1e6);
+
+    // A request during a switch is queued and applied after it
+    runStage("eq", none);
+    eq.setParam("preset", night);
+    eq.setParam("preset", 2);
+    pcm = tone(hz, -12, 0.5);
+    audioChain().process(pcm.data(), pcm.data(), pcm.size() / 2);
+    check("two requests in a row: preset at the end", eq.preset() + 10 * eq.switching(), 2, 2);
+    eq.setParam("preset", flat);
+    runStage("eq", none);
+}
+
+// Runs the gate alone in stage blocks over a float signal fed to both
+// channels; returns the output and counts open/closed changes
+static std::vector<float> runGate(NoiseGate& gate, const std::vector<float>& x, int* changes = nullptr) {
+    std::vector<float> left = x, right = x;
+    bool wasOpen = false;
+    int count = 0;
+    gate.reset();
+    for (size_t pos = 0; pos < x.size(); pos += AUDIO_BLOCK_FRAMES) {
+        size_t n = std::min<size_t>(AUDIO_BLOCK_FRAMES, x.size() - pos);
+        gate.process(left.data() + pos, right.data() + pos, n);
+        count += gate.isOpen() != wasOpen;
+        wasOpen = gate.isOpen();
+    }
+    if (changes != nullptr) {
+        *changes = count;
+    }
+    return left;
+}
+
+// Tone in dBFS segments of (seconds, level); levels below -200 are silence
+static std::vector<float> toneSegments(double hz, std::initializer_list<std::pair<double, double>> parts) {
+    std::vector<float> x;
+    for (const auto& part : parts) {
+        double amplitude = part.second < -200 ? 0 : pow(10, part.second / 20);
+        for (size_t i = 0, n = (size_t)(part.first * SAMPLE_RATE); i < n; i++) {
+            size_t t = x.size();
+            x.push_back((float)(amplitude * sin(2 * M_PI * hz * t / SAMPLE_RATE)));
+        }
+    }
+    return x;
+}
+
+// Gain (output / input) at sample i, dB; taken at the peaks of the input to stay accurate
+static double gainAt(const std::vector<float>& in, const std::vector<float>& out, size_t i) {
+    while (i + 1 < in.size() && fabsf(in[i]) < fabsf(in[i + 1])) {
+        i++;
+    }
+    return 20 * log10(fabs(out[i] / in[i]) + 1e-30);
+}
+
+// Seconds from sample `from` until the gain first crosses `db` (upward if rising)
+static double timeToGain(const std::vector<float>& in, const std::vector<float>& out, size_t from, double db,
+                         bool rising) {
+    for (size_t i = from; i < in.size(); i += SAMPLE_RATE / 2000) {
+        double g = gainAt(in, out, i);
+        if (rising ? g >= db : g <= db) {
+            return (double)(i - from) / SAMPLE_RATE;
+        }
+    }
+    return 1e9;
+}
+
+static void checkGate() {
+    printf("gate\n");
+    NoiseGate& gate = *static_cast<NoiseGate*>(audioChain().find("gate"));
+
+    // Attack: a note after silence is at full level within a few ms
+    std::vector<float> x = toneSegments(1000, { { 0.5, -300 }, { 0.5, -40 } });
+    std::vector<float> y = runGate(gate, x);
+    size_t onset = SAMPLE_RATE / 2;
+    check("note after silence: time to -1 dB, ms", 1000 * timeToGain(x, y, onset, -1, true), 0, 5);
+    check("note after silence: gain after 10 ms, dB", gainAt(x, y, onset + SAMPLE_RATE / 100), -0.1, 0);
+
+    // Release: down to the expansion gain after the detector decay (about 0.2 s
+    // from -40 dBFS), the hold (0.3 s) and the release (about 0.5 s to -10 dB)
+    x = toneSegments(1000, { { 1, -40 }, { 3, -82 } });
+    y = runGate(gate, x);
+    size_t drop = SAMPLE_RATE;
+    check("stays open through the hold: gain 250 ms on, dB", gainAt(x, y, drop + SAMPLE_RATE / 4), -0.1, 0);
+    check("-40 -> -82 dBFS: time to -10 dB, s", timeToGain(x, y, drop, -10, false), 0.8, 1.2);
+    check("-82 dBFS: settled gain, dB (1:2 below -70)", gainAt(x, y, x.size() - SAMPLE_RATE / 10), -12.5, -11.5);
+
+    // Hysteresis: a level wobbling +-3 dB around the threshold opens the gate once
+    x.resize(3 * SAMPLE_RATE);
+    for (size_t i = 0; i < x.size(); i++) {
+        double db = -70 + 3 * sin(2 * M_PI * 3 * i / SAMPLE_RATE);
+        x[i] = (float)(pow(10, db / 20) * sin(2 * M_PI * 1000.0 * i / SAMPLE_RATE));
+    }
+    int changes = 0;
+    runGate(gate, x, &changes);
+    check("level -70 +-3 dB at 3 Hz: state changes", changes, 1, 1);
+    gate.setParam("hyst", 0);
+    gate.setParam("hold", 0);
+    runGate(gate, x, &changes);
+    check("same without hysteresis and hold: changes", changes, 10, 1e6);
+    gate.setParam("hyst", 6);
+    gate.setParam("hold", 300);
+
+    // No pumping on quiet music: decaying piano-like notes peaking near -56 dBFS
+    // whose tails fall below the close level for a moment before the next one
+    x.assign(8 * SAMPLE_RATE, 0);
+    uint32_t seed = 3;
+    for (size_t start = 0; start < x.size(); start += (size_t)(SAMPLE_RATE * 0.6)) {
+        seed = seed * 1664525u + 1013904223u;
+        double hz = 200 + (seed >> 16) % 800;
+        for (size_t i = 0; start + i < x.size(); i++) {
+            double t = (double)i / SAMPLE_RATE, decay = pow(10, -60 / 20.0) * exp(-t / 0.2);
+            for (int partial = 1; partial <= 3; partial++) {
+                x[start + i] += (float)(decay / partial * sin(2 * M_PI * hz * partial * t));
+            }
+        }
+    }
+    y = runGate(gate, x, &changes);
+    double lowest = 0;
+    for (size_t i = SAMPLE_RATE / 10; i < x.size(); i++) {
+        if (fabsf(x[i]) > 1e-6f) {
+            lowest = fmin(lowest, 20 * log10(fabs(y[i] / x[i])));
+        }
+    }
+    check("quiet decaying notes: lowest gain, dB", lowest, -0.1, 0);
+    check("quiet decaying notes: state changes", changes, 1, 1);
+}
+
+// Stage that writes fixed values, to drive the output conversion out of range
+class ConstantStage : public AudioStage {
+public:
+    float value[4];
+    const char* name() const override { return "constant"; }
+    void process(float* left, float* right, size_t frames) override {
+        for (size_t i = 0; i < frames; i++) {
+            left[i] = value[(2 * i) % 4];
+            right[i] = value[(2 * i + 1) % 4];
+        }
+    }
+};
+
+static void checkSaturate() {
+    printf("output conversion\n");
+    ConstantStage stage;
+    stage.value[0] = 1e6f;
+    stage.value[1] = -1e6f;
+    stage.value[2] = NAN;
+    stage.value[3] = 0.5f;
+    AudioPipeline pipeline;
+    pipeline.add(stage);
+    pipeline.begin(SAMPLE_RATE);
+    int16_t pcm[2 * 4] = {};
+    pipeline.process(pcm, pcm, 4);
+    check("far above full scale", pcm[0], 32767, 32767);
+    check("far below full scale", pcm[1], -32768, -32768);
+    check("NaN", pcm[2], 0, 0);
+    check("in range", pcm[3], 16384, 16384);
+    check("clipped samples (NaN included)", pipeline.clippedSamples(), 6, 6);
+}
+
+int main(int argc, char** argv) {
+    double cpuFactor = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--cpu-factor") && i + 1 < argc) cpuFactor = atof(argv[++i]);
+    }
+    audioChainBegin(SAMPLE_RATE);
+    AudioPipeline& chain = audioChain();
+
+    // Two seconds of noise with a -6 dB/octave tilt, about -20 dBFS
+    const size_t frames = 2 * SAMPLE_RATE;
+    std::vector<int16_t> source(frames * 2);
+    uint32_t seed = 1;
+    double lp[2] = { 0, 0 };
+    for (size_t i = 0; i < frames * 2; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        double white = (seed >> 8) / 16777216.0 - 0.5;
+        lp[i & 1] = 0.98 * lp[i & 1] + 0.1 * white;
+        source[i] = (int16_t)lround((lp[i & 1] + 0.2 * white) * 16000);
+    }
+
+    // align is bypassed at its neutral defaults; time it with a fractional delay and a trim.
+    // eq costs nothing when flat; time the 3-band night preset
+    chain.find("eq")->setParam("preset", 3);
+    chain.find("align")->setParam("ldelay", 0.3f);
+    chain.find("align")->setParam("rtrim", -1);
+    printf("%-12s %10s %10s %10s\n", "stage", "ns/frame", "us/block", "stream %");
+    double budgetNs = 1e9 / SAMPLE_RATE;
+    for (int s = -1; s < chain.count(); s++) {
+        const char* name = s < 0 ? nullptr : chain.stage(s)->name();
+        double best = 1e30;
+        for (int run = 0; run < 5; run++) {
+            std::vector<int16_t> pcm = source;
+            auto t0 = std::chrono::steady_clock::now();
+            runStage(name, pcm);
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+            best = ns < best ? ns : best;
+        }
+        double perFrame = best / frames * cpuFactor;
+        printf("%-12s %10.2f %10.2f %9.3f%%\n", name ? name : "(bypass)", perFrame,
+               perFrame * AUDIO_BLOCK_FRAMES / 1000, 100 * perFrame / budgetNs);
+    }
+    // eq while switching presets back and forth: both banks run and crossfade
+    {
+        EqStage& eq = audioChainEq();
+        std::vector<int16_t> pcm = source;
+        runStage("eq", pcm);
+        pcm = source;
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t pos = 0; pos < frames; pos += AUDIO_BLOCK_FRAMES) {
+            if (!eq.switching()) {
+                eq.setParam("preset", eq.preset() == 3 ? 1 : 3);
+            }
+            size_t n = std::min<size_t>(AUDIO_BLOCK_FRAMES, frames - pos);
+            chain.process(pcm.data() + 2 * pos, pcm.data() + 2 * pos, n);
+        }
+        double perFrame = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() /
+                          frames * cpuFactor;
+        printf("%-12s %10.2f %10.2f %9.3f%%\n", "eq (switch)", perFrame, perFrame * AUDIO_BLOCK_FRAMES / 1000,
+               100 * perFrame / budgetNs);
+        eq.setParam("preset", 0);
+    }
+    printf("\n");
+
+    checkVirtualBass();
+    checkStereoWidth();
+    checkFir();
+    checkLoudness();
+    checkAlign();
+    checkEq();
+    checkProtection();
+    checkGate();
+    checkSaturate();
+
+    printf("\n%s\n", failures ? "checks FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+// Host benchmark and correctness check for the partitioned convolver.
+//
+// Correctness: random impulse responses (including lengths that are not a
+// multiple of the partition) are run through PartitionedConvolver in blocks
+// and compared against direct convolution in double precision; the worst
+// error relative to the output peak must stay below -100 dB.
+//
+// Cost: stereo ns per frame, share of a 44.1 kHz stream, memory and latency
+// for every partition size and a range of filter lengths. Run with
+// --cpu-factor (about 10 for an ESP32 at 240 MHz) to estimate the target load.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/bench/bench_fir.cpp src/Convolver.cpp src/RealFft.cpp -o bench_fir
+//   ./bench_fir [--cpu-factor 10]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "Convolver.h"
+
+static const uint32_t SAMPLE_RATE = 44100;
+static const size_t PARTITIONS[] = { 32, 64, 128, 256, 512 };
+static const size_t TAPS[] = { 512, 1024, 2048, 4096 };
+
+static std::vector<float> noise(size_t count, uint32_t seed) {
+    std::vector<float> v(count);
+    for (float& x : v) {
+        seed = seed * 1664525u + 1013904223u;
+        x = (seed >> 8) / 16777216.0f - 0.5f;
+    }
+    return v;
+}
+
+// Worst error against direct convolution relative to the output peak, dB
+static double convolutionError(size_t partition, size_t taps) {
+    std::vector<float> ir = noise(taps, 11 + (uint32_t)taps);
+    for (size_t i = 0; i < taps; i++) {
+        ir[i] *= expf(-4.0f * i / taps);        // decaying like a room or speaker response
+    }
+    const size_t length = 16 * partition + 3 * taps;
+    std::vector<float> in = noise(length - length % partition, 5), out(in.size());
+
+    PartitionedConvolver convolver;
+    if (!convolver.begin(ir.data(), taps, partition, 1)) {
+        return 0;
+    }
+    for (size_t pos = 0; pos < in.size(); pos += partition) {
+        convolver.process(0, in.data() + pos, out.data() + pos);
+    }
+
+    double worst = 0, peak = 0;
+    for (size_t n = 0; n < in.size(); n++) {
+        double y = 0;
+        for (size_t k = 0; k < taps && k <= n; k++) {
+            y += (double)ir[k] * in[n - k];
+        }
+        worst = fmax(worst, fabs(y - out[n]));
+        peak = fmax(peak, fabs(y));
+    }
+    return 20 * log10(worst / peak + 1e-30);
+}
+
+int main(int argc, char** argv) {
+    double cpuFactor = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--cpu-factor") && i + 1 < argc) cpuFactor = atof(argv[++i]);
+    }
+    int failures = 0;
+
+    printf("correctness against direct convolution (limit -100 dB re peak)\n");
+    const size_t lengths[] = { 1, 100, 1000, 1536 };
+    for (size_t partition : PARTITIONS) {
+        printf("  partition %4zu:", partition);
+        for (size_t taps : lengths) {
+            double error = convolutionError(partition, taps);
+            bool ok = error < -100;
+            printf("  %4zu taps %7.1f dB%s", taps, error, ok ? "" : " FAIL");
+            failures += !ok;
+        }
+        printf("\n");
+    }
+
+    printf("\n%-9s %6s %10s %10s %9s %10s\n", "partition", "taps", "ns/frame", "stream %", "KB", "latency ms");
+    const size_t frames = 2 * SAMPLE_RATE;
+    std::vector<float> left = noise(frames, 1), right = noise(frames, 2);
+    std::vector<float> ir = noise(TAPS[sizeof(TAPS) / sizeof(TAPS[0]) - 1], 3);
+    double budgetNs = 1e9 / SAMPLE_RATE;
+    for (size_t partition : PARTITIONS) {
+        for (size_t taps : TAPS) {
+            PartitionedConvolver convolver;
+            if (!convolver.begin(ir.data(), taps, partition, 2)) {
+                printf("%-9zu %6zu  allocation failed\n", partition, taps);
+                continue;
+            }
+            std::vector<float> out(partition);
+            double best = 1e30;
+            for (int run = 0; run < 3; run++) {
+                convolver.reset();
+                auto t0 = std::chrono::steady_clock::now();
+                for (size_t pos = 0; pos + partition <= frames; pos += partition) {
+                    convolver.process(0, left.data() + pos, out.data());
+                    convolver.process(1, right.data() + pos, out.data());
+                }
+                double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+                best = ns < best ? ns : best;
+            }
+            double perFrame = best / frames * cpuFactor;
+            printf("%-9zu %6zu %10.2f %9.2f%% %9.1f %10.2f\n", partition, taps, perFrame, 100 * perFrame / budgetNs,
+                   convolver.memoryBytes() / 1024.0, 1000.0 * partition / SAMPLE_RATE);
+        }
+    }
+
+    printf("\n%s\n", failures ? "checks FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
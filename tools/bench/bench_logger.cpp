@@ -0,0 +1,70 @@
+// Host micro-benchmark for the log ring used by LOG_x().
+// Measures the cost of one log call as seen by a hot-path caller, both for
+// accepted messages and for calls dropped because the ring is full. Pop cost
+// is included in the first two numbers but is paid by the drain task on target.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/bench/bench_logger.cpp -o bench_logger && ./bench_logger
+
+#include <chrono>
+#include <stdio.h>
+#include "Logger.h"
+#include "LogRing.h"
+
+typedef LogRing<LOG_RING_SLOTS, LOG_RECORD_TEXT> Ring;
+
+static bool logTo(Ring& ring, uint8_t level, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    bool ok = ring.push(level, 0, fmt, args);
+    va_end(args);
+    return ok;
+}
+
+static double nsPerCall(std::chrono::steady_clock::duration d, long calls) {
+    return std::chrono::duration<double, std::nano>(d).count() / calls;
+}
+
+int main() {
+    const long iterations = 2000000;
+    static Ring ring;
+    Ring::Record record;
+
+    // Accepted calls; the ring is drained inline every half ring so it never fills
+    long accepted = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) {
+        if (logTo(ring, LOG_LEVEL_INFO, "Volume: %d%%", (int)(i & 127))) {
+            accepted++;
+        }
+        if ((i & (LOG_RING_SLOTS / 2 - 1)) == 0) {
+            while (ring.pop(record)) {}
+        }
+    }
+    auto formatted = std::chrono::steady_clock::now() - start;
+    while (ring.pop(record)) {}
+
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) {
+        logTo(ring, LOG_LEVEL_INFO, "Audio stream started");
+        if ((i & (LOG_RING_SLOTS / 2 - 1)) == 0) {
+            while (ring.pop(record)) {}
+        }
+    }
+    auto constant = std::chrono::steady_clock::now() - start;
+
+    // Ring full: every call is dropped
+    while (logTo(ring, LOG_LEVEL_INFO, "fill")) {}
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) {
+        logTo(ring, LOG_LEVEL_INFO, "Volume: %d%%", (int)i);
+    }
+    auto full = std::chrono::steady_clock::now() - start;
+
+    printf("log call, formatted                    : %7.1f ns/call (%ld accepted)\n",
+           nsPerCall(formatted, iterations), accepted);
+    printf("log call, constant string              : %7.1f ns/call\n",
+           nsPerCall(constant, iterations));
+    printf("log call, ring full (dropped)          : %7.1f ns/call\n",
+           nsPerCall(full, iterations));
+    return 0;
+}
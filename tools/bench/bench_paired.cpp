@@ -0,0 +1,243 @@
+// Host check for the paired device list (include/PairedDevices.h).
+//
+// Checks: most-recent-first ordering, LRU eviction at PAIRED_MAX_DEVICES,
+// per-device settings kept across reconnects, forget, and the NVS blob round
+// trip, including every truncated length, a wrong version, a wrong record
+// size and an over-long count, none of which may change the list. Name cache:
+// the cached name is there on reconnect and after a restart, a refreshed name
+// is stored and saved only when it changed, a refresh leaves the order alone,
+// and long names are cut to PAIRED_NAME_LENGTH on a UTF-8 character boundary.
+// Printed with the expected range; failures give exit status 1.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/bench/bench_paired.cpp src/PairedDevices.cpp -o bench_paired
+//   ./bench_paired
+
+#include <stdio.h>
+#include <string.h>
+#include "PairedDevices.h"
+
+static int failures = 0;
+
+static void check(const char* what, double value, double lo, double hi) {
+    bool ok = value >= lo && value <= hi;
+    printf("  %-44s %9.2f   [%g, %g] %s\n", what, value, lo, hi, ok ? "ok" : "FAIL");
+    failures += !ok;
+}
+
+// Address whose last byte is the id, so the order reads as a list of ids
+static const uint8_t* address(uint8_t id) {
+    static uint8_t a[6];
+    const uint8_t base[6] = { 0x24, 0x0a, 0xc4, 0x00, 0x00, id };
+    memcpy(a, base, 6);
+    return a;
+}
+
+// Ids front to back as a number (1, 2, 3 -> 123), to check an order at once
+static double order(const PairedDeviceList& list) {
+    double value = 0;
+    for (int i = 0; i < list.count(); i++) {
+        value = value * 10 + list.at(i).address[5];
+    }
+    return value;
+}
+
+static bool sameList(const PairedDeviceList& a, const PairedDeviceList& b) {
+    if (a.count() != b.count()) {
+        return false;
+    }
+    for (int i = 0; i < a.count(); i++) {
+        if (memcmp(&a.at(i), &b.at(i), sizeof(PairedDevice)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void checkOrdering() {
+    printf("ordering\n");
+    PairedDeviceList list;
+    list.touch(address(1), 50);
+    list.touch(address(2), 50);
+    list.touch(address(3), 50);
+    check("new devices go to the front", order(list), 321, 321);
+    list.touch(address(1), 50);
+    check("reconnect moves to the front", order(list), 132, 132);
+    list.touch(address(1), 50);
+    check("reconnect of the front device", order(list), 132, 132);
+    bool newer = true;
+    for (int i = 1; i < list.count(); i++) {
+        newer = newer && list.at(i - 1).lastSeen > list.at(i).lastSeen;
+    }
+    check("lastSeen decreasing front to back", newer, 1, 1);
+    check("find", list.find(address(3)), 1, 1);
+    check("find unknown", list.find(address(9)), -1, -1);
+}
+
+static void checkEviction() {
+    printf("eviction\n");
+    PairedDeviceList list;
+    for (uint8_t id = 1; id <= PAIRED_MAX_DEVICES; id++) {
+        list.touch(address(id), 50).volume = 10 * id;
+    }
+    check("full", list.count(), PAIRED_MAX_DEVICES, PAIRED_MAX_DEVICES);
+    list.touch(address(2), 50);
+    check("reconnect when full evicts nothing", list.count(), PAIRED_MAX_DEVICES, PAIRED_MAX_DEVICES);
+    check("order after reconnect", order(list), 265431, 265431);
+    PairedDevice& added = list.touch(address(7), 50);
+    check("new device when full: count", list.count(), PAIRED_MAX_DEVICES, PAIRED_MAX_DEVICES);
+    check("least recently used evicted", list.find(address(1)), -1, -1);
+    check("order after eviction", order(list), 726543, 726543);
+    check("new device gets the default volume", added.volume, 50, 50);
+    check("kept device keeps its volume", list.at(list.find(address(2))).volume, 20, 20);
+    list.touch(address(1), 40);
+    check("evicted device comes back as new", list.at(0).volume, 40, 40);
+    check("and evicts the next oldest", list.find(address(3)), -1, -1);
+}
+
+static void checkForget() {
+    printf("forget\n");
+    PairedDeviceList list;
+    for (uint8_t id = 1; id <= 4; id++) {
+        list.touch(address(id), 50).volume = 10 * id;
+    }
+    check("forget a middle device", list.remove(address(3)), 1, 1);
+    check("order kept", order(list), 421, 421);
+    check("forget an unknown device", list.remove(address(3)), 0, 0);
+    check("forget the front device", list.remove(address(4)), 1, 1);
+    check("forget the last device", list.remove(address(1)), 1, 1);
+    check("order", order(list), 2, 2);
+    check("remaining device keeps its volume", list.at(0).volume, 20, 20);
+    list.touch(address(3), 50);
+    check("forgotten device comes back as new", list.at(0).volume, 50, 50);
+    list.clear();
+    check("clear", list.count(), 0, 0);
+}
+
+static void checkBlob() {
+    printf("blob\n");
+    PairedDeviceList list;
+    for (uint8_t id = 1; id <= 5; id++) {
+        PairedDevice& d = list.touch(address(id), 50);
+        d.volume = 10 * id;
+        d.eqPreset = id % 3;
+        snprintf(d.name, sizeof(d.name), "Phone %u", id);
+    }
+    list.touch(address(2), 50);
+
+    uint8_t blob[PairedDeviceList::blobSize(PAIRED_MAX_DEVICES)];
+    size_t size = list.serialize(blob, sizeof(blob));
+    check("size", size, PairedDeviceList::blobSize(5), PairedDeviceList::blobSize(5));
+    check("too small a buffer", list.serialize(blob, size - 1), 0, 0);
+
+    PairedDeviceList restored;
+    check("round trip accepted", restored.deserialize(blob, size), 1, 1);
+    check("round trip identical", sameList(list, restored), 1, 1);
+    restored.touch(address(4), 50);
+    check("sequence continues after restore", restored.at(0).lastSeen > list.at(0).lastSeen, 1, 1);
+
+    PairedDeviceList empty, emptyRestored;
+    uint8_t small[PairedDeviceList::blobSize(0)];
+    size_t emptySize = empty.serialize(small, sizeof(small));
+    check("empty list round trip", emptySize == sizeof(small) && emptyRestored.deserialize(small, emptySize) &&
+          emptyRestored.count() == 0, 1, 1);
+
+    // Rejected blobs must leave the list as it was
+    PairedDeviceList target;
+    target.touch(address(9), 30);
+    PairedDeviceList before = target;
+    int accepted = 0;
+    for (size_t length = 0; length < size; length++) {
+        accepted += target.deserialize(blob, length);
+    }
+    check("truncated blobs accepted", accepted, 0, 0);
+    uint8_t bad[sizeof(blob)];
+    memcpy(bad, blob, size);
+    bad[0] = PAIRED_BLOB_VERSION + 1;
+    check("wrong version accepted", target.deserialize(bad, size), 0, 0);
+    memcpy(bad, blob, size);
+    bad[2]++;
+    check("wrong record size accepted", target.deserialize(bad, size), 0, 0);
+    // Long enough for the count it claims, so only the count check can reject it
+    uint8_t big[PairedDeviceList::blobSize(PAIRED_MAX_DEVICES + 1)] = {};
+    memcpy(big, blob, size);
+    big[1] = PAIRED_MAX_DEVICES + 1;
+    check("too many devices accepted", target.deserialize(big, sizeof(big)), 0, 0);
+    check("list unchanged by rejected blobs", sameList(target, before), 1, 1);
+
+    // A name without its NUL is terminated on load
+    memcpy(bad, blob, size);
+    memset(bad + sizeof(PairedBlobHeader) + offsetof(PairedDevice, name), 'x', PAIRED_NAME_LENGTH);
+    check("unterminated name accepted", target.deserialize(bad, size), 1, 1);
+    check("and terminated", strlen(target.at(0).name), PAIRED_NAME_LENGTH - 1, PAIRED_NAME_LENGTH - 1);
+}
+
+// Well-formed UTF-8 (no sequence cut short, no stray continuation byte)
+static bool validUtf8(const char* text) {
+    for (const uint8_t* p = (const uint8_t*)text; *p != 0;) {
+        int extra = *p < 0x80 ? 0 : (*p & 0xE0) == 0xC0 ? 1 : (*p & 0xF0) == 0xE0 ? 2 : (*p & 0xF8) == 0xF0 ? 3 : -1;
+        if (extra < 0) {
+            return false;
+        }
+        for (p++; extra > 0; extra--, p++) {
+            if ((*p & 0xC0) != 0x80) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Cut a name made of repeats of one character and report the kept length
+static double cutLength(const char* character, int repeats) {
+    char name[128] = "";
+    for (int i = 0; i < repeats; i++) {
+        strcat(name, character);
+    }
+    char out[PAIRED_NAME_LENGTH];
+    copyName(out, sizeof(out), name);
+    return validUtf8(out) && strncmp(out, name, strlen(out)) == 0 ? strlen(out) : -1;
+}
+
+static void checkNames() {
+    printf("name cache\n");
+    PairedDeviceList list;
+    list.touch(address(1), 50);
+    list.touch(address(2), 50);
+    list.touch(address(3), 50);
+    check("first name stored (save)", list.setName(address(2), "Pixel 8"), 1, 1);
+    check("same name again (no save)", list.setName(address(2), "Pixel 8"), 0, 0);
+    check("unknown device", list.setName(address(9), "Ghost"), 0, 0);
+    check("order unchanged by a name refresh", order(list), 321, 321);
+    check("lastSeen unchanged by a name refresh", list.at(1).lastSeen, 2, 2);
+
+    // Reconnect, and reconnect after a restart, show the cached name at once
+    PairedDevice& device = list.touch(address(2), 50);
+    check("cached name on reconnect", strcmp(device.name, "Pixel 8") == 0, 1, 1);
+    check("renamed phone (save)", list.setName(address(2), "Anna's Pixel"), 1, 1);
+    uint8_t blob[PairedDeviceList::blobSize(PAIRED_MAX_DEVICES)];
+    PairedDeviceList restored;
+    restored.deserialize(blob, list.serialize(blob, sizeof(blob)));
+    check("new name written back", strcmp(restored.at(0).name, "Anna's Pixel") == 0, 1, 1);
+    PairedDevice& again = restored.touch(address(2), 50);
+    check("cached name on reconnect after restart", strcmp(again.name, "Anna's Pixel") == 0, 1, 1);
+
+    // 23 bytes fit; longer names lose whole characters only
+    check("ASCII, fits exactly", cutLength("a", PAIRED_NAME_LENGTH - 1), 23, 23);
+    check("ASCII, cut", cutLength("a", 40), 23, 23);
+    check("2-byte characters, cut", cutLength("\xc3\xa9", 20), 22, 22);
+    check("3-byte characters, cut", cutLength("\xe5\x9d\x82", 10), 21, 21);
+    check("4-byte characters, cut", cutLength("\xf0\x9f\x8e\xb5", 8), 20, 20);
+    check("3-byte after one ASCII, cut", cutLength("x\xe5\x9d\x82", 8), 21, 21);
+    list.setName(address(3), "\xd0\x9f\xd0\xb5\xd1\x82\xd1\x8f\xd0\xb2 Galaxy S23 Ultra 5G");
+    check("stored name cut on a boundary", validUtf8(list.at(list.find(address(3))).name), 1, 1);
+}
+
+int main() {
+    checkOrdering();
+    checkEviction();
+    checkForget();
+    checkBlob();
+    checkNames();
+    printf("\n%s\n", failures ? "checks FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,275 @@
+// Host check and benchmark for the calibration signal generator.
+//
+// Checks: level, frequency and THD+N of tones (level also after ten minutes of phasor
+// rotation), sweep timing and flatness per octave, pink noise level and
+// slope (equal energy per octave, i.e. -3 dB/octave spectral density),
+// channel selection and pulse polarity. Octave band levels come from a
+// Welch-averaged spectrum (4096-point Hann frames, 50 % overlap). Printed
+// with the expected range; failures give exit status 1.
+//
+// Cost: ns per stereo frame for each signal type. Run with --cpu-factor
+// (about 10 for an ESP32 at 240 MHz) to estimate the target load.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/bench/bench_signal.cpp src/SignalGenerator.cpp src/RealFft.cpp -o bench_signal
+//   ./bench_signal [--cpu-factor 10]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "SignalGenerator.h"
+#include "RealFft.h"
+
+static const uint32_t SAMPLE_RATE = 44100;
+static const size_t FFT_SIZE = 4096;
+static const double OCTAVES[] = { 63, 125, 250, 500, 1000, 2000, 4000, 8000 };
+static const int OCTAVE_COUNT = sizeof(OCTAVES) / sizeof(OCTAVES[0]);
+static int failures = 0;
+
+static void check(const char* what, double value, double lo, double hi) {
+    bool ok = value >= lo && value <= hi;
+    printf("  %-44s %9.2f   [%g, %g] %s\n", what, value, lo, hi, ok ? "ok" : "FAIL");
+    failures += !ok;
+}
+
+struct Signal {
+    std::vector<float> left, right;
+};
+
+static Signal render(const SignalSettings& settings, double seconds) {
+    SignalGenerator generator;
+    generator.start(settings, SAMPLE_RATE);
+    size_t frames = (size_t)(seconds * SAMPLE_RATE);
+    Signal out;
+    out.left.resize(frames);
+    out.right.resize(frames);
+    for (size_t pos = 0; pos < frames; pos += 128) {
+        size_t n = frames - pos < 128 ? frames - pos : 128;
+        generator.generate(out.left.data() + pos, out.right.data() + pos, n);
+    }
+    return out;
+}
+
+static double rmsDb(const std::vector<float>& x, size_t from = 0, size_t to = 0) {
+    to = to ? to : x.size();
+    double sum = 0;
+    for (size_t i = from; i < to; i++) {
+        sum += (double)x[i] * x[i];
+    }
+    return 10 * log10(sum / (to - from) + 1e-30);
+}
+
+static double peakDb(const std::vector<float>& x, size_t from = 0, size_t to = 0) {
+    to = to ? to : x.size();
+    double peak = 0;
+    for (size_t i = from; i < to; i++) {
+        peak = fmax(peak, fabs(x[i]));
+    }
+    return 20 * log10(peak + 1e-30);
+}
+
+// Power spectrum averaged over Hann frames, per bin (n/2 + 1 bins)
+static std::vector<double> spectrum(const std::vector<float>& x, size_t from = 0, size_t to = 0) {
+    to = to ? to : x.size();
+    RealFft fft;
+    fft.begin(FFT_SIZE);
+    std::vector<double> power(FFT_SIZE / 2 + 1);
+    std::vector<float> frame(FFT_SIZE);
+    int frames = 0;
+    for (size_t pos = from; pos + FFT_SIZE <= to; pos += FFT_SIZE / 2, frames++) {
+        for (size_t i = 0; i < FFT_SIZE; i++) {
+            frame[i] = x[pos + i] * (float)(0.5 - 0.5 * cos(2 * M_PI * i / FFT_SIZE));
+        }
+        fft.forward(frame.data());
+        power[0] += (double)frame[0] * frame[0];
+        power[FFT_SIZE / 2] += (double)frame[1] * frame[1];
+        for (size_t k = 1; k < FFT_SIZE / 2; k++) {
+            power[k] += (double)frame[2 * k] * frame[2 * k] + (double)frame[2 * k + 1] * frame[2 * k + 1];
+        }
+    }
+    for (double& p : power) {
+        p /= frames;
+    }
+    return power;
+}
+
+// Energy in the octave band around each centre frequency, dB
+static void octaveLevels(const std::vector<double>& power, double* levels) {
+    for (int b = 0; b < OCTAVE_COUNT; b++) {
+        double lo = OCTAVES[b] / sqrt(2.0), hi = OCTAVES[b] * sqrt(2.0), sum = 0;
+        for (size_t k = 1; k < power.size(); k++) {
+            double f = (double)k * SAMPLE_RATE / FFT_SIZE;
+            if (f >= lo && f < hi) {
+                sum += power[k];
+            }
+        }
+        levels[b] = 10 * log10(sum + 1e-30);
+    }
+}
+
+static size_t strongestBin(const std::vector<double>& power) {
+    size_t best = 1;
+    for (size_t k = 1; k < power.size(); k++) {
+        best = power[k] > power[best] ? k : best;
+    }
+    return best;
+}
+
+// Largest deviation of the octave levels from their mean, dB
+static double octaveSpread(const double* levels) {
+    double mean = 0, spread = 0;
+    for (int b = 0; b < OCTAVE_COUNT; b++) {
+        mean += levels[b] / OCTAVE_COUNT;
+    }
+    for (int b = 0; b < OCTAVE_COUNT; b++) {
+        spread = fmax(spread, fabs(levels[b] - mean));
+    }
+    return spread;
+}
+
+static void checkTone() {
+    printf("tone\n");
+    SignalSettings s;
+    s.type = SIGNAL_TONE;
+    s.frequency = 1000;
+    s.level = -20;
+    Signal x = render(s, 2);
+    check("1 kHz -20 dBFS: peak, dBFS", peakDb(x.left), -20.01, -19.99);
+    check("1 kHz -20 dBFS: rms, dBFS", rmsDb(x.left), -23.03, -22.99);
+    std::vector<double> power = spectrum(x.left);
+    double bin = (double)SAMPLE_RATE / FFT_SIZE;
+    check("1 kHz: strongest bin, Hz", strongestBin(power) * bin, 1000 - bin, 1000 + bin);
+    // Residual after a least-squares sine fit over the last FFT_SIZE samples
+    // (short enough that the float rotation's tiny frequency offset does not count)
+    size_t from = x.left.size() - FFT_SIZE;
+    double ss = 0, sc = 0, cc = 0, xs = 0, xc = 0;
+    for (size_t i = from; i < x.left.size(); i++) {
+        double sn = sin(2 * M_PI * 1000.0 * i / SAMPLE_RATE), cs = cos(2 * M_PI * 1000.0 * i / SAMPLE_RATE);
+        ss += sn * sn;
+        sc += sn * cs;
+        cc += cs * cs;
+        xs += x.left[i] * sn;
+        xc += x.left[i] * cs;
+    }
+    double det = ss * cc - sc * sc, a = (xs * cc - xc * sc) / det, b = (xc * ss - xs * sc) / det;
+    double residual = 0, signal = 0;
+    for (size_t i = from; i < x.left.size(); i++) {
+        double fit = a * sin(2 * M_PI * 1000.0 * i / SAMPLE_RATE) + b * cos(2 * M_PI * 1000.0 * i / SAMPLE_RATE);
+        residual += (x.left[i] - fit) * (x.left[i] - fit);
+        signal += fit * fit;
+    }
+    check("1 kHz: THD+N, dB", 10 * log10(residual / signal), -200, -100);
+    check("1 kHz: left equals right", x.left == x.right, 1, 1);
+
+    // The phasor is renormalized per block; its amplitude must not drift
+    Signal late = render(s, 600);
+    size_t frames = late.left.size();
+    check("1 kHz after 10 min: peak, dBFS", peakDb(late.left, frames - SAMPLE_RATE, frames), -20.01, -19.99);
+}
+
+static void checkSweep() {
+    printf("sweep\n");
+    SignalSettings s;
+    s.type = SIGNAL_SWEEP;
+    s.level = -12;
+    s.sweepStart = 20;
+    s.sweepEnd = 20000;
+    s.sweepSeconds = 10;
+    SignalGenerator generator;
+    generator.start(s, SAMPLE_RATE);
+    std::vector<float> left(SAMPLE_RATE * 5), right(left.size());
+    generator.generate(left.data(), right.data(), left.size());
+    check("20-20k in 10 s: frequency at 5 s, Hz", generator.sweepFrequency(), 630, 635);
+
+    Signal x = render(s, 12);
+    size_t sweepEnd = 10 * SAMPLE_RATE;
+    check("peak, dBFS", peakDb(x.left), -12.01, -11.99);
+    check("1 s gap after the sweep: peak, dBFS", peakDb(x.left, sweepEnd, sweepEnd + SAMPLE_RATE), -1000, -200);
+    check("fade-out: peak of the last 1 ms, dBFS", peakDb(x.left, sweepEnd - SAMPLE_RATE / 1000, sweepEnd), -1000,
+          -24);
+    double levels[OCTAVE_COUNT];
+    octaveLevels(spectrum(x.left, 0, sweepEnd), levels);
+    check("equal time per octave: octave level spread, dB", octaveSpread(levels), 0, 0.5);
+}
+
+static void checkPink() {
+    printf("pink\n");
+    SignalSettings s;
+    s.type = SIGNAL_PINK;
+    s.level = -20;
+    s.channels = SIGNAL_LEFT;
+    Signal x = render(s, 60);
+    check("-20 dBFS: rms, dBFS", rmsDb(x.left), -20.5, -19.5);
+    check("left only: right channel peak, dBFS", peakDb(x.right), -1000, -200);
+    double levels[OCTAVE_COUNT];
+    octaveLevels(spectrum(x.left), levels);
+    check("equal energy per octave: level spread, dB", octaveSpread(levels), 0, 1);
+    double slope = (levels[OCTAVE_COUNT - 1] - levels[0]) / (OCTAVE_COUNT - 1);
+    check("octave band slope, dB/octave (pink 0, white +3)", slope, -0.3, 0.3);
+}
+
+static void checkPulse() {
+    printf("pulse\n");
+    SignalSettings s;
+    s.type = SIGNAL_PULSE;
+    s.level = -6;
+    s.channels = SIGNAL_RIGHT;
+    Signal x = render(s, 1);
+    double sum = 0;
+    int starts = 0;
+    for (size_t i = 0; i < x.right.size(); i++) {
+        sum += x.right[i];
+        starts += x.right[i] != 0 && (i == 0 || x.right[i - 1] == 0);
+    }
+    check("pulses per second", starts, 2, 2);
+    check("positive polarity: sample sum", sum, 1, 100);
+    check("peak, dBFS", peakDb(x.right), -6.1, -5.99);
+    check("right only: left channel peak, dBFS", peakDb(x.left), -1000, -200);
+    s.invert = true;
+    x = render(s, 1);
+    sum = 0;
+    for (float v : x.right) {
+        sum += v;
+    }
+    check("inverted: sample sum", sum, -100, -1);
+}
+
+int main(int argc, char** argv) {
+    double cpuFactor = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--cpu-factor") && i + 1 < argc) cpuFactor = atof(argv[++i]);
+    }
+
+    printf("%-8s %10s %10s\n", "signal", "ns/frame", "stream %");
+    double budgetNs = 1e9 / SAMPLE_RATE;
+    const size_t frames = 4 * SAMPLE_RATE;
+    std::vector<float> left(128), right(128);
+    for (uint8_t type = SIGNAL_TONE; type < SIGNAL_COUNT; type++) {
+        SignalSettings s;
+        s.type = type;
+        SignalGenerator generator;
+        generator.start(s, SAMPLE_RATE);
+        double best = 1e30;
+        for (int run = 0; run < 3; run++) {
+            auto t0 = std::chrono::steady_clock::now();
+            for (size_t pos = 0; pos < frames; pos += 128) {
+                generator.generate(left.data(), right.data(), 128);
+            }
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+            best = ns < best ? ns : best;
+        }
+        double perFrame = best / frames * cpuFactor;
+        printf("%-8s %10.2f %9.3f%%\n", signalTypeName(type), perFrame, 100 * perFrame / budgetNs);
+    }
+    printf("\n");
+
+    checkTone();
+    checkSweep();
+    checkPink();
+    checkPulse();
+
+    printf("\n%s\n", failures ? "checks FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+// Host benchmark for metadata cleanup and OLED line breaking: ns per title
+// for Player::onMetadata() (copy + cleanTitle/cleanArtist) and layoutText(),
+// first over a corpus of real-world titles, then over random byte strings
+// (no NUL within the buffer, missing spaces, runs of spaces, broken UTF-8)
+// that also check the layout bounds and abort on a violation. Build with
+// -fsanitize=address,undefined to have every access checked as well.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/bench/bench_text.cpp src/Player.cpp src/TextLayout.cpp -o bench_text && ./bench_text
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "Player.h"
+#include "TextLayout.h"
+
+static const char* const corpus[] = {
+    "Rick Astley - Never Gonna Give You Up (Official Music Video)",
+    "Daft Punk - Get Lucky (Official Audio) ft. Pharrell Williams, Nile Rodgers",
+    "Bohemian Rhapsody",
+    "Ludwig van Beethoven - Symphony No. 9 in D minor, Op. 125 \"Choral\": IV. Presto - Allegro assai",
+    "Metallica: Enter Sandman [Official Music Video]",
+    "Sigur Rós - Hoppípolla",
+    "Björk - Jóga",
+    "坂本龍一 - Merry Christmas Mr. Lawrence",
+    "Лесоповал - Я куплю тебе дом",
+    "Aphex Twin - Avril 14th",
+    "Toto - Africa (Lyrics)",
+    "   leading and trailing spaces   ",
+    " - ",
+    "-",
+    "A - B - C - D - E - F",
+    "Supercalifragilisticexpialidociousandthensomemorewithoutanyspaces",
+    "Official Video",
+    "(Official Video)(Official Video)(Official Video)",
+    "Various Artists - Topic",
+    "The Weeknd - Blinding Lights (Official Video) [Lyric Video] (Lyrics)",
+    "",
+};
+
+static volatile size_t sink;
+
+static void checkLayout(const TextLines& lines, int width, int maxLines) {
+    if (lines.count < 1 || lines.count > maxLines) {
+        fprintf(stderr, "layout: %d lines for max %d\n", lines.count, maxLines);
+        abort();
+    }
+    for (int i = 0; i < lines.count; i++) {
+        if (strnlen(lines.line[i], TEXT_MAX_WIDTH + 1) > (size_t)width) {
+            fprintf(stderr, "layout: line %d longer than %d\n", i, width);
+            abort();
+        }
+    }
+}
+
+static double run(const char* const* titles, size_t count, int repeat, bool check) {
+    Player player;
+    player.begin(50);
+    TextLines lines;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < count; i++) {
+            player.onMetadata(METADATA_TITLE, titles[i]);
+            player.onMetadata(METADATA_ARTIST, titles[i]);
+            layoutText(player.state().title, 21, 2, lines, PLAYER_TEXT_LENGTH);
+            if (check) {
+                checkLayout(lines, 21, 2);
+            }
+            layoutText(titles[i], 10 + (int)(i % 20), 1 + (int)(i % TEXT_MAX_LINES), lines);
+            if (check) {
+                checkLayout(lines, 10 + (int)(i % 20), 1 + (int)(i % TEXT_MAX_LINES));
+            }
+            sink += lines.count;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)repeat * count);
+}
+
+int main() {
+    const size_t corpusSize = sizeof(corpus) / sizeof(corpus[0]);
+    double best = 1e30;
+    for (int i = 0; i < 5; i++) {
+        double ns = run(corpus, corpusSize, 2000, true);
+        best = ns < best ? ns : best;
+    }
+    printf("corpus  : %7.1f ns/title (%zu titles, best of 5)\n", best, corpusSize);
+
+    // Random inputs: each string fills its whole buffer, without a NUL, so any
+    // read past maxInput / PLAYER_TEXT_LENGTH would show up under ASan
+    const size_t inputs = 200000;
+    static const char alphabet[] = "aaaaeeeiioouu   --()[]\xc3\xa9\xe5\x9d\x82\x80\xff";
+    char** titles = new char*[inputs];
+    uint32_t state = 1;
+    for (size_t i = 0; i < inputs; i++) {
+        size_t length = 1 + i % 255;
+        titles[i] = new char[length];
+        for (size_t j = 0; j < length; j++) {
+            state = state * 1664525u + 1013904223u;
+            titles[i][j] = alphabet[(state >> 16) % (sizeof(alphabet) - 1)];
+        }
+    }
+    // onMetadata() stops at PLAYER_TEXT_LENGTH - 1 and layoutText() at maxInput,
+    // so only strings at least that long are passed without a terminator
+    TextLines lines;
+    Player player;
+    player.begin(50);
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < inputs; i++) {
+        size_t length = 1 + i % 255;
+        int width = 4 + (int)(i % (TEXT_MAX_WIDTH - 3));
+        int maxLines = 1 + (int)(i % TEXT_MAX_LINES);
+        if (length >= PLAYER_TEXT_LENGTH) {
+            player.onMetadata(METADATA_TITLE, titles[i]);
+            layoutText(player.state().title, width, maxLines, lines, PLAYER_TEXT_LENGTH);
+            checkLayout(lines, width, maxLines);
+        }
+        layoutText(titles[i], width, maxLines, lines, length);
+        checkLayout(lines, width, maxLines);
+        sink += lines.count;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    printf("random  : %7.1f ns/input (%zu inputs, bounds checked)\n",
+           std::chrono::duration<double, std::nano>(t1 - t0).count() / inputs, inputs);
+
+    for (size_t i = 0; i < inputs; i++) {
+        delete[] titles[i];
+    }
+    delete[] titles;
+    return 0;
+}
@@ -0,0 +1,39 @@
+// Host micro-benchmark for TRACE(): cycles per recorded event, measured with
+// the same timestamp source the records use (rdtsc on x86). On target, the
+// "trace bench" serial command reports the equivalent number in CPU cycles.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/bench/bench_trace.cpp -o bench_trace && ./bench_trace
+
+#include <stdio.h>
+#include "Trace.h"
+
+TraceRecord traceRing[TRACE_RING_RECORDS];
+std::atomic<uint32_t> traceHead{0};
+bool traceActive = true;
+
+int main() {
+    const uint32_t calls = 1000000;
+    uint32_t best = UINT32_MAX;
+
+    for (int run = 0; run < 10; run++) {
+        uint32_t start = traceTimestamp();
+        for (uint32_t i = 0; i < calls; i++) {
+            TRACE(TRACE_A2DP_DATA, 0, i, 0);
+        }
+        uint32_t cycles = traceTimestamp() - start;
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+
+    traceActive = false;
+    uint32_t start = traceTimestamp();
+    for (uint32_t i = 0; i < calls; i++) {
+        TRACE(TRACE_A2DP_DATA, 0, i, 0);
+    }
+    uint32_t disabled = traceTimestamp() - start;
+
+    printf("TRACE() enabled : %5.1f cycles/event (best of 10)\n", (double)best / calls);
+    printf("TRACE() paused  : %5.1f cycles/event\n", (double)disabled / calls);
+    return 0;
+}
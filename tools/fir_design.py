@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Generate include/SpeakerFir.h, the impulse response of the "fir" audio stage.
+
+Usage:
+    tools/fir_design.py [--fc 150] [--q 0.707] [--taps 2048] [--rate 44100] [-o include/SpeakerFir.h]
+    tools/fir_design.py --wav correction.wav [-o include/SpeakerFir.h]
+
+By default the filter undoes the phase shift of the enclosure's low-frequency
+roll-off, modelled as a 2nd-order high-pass at --fc with quality --q (a closed
+box). The magnitude stays flat; the response is delayed by taps/2 samples so the
+correction can act before each transient. --wav converts a correction impulse
+response measured elsewhere (mono 16-bit PCM, at the stream rate) instead.
+The taps end up in a const array, which the firmware keeps in flash.
+"""
+
+import argparse
+import cmath
+import math
+import os
+import struct
+import sys
+import wave
+
+DEFAULT_OUT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "include", "SpeakerFir.h"))
+
+
+def fft(values, inverse=False):
+    n = len(values)
+    if n == 1:
+        return list(values)
+    even = fft(values[0::2], inverse)
+    odd = fft(values[1::2], inverse)
+    sign = 1 if inverse else -1
+    out = [0] * n
+    for k in range(n // 2):
+        t = cmath.exp(sign * 2j * math.pi * k / n) * odd[k]
+        out[k] = even[k] + t
+        out[k + n // 2] = even[k] - t
+    return out
+
+
+def phase_correction(fc, q, taps, rate):
+    if taps & (taps - 1):
+        sys.exit("--taps must be a power of two")
+    wc = 2 * math.pi * fc
+    delay = taps // 2
+    spectrum = [0j] * taps
+    for k in range(taps // 2 + 1):
+        w = 2 * math.pi * k * rate / taps
+        s = 1j * w
+        box = s * s / (s * s + s * wc / q + wc * wc) if k else -1
+        value = cmath.exp(-1j * cmath.phase(box)) * cmath.exp(-2j * math.pi * k * delay / taps)
+        spectrum[k] = value
+        if 0 < k < taps // 2:
+            spectrum[taps - k] = value.conjugate()
+    spectrum[taps // 2] = complex(spectrum[taps // 2].real, 0)
+    ir = [v.real / taps for v in fft(spectrum, inverse=True)]
+    # Hann window around the centre tames the truncation of the long low-frequency tail
+    return [x * (0.5 - 0.5 * math.cos(2 * math.pi * (i + 0.5) / taps)) for i, x in enumerate(ir)]
+
+
+def read_wav(path):
+    with wave.open(path) as w:
+        if w.getnchannels() != 1 or w.getsampwidth() != 2:
+            sys.exit("%s: expected mono 16-bit PCM" % path)
+        frames = w.readframes(w.getnframes())
+        rate = w.getframerate()
+    samples = struct.unpack("<%dh" % (len(frames) // 2), frames)
+    return [s / 32768.0 for s in samples], rate
+
+
+def write_header(path, taps, rate, source):
+    lines = [
+        "#pragma once",
+        "",
+        "// Generated by tools/fir_design.py %s; do not edit." % source,
+        "// Impulse response of the \"fir\" audio stage, kept in flash.",
+        "",
+        "#define SPEAKER_FIR_RATE    %d" % rate,
+        "#define SPEAKER_FIR_TAPS    %d" % len(taps),
+        "",
+        "static const float speakerFir[SPEAKER_FIR_TAPS] = {",
+    ]
+    for i in range(0, len(taps), 6):
+        lines.append("    " + " ".join("%.8ef," % t for t in taps[i:i + 6]))
+    lines.append("};")
+    with open(path, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--fc", type=float, default=150.0, help="enclosure high-pass corner, Hz")
+    parser.add_argument("--q", type=float, default=0.707, help="enclosure high-pass quality")
+    parser.add_argument("--taps", type=int, default=2048)
+    parser.add_argument("--rate", type=int, default=44100)
+    parser.add_argument("--wav", help="use a measured impulse response instead")
+    parser.add_argument("-o", "--output", default=DEFAULT_OUT)
+    args = parser.parse_args()
+
+    if args.wav:
+        taps, rate = read_wav(args.wav)
+        source = "--wav %s" % os.path.basename(args.wav)
+    else:
+        taps, rate = phase_correction(args.fc, args.q, args.taps, args.rate), args.rate
+        source = "--fc %g --q %g --taps %d --rate %d" % (args.fc, args.q, args.taps, args.rate)
+    write_header(args.output, taps, rate, source)
+    print("%s: %d taps at %d Hz" % (args.output, len(taps), rate))
+
+
+if __name__ == "__main__":
+    main()
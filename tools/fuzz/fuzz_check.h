@@ -0,0 +1,32 @@
+#pragma once
+
+// Invariants shared by the fuzz targets; a violation aborts so libFuzzer
+// (or standalone.cpp) stops and keeps the input.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "TextLayout.h"
+
+static inline void fuzzFail(const char* what) {
+    fprintf(stderr, "fuzz: %s\n", what);
+    abort();
+}
+
+static inline void checkLayout(const TextLines& lines, int width, int maxLines) {
+    if (lines.count < 1 || lines.count > maxLines) {
+        fuzzFail("layout line count out of range");
+    }
+    for (int i = 0; i < lines.count; i++) {
+        if (strnlen(lines.line[i], TEXT_MAX_WIDTH + 1) > (size_t)width) {
+            fuzzFail("layout line wider than asked for");
+        }
+    }
+}
+
+// A string terminated inside its buffer
+static inline void checkTerminated(const char* text, size_t size) {
+    if (strnlen(text, size) >= size) {
+        fuzzFail("text not terminated inside its buffer");
+    }
+}
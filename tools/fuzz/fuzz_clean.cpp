@@ -0,0 +1,35 @@
+// libFuzzer target for cleanTitle() / cleanArtist() on their own, over
+// strings of any length in an exactly sized buffer: the result must stay
+// terminated inside it, never grow, and carry no leading or trailing spaces.
+//
+//   clang++ -g -O1 -std=gnu++17 -fsanitize=fuzzer,address -Iinclude tools/fuzz/fuzz_clean.cpp src/Player.cpp src/TextLayout.cpp -o fuzz_clean
+//   ./fuzz_clean -max_total_time=60 tools/fuzz/corpus
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "Player.h"
+#include "fuzz_check.h"
+
+static void checkClean(void (*clean)(char*), const uint8_t* data, size_t size) {
+    char* text = new char[size + 1];
+    memcpy(text, data, size);
+    text[size] = '\0';
+    size_t before = strlen(text);
+    clean(text);
+    checkTerminated(text, size + 1);
+    size_t after = strlen(text);
+    if (after > before) {
+        fuzzFail("cleanup made the text longer");
+    }
+    if (after > 0 && (text[0] == ' ' || text[after - 1] == ' ')) {
+        fuzzFail("cleanup left a leading or trailing space");
+    }
+    delete[] text;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    checkClean(cleanTitle, data, size);
+    checkClean(cleanArtist, data, size);
+    return 0;
+}
@@ -0,0 +1,30 @@
+// libFuzzer target for layoutText(): the input is laid out unterminated, with
+// maxInput set to its size, at the narrowest, both panels' and the widest
+// width and every line count. Any read past the input shows up under ASan.
+//
+//   clang++ -g -O1 -std=gnu++17 -fsanitize=fuzzer,address -Iinclude tools/fuzz/fuzz_layout.cpp src/TextLayout.cpp -o fuzz_layout
+//   ./fuzz_layout -max_total_time=60 tools/fuzz/corpus
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "TextLayout.h"
+#include "fuzz_check.h"
+
+static const int WIDTHS[] = { 4, 18, 21, TEXT_MAX_WIDTH };
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    // A zero-size input still needs a valid pointer to read nothing from
+    char* text = new char[size ? size : 1];
+    memcpy(text, data, size);
+
+    TextLines lines;
+    for (int width : WIDTHS) {
+        for (int maxLines = 1; maxLines <= TEXT_MAX_LINES; maxLines++) {
+            layoutText(text, width, maxLines, lines, size);
+            checkLayout(lines, width, maxLines);
+        }
+    }
+    delete[] text;
+    return 0;
+}
@@ -0,0 +1,47 @@
+// libFuzzer target for AVRCP metadata ingestion: the input is handed to
+// Player::onMetadata() as title and as artist, the way avrc_metadata_callback()
+// does, then laid out for the 128 px panel like updateDisplay(). Inputs of at
+// least PLAYER_TEXT_LENGTH - 1 bytes are passed without a terminator, since
+// ingestion must stop there by itself.
+//
+//   clang++ -g -O1 -std=gnu++17 -fsanitize=fuzzer,address -Iinclude tools/fuzz/fuzz_metadata.cpp src/Player.cpp src/TextLayout.cpp -o fuzz_metadata
+//   ./fuzz_metadata -max_total_time=60 tools/fuzz/corpus
+//
+// Without clang, tools/fuzz/standalone.cpp replays the corpus and random
+// mutations of it (see its header).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "Player.h"
+#include "TextLayout.h"
+#include "fuzz_check.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    bool terminated = size < PLAYER_TEXT_LENGTH - 1;
+    char* text = new char[terminated ? size + 1 : size];
+    memcpy(text, data, size);
+    if (terminated) {
+        text[size] = '\0';
+    }
+
+    Player player;
+    player.begin(50);
+    player.onMetadata(METADATA_TITLE, text);
+    player.onMetadata(METADATA_ARTIST, text);
+    player.onMetadata(0x04, text);          // album: ignored
+    const PlayerState& s = player.state();
+    checkTerminated(s.title, sizeof(s.title));
+    checkTerminated(s.artist, sizeof(s.artist));
+
+    TextLines lines;
+    for (int maxLines = 1; maxLines <= TEXT_MAX_LINES; maxLines++) {
+        layoutText(s.title, 21, maxLines, lines, PLAYER_TEXT_LENGTH);
+        checkLayout(lines, 21, maxLines);
+    }
+    layoutText(s.artist, 21, 1, lines, PLAYER_TEXT_LENGTH);
+    checkLayout(lines, 21, 1);
+
+    delete[] text;
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Driver for the fuzz targets where clang's libFuzzer is not available: runs
+// every file of the given corpus directories through LLVMFuzzerTestOneInput(),
+// then -runs=N random mutations of them (bit flips, byte inserts, deletes and
+// replacements from a UTF-8 heavy alphabet, splices, truncation), and prints
+// exec/s. No coverage feedback, so it finds less than libFuzzer does; build
+// it with the sanitizers so out-of-bounds accesses abort.
+//
+//   g++ -g -O1 -std=gnu++17 -fsanitize=address,undefined -Iinclude tools/fuzz/fuzz_layout.cpp tools/fuzz/standalone.cpp src/TextLayout.cpp -o fuzz_layout
+//   ./fuzz_layout -runs=1000000 tools/fuzz/corpus
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+#define FUZZ_MAX_INPUT  512
+
+static uint32_t seed = 1;
+
+static uint32_t randomNumber(uint32_t range) {
+    seed = seed * 1664525u + 1013904223u;
+    return (uint32_t)(((uint64_t)(seed >> 8) * range) >> 24);
+}
+
+static void loadDirectory(const char* path, std::vector<std::string>& corpus) {
+    DIR* dir = opendir(path);
+    if (dir == nullptr) {
+        fprintf(stderr, "cannot open %s\n", path);
+        exit(1);
+    }
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        std::string name = std::string(path) + "/" + entry->d_name;
+        FILE* f = fopen(name.c_str(), "rb");
+        if (f == nullptr) {
+            continue;
+        }
+        char buffer[FUZZ_MAX_INPUT];
+        size_t size = fread(buffer, 1, sizeof(buffer), f);
+        fclose(f);
+        corpus.push_back(std::string(buffer, size));
+    }
+    closedir(dir);
+}
+
+static void mutate(std::string& input, const std::vector<std::string>& corpus) {
+    static const char alphabet[] = " -()[]aeo\xc3\xa9\xe5\x9d\x82\x80\xbf\xff\xf0\x9f\x8e\xb5";
+    int steps = 1 + randomNumber(4);
+    for (int i = 0; i < steps; i++) {
+        size_t at = input.empty() ? 0 : randomNumber(input.size());
+        switch (randomNumber(6)) {
+            case 0:
+                if (!input.empty()) {
+                    input[at] ^= (char)(1 << randomNumber(8));
+                }
+                break;
+            case 1:
+                if (input.size() < FUZZ_MAX_INPUT) {
+                    input.insert(at, 1, alphabet[randomNumber(sizeof(alphabet) - 1)]);
+                }
+                break;
+            case 2:
+                if (!input.empty()) {
+                    input.erase(at, 1 + randomNumber(8));
+                }
+                break;
+            case 3:
+                if (!input.empty()) {
+                    input[at] = alphabet[randomNumber(sizeof(alphabet) - 1)];
+                }
+                break;
+            case 4: {
+                const std::string& other = corpus[randomNumber(corpus.size())];
+                input = input.substr(0, at) + other.substr(other.empty() ? 0 : randomNumber(other.size()));
+                input.resize(input.size() < FUZZ_MAX_INPUT ? input.size() : FUZZ_MAX_INPUT);
+                break;
+            }
+            default:
+                input.resize(at);
+                break;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    long runs = 100000;
+    std::vector<std::string> corpus;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-runs=", 6) == 0) {
+            runs = atol(argv[i] + 6);
+        } else if (strncmp(argv[i], "-seed=", 6) == 0) {
+            seed = (uint32_t)atol(argv[i] + 6);
+        } else {
+            loadDirectory(argv[i], corpus);
+        }
+    }
+    if (corpus.empty()) {
+        corpus.push_back("");
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (const std::string& input : corpus) {
+        LLVMFuzzerTestOneInput((const uint8_t*)input.data(), input.size());
+    }
+    for (long i = 0; i < runs; i++) {
+        std::string input = corpus[randomNumber(corpus.size())];
+        mutate(input, corpus);
+        LLVMFuzzerTestOneInput((const uint8_t*)input.data(), input.size());
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    long total = runs + (long)corpus.size();
+    printf("%ld execs (%zu seeds) in %.1f s, %.0f exec/s\n", total, corpus.size(), seconds, total / seconds);
+    return 0;
+}
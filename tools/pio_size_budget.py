@@ -0,0 +1,51 @@
+# PlatformIO extra script: size budget check after every link, and a
+# "size_report" target for the full per-library/per-symbol breakdown.
+#
+#   pio run                     # fails if a custom_budget_* limit is exceeded
+#   pio run -t size_report      # full report, JSON saved as size_report.json
+#
+# Budgets are set per environment in platformio.ini (custom_budget_flash,
+# custom_budget_dram, custom_budget_iram, in bytes); custom_forbidden_symbols
+# lists regexes for symbols that must not be linked. Compare two builds with
+#   tools/size_report.py --compare old/size_report.json new/size_report.json
+
+import os
+import subprocess
+
+Import("env")
+
+build_dir = env.subst("$BUILD_DIR")
+elf_path = os.path.join(build_dir, env.subst("${PROGNAME}.elf"))
+map_path = os.path.join(build_dir, env.subst("${PROGNAME}.map"))
+json_path = os.path.join(build_dir, "size_report.json")
+script = os.path.join(env.subst("$PROJECT_DIR"), "tools", "size_report.py")
+
+env.Append(LINKFLAGS=["-Wl,-Map," + map_path])
+
+
+def budget_args():
+    args = []
+    for key in ("flash", "dram", "iram"):
+        value = env.GetProjectOption("custom_budget_" + key, "")
+        if value:
+            args += ["--budget-" + key, str(int(value, 0))]
+    for pattern in env.GetProjectOption("custom_forbidden_symbols", "").split():
+        args += ["--forbid", pattern]
+    return args
+
+
+def check_budget(target, source, env):
+    return subprocess.call([env.subst("$PYTHONEXE"), script, elf_path, "--map", map_path,
+                            "--json", json_path, "--summary"] + budget_args())
+
+
+env.AddPostAction(elf_path, check_budget)
+
+env.AddCustomTarget(
+    name="size_report",
+    dependencies=elf_path,
+    actions=['"$PYTHONEXE" "%s" "%s" --map "%s" --top 40 --json "%s" %s'
+             % (script, elf_path, map_path, json_path, " ".join(budget_args()))],
+    title="Size Report",
+    description="Per-library and per-symbol flash/DRAM/IRAM usage with budget check",
+)
@@ -0,0 +1,421 @@
+// Objective quality check of the firmware audio chain (AudioChain) on the host.
+//
+// Pushes test signals through the chain exactly as read_data_stream() does
+// (16-bit stereo, packet by packet) and analyses the steady-state output with
+// a Blackman-Harris windowed FFT:
+//
+//   thd_n_db           1 kHz at -6 dBFS, everything but the fundamental (20 Hz-20 kHz)
+//   snr_db             same capture, fundamental against noise with harmonics 2-10 removed
+//   response_dev_db    31 log-spaced tones 20 Hz-20 kHz (multitone), spread of gain relative to 1 kHz
+//   crosstalk_db       1 kHz in one channel, level leaking into the other (worst direction)
+//   noise_gain_db      white noise at -20 dBFS RMS, output / input RMS
+//   sweep_peak_dbfs    exponential 20 Hz-20 kHz sweep at -6 dBFS, output peak
+//   clipped_samples    samples saturated by the chain over all signals
+//
+// Inputs are TPDF dithered so 16-bit quantization shows up as noise, not
+// harmonics. Results are compared against the thresholds file and written
+// as JSON together with the run time; the exit status is 1 when a threshold
+// is missed.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/sim/audio_quality.cpp src/AudioPipeline.cpp src/AudioChain.cpp src/Biquad.cpp src/VirtualBass.cpp src/StereoWidth.cpp src/FirStage.cpp src/Convolver.cpp src/RealFft.cpp src/SpeakerProtection.cpp src/LoudnessMeter.cpp src/ChannelAlign.cpp src/EqPresets.cpp src/EqStage.cpp src/NoiseGate.cpp -o audio_quality
+//   ./audio_quality [--thresholds tools/sim/audio_quality.thresholds] [--json quality.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <complex>
+#include <string>
+#include <vector>
+#include "AudioChain.h"
+
+static const double SAMPLE_RATE = 44100;
+static const size_t FFT_SIZE = 32768;
+static const size_t SETTLE_FRAMES = 22050;     // discarded while filters settle
+static const size_t PACKET_FRAMES = 1024;      // 4096-byte A2DP packets
+static const int GUARD_BINS = 6;               // window main lobe plus margin
+
+typedef std::complex<double> Complex;
+
+struct Lcg {
+    uint32_t state = 1;
+    double uniform() {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 16777216.0;
+    }
+};
+
+struct Stereo {
+    std::vector<double> left, right;
+};
+
+static void fft(std::vector<Complex>& a) {
+    size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(a[i], a[j]);
+        }
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        Complex w(cos(-2 * M_PI / len), sin(-2 * M_PI / len));
+        for (size_t i = 0; i < n; i += len) {
+            Complex wk(1);
+            for (size_t k = 0; k < len / 2; k++) {
+                Complex u = a[i + k], v = a[i + k + len / 2] * wk;
+                a[i + k] = u + v;
+                a[i + k + len / 2] = u - v;
+                wk *= w;
+            }
+        }
+    }
+}
+
+// Power spectrum of the last FFT_SIZE samples
+static std::vector<double> spectrum(const std::vector<double>& x) {
+    std::vector<Complex> a(FFT_SIZE);
+    size_t offset = x.size() - FFT_SIZE;
+    for (size_t i = 0; i < FFT_SIZE; i++) {
+        double t = 2 * M_PI * i / (FFT_SIZE - 1);
+        double w = 0.35875 - 0.48829 * cos(t) + 0.14128 * cos(2 * t) - 0.01168 * cos(3 * t);
+        a[i] = x[offset + i] * w;
+    }
+    fft(a);
+    std::vector<double> p(FFT_SIZE / 2);
+    for (size_t i = 0; i < p.size(); i++) {
+        p[i] = std::norm(a[i]);
+    }
+    return p;
+}
+
+static size_t binOf(double hz) {
+    return (size_t)llround(hz * FFT_SIZE / SAMPLE_RATE);
+}
+
+static double binHz(size_t bin) {
+    return bin * SAMPLE_RATE / FFT_SIZE;
+}
+
+static double bandPower(const std::vector<double>& p, size_t center) {
+    double sum = 0;
+    for (size_t i = center > (size_t)GUARD_BINS ? center - GUARD_BINS : 0; i <= center + GUARD_BINS && i < p.size(); i++) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+static double db(double ratio) {
+    return ratio > 1e-20 ? 10 * log10(ratio) : -200;
+}
+
+// Quantize with TPDF dither, run through the chain packet by packet, return the output
+static Stereo process(const Stereo& in, uint32_t& clipped) {
+    AudioPipeline& chain = audioChain();
+    chain.reset();
+    uint32_t clippedBefore = chain.clippedSamples();
+    size_t frames = in.left.size();
+    std::vector<int16_t> pcm(frames * 2);
+    Lcg rng;
+    for (size_t i = 0; i < frames; i++) {
+        for (int c = 0; c < 2; c++) {
+            double x = (c ? in.right[i] : in.left[i]) * 32768.0 + rng.uniform() - rng.uniform();
+            long v = lround(x);
+            pcm[2 * i + c] = (int16_t)(v > 32767 ? 32767 : v < -32768 ? -32768 : v);
+        }
+    }
+    for (size_t pos = 0; pos < frames; pos += PACKET_FRAMES) {
+        size_t n = frames - pos < PACKET_FRAMES ? frames - pos : PACKET_FRAMES;
+        chain.process(&pcm[pos * 2], &pcm[pos * 2], n);
+    }
+    clipped += chain.clippedSamples() - clippedBefore;
+
+    Stereo out;
+    out.left.resize(frames);
+    out.right.resize(frames);
+    for (size_t i = 0; i < frames; i++) {
+        out.left[i] = pcm[2 * i] / 32768.0;
+        out.right[i] = pcm[2 * i + 1] / 32768.0;
+    }
+    return out;
+}
+
+static Stereo sine(double hz, double dbfs, bool left, bool right) {
+    size_t frames = SETTLE_FRAMES + FFT_SIZE;
+    double amplitude = pow(10, dbfs / 20);
+    Stereo s;
+    s.left.resize(frames);
+    s.right.resize(frames);
+    for (size_t i = 0; i < frames; i++) {
+        double x = amplitude * sin(2 * M_PI * hz * i / SAMPLE_RATE);
+        s.left[i] = left ? x : 0;
+        s.right[i] = right ? x : 0;
+    }
+    return s;
+}
+
+struct Metrics {
+    double thdN = 0, snr = 0, responseDev = 0, crosstalk = -200, noiseGain = 0, sweepPeak = -200;
+    uint32_t clipped = 0;
+    std::vector<std::pair<double, double>> response;    // Hz, dB relative to 1 kHz
+};
+
+static void measureDistortion(Metrics& m) {
+    size_t f0 = binOf(1000);
+    Stereo out = process(sine(binHz(f0), -6, true, true), m.clipped);
+    double worstThdN = -200, worstSnr = 200;
+    for (const std::vector<double>* ch : { &out.left, &out.right }) {
+        std::vector<double> p = spectrum(*ch);
+        double fundamental = bandPower(p, f0);
+        double total = 0, harmonics = 0;
+        for (size_t i = binOf(20); i <= binOf(20000); i++) {
+            total += p[i];
+        }
+        for (int h = 2; h <= 10 && f0 * h <= binOf(20000); h++) {
+            harmonics += bandPower(p, f0 * h);
+        }
+        double thdN = db((total - fundamental) / fundamental);
+        double snr = db(fundamental / (total - fundamental - harmonics));
+        worstThdN = thdN > worstThdN ? thdN : worstThdN;
+        worstSnr = snr < worstSnr ? snr : worstSnr;
+    }
+    m.thdN = worstThdN;
+    m.snr = worstSnr;
+}
+
+static void measureResponse(Metrics& m) {
+    const int tones = 31;
+    std::vector<size_t> bins;
+    for (int t = 0; t < tones; t++) {
+        size_t bin = binOf(20 * pow(1000.0, (double)t / (tones - 1)));
+        // Keep tones apart by more than the window main lobe
+        if (bins.empty() || bin > bins.back() + 2 * GUARD_BINS) {
+            bins.push_back(bin);
+        }
+    }
+
+    size_t frames = SETTLE_FRAMES + FFT_SIZE;
+    Stereo in;
+    in.left.assign(frames, 0);
+    Lcg rng;
+    for (size_t bin : bins) {
+        double phase = 2 * M_PI * rng.uniform();
+        for (size_t i = 0; i < frames; i++) {
+            in.left[i] += sin(2 * M_PI * binHz(bin) * i / SAMPLE_RATE + phase);
+        }
+    }
+    double peak = 0;
+    for (double x : in.left) {
+        peak = fabs(x) > peak ? fabs(x) : peak;
+    }
+    for (double& x : in.left) {
+        x *= 0.5 / peak;    // -6 dBFS peak
+    }
+    in.right = in.left;
+
+    Stereo out = process(in, m.clipped);
+    std::vector<double> pin = spectrum(in.left);
+    std::vector<double> pl = spectrum(out.left);
+    std::vector<double> pr = spectrum(out.right);
+
+    std::vector<std::pair<size_t, double>> gains;
+    size_t closest = 0;
+    for (size_t bin : bins) {
+        // Worse of the two channels
+        double gl = db(bandPower(pl, bin) / bandPower(pin, bin));
+        double gr = db(bandPower(pr, bin) / bandPower(pin, bin));
+        gains.push_back({ bin, fabs(gl) > fabs(gr) ? gl : gr });
+        // Reference: the tone closest to 1 kHz
+        if (fabs(binHz(bin) - 1000) < fabs(binHz(gains[closest].first) - 1000)) {
+            closest = gains.size() - 1;
+        }
+    }
+    double reference = gains[closest].second, lo = 1e9, hi = -1e9;
+    for (auto& g : gains) {
+        double rel = g.second - reference;
+        m.response.push_back({ binHz(g.first), rel });
+        lo = rel < lo ? rel : lo;
+        hi = rel > hi ? rel : hi;
+    }
+    m.responseDev = hi - lo;
+}
+
+static void measureCrosstalk(Metrics& m) {
+    size_t f0 = binOf(1000);
+    for (int side = 0; side < 2; side++) {
+        Stereo out = process(sine(binHz(f0), -6, side == 0, side == 1), m.clipped);
+        std::vector<double> driven = spectrum(side == 0 ? out.left : out.right);
+        std::vector<double> idle = spectrum(side == 0 ? out.right : out.left);
+        double leak = db(bandPower(idle, f0) / bandPower(driven, f0));
+        m.crosstalk = leak > m.crosstalk ? leak : m.crosstalk;
+    }
+}
+
+static void measureNoise(Metrics& m) {
+    size_t frames = SETTLE_FRAMES + FFT_SIZE;
+    Stereo in;
+    in.left.resize(frames);
+    in.right.resize(frames);
+    Lcg rng;
+    double rms = pow(10, -20 / 20.0);
+    for (size_t i = 0; i < frames; i++) {
+        // Sum of uniforms, close enough to Gaussian for a level check
+        double l = 0, r = 0;
+        for (int k = 0; k < 4; k++) {
+            l += rng.uniform() - 0.5;
+            r += rng.uniform() - 0.5;
+        }
+        in.left[i] = l * rms * sqrt(3.0);
+        in.right[i] = r * rms * sqrt(3.0);
+    }
+    Stereo out = process(in, m.clipped);
+    double pin = 0, pout = 0;
+    for (size_t i = SETTLE_FRAMES; i < frames; i++) {
+        pin += in.left[i] * in.left[i] + in.right[i] * in.right[i];
+        pout += out.left[i] * out.left[i] + out.right[i] * out.right[i];
+    }
+    m.noiseGain = db(pout / pin);
+}
+
+static void measureSweep(Metrics& m) {
+    size_t frames = (size_t)(5 * SAMPLE_RATE);
+    double k = log(20000.0 / 20.0);
+    double amplitude = pow(10, -6 / 20.0);
+    Stereo in;
+    in.left.resize(frames);
+    for (size_t i = 0; i < frames; i++) {
+        double t = (double)i / frames;
+        double phase = 2 * M_PI * 20 * (frames / SAMPLE_RATE) / k * (exp(k * t) - 1);
+        in.left[i] = amplitude * sin(phase);
+    }
+    in.right = in.left;
+    Stereo out = process(in, m.clipped);
+    double peak = 0;
+    for (size_t i = 0; i < frames; i++) {
+        peak = fabs(out.left[i]) > peak ? fabs(out.left[i]) : peak;
+        peak = fabs(out.right[i]) > peak ? fabs(out.right[i]) : peak;
+    }
+    m.sweepPeak = 20 * log10(peak > 1e-10 ? peak : 1e-10);
+}
+
+struct Threshold {
+    std::string name;
+    bool isMax;     // name_max: value must not exceed; name_min: must not fall below
+    double limit;
+};
+
+static bool loadThresholds(const char* path, std::vector<Threshold>& out) {
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) {
+        perror(path);
+        return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        char key[128];
+        double value;
+        if (line[0] == '#' || sscanf(line, "%127s %lf", key, &value) != 2) {
+            continue;
+        }
+        std::string k = key;
+        if (k.size() > 4 && (k.compare(k.size() - 4, 4, "_max") == 0 || k.compare(k.size() - 4, 4, "_min") == 0)) {
+            out.push_back({ k.substr(0, k.size() - 4), k.compare(k.size() - 4, 4, "_max") == 0, value });
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* thresholdsPath = "tools/sim/audio_quality.thresholds";
+    const char* jsonPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--thresholds") && i + 1 < argc) thresholdsPath = argv[++i];
+        else if (!strcmp(argv[i], "--json") && i + 1 < argc) jsonPath = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--thresholds FILE] [--json FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    std::vector<Threshold> thresholds;
+    if (!loadThresholds(thresholdsPath, thresholds)) {
+        return 2;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    audioChainBegin((uint32_t)SAMPLE_RATE);
+    Metrics m;
+    measureDistortion(m);
+    measureResponse(m);
+    measureCrosstalk(m);
+    measureNoise(m);
+    measureSweep(m);
+    double runtime = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const std::pair<const char*, double> values[] = {
+        { "thd_n_db", m.thdN }, { "snr_db", m.snr }, { "response_dev_db", m.responseDev },
+        { "crosstalk_db", m.crosstalk }, { "noise_gain_db", m.noiseGain }, { "sweep_peak_dbfs", m.sweepPeak },
+        { "clipped_samples", (double)m.clipped },
+    };
+
+    AudioPipeline& chain = audioChain();
+    printf("chain:");
+    for (int i = 0; i < chain.count(); i++) {
+        printf(" %s%s", chain.stage(i)->name(), chain.stage(i)->enabled ? "" : "(off)");
+    }
+    printf(chain.count() ? "\n" : " (empty)\n");
+
+    bool pass = true;
+    std::string failures;
+    for (const auto& v : values) {
+        const char* verdict = "";
+        for (const Threshold& t : thresholds) {
+            if (t.name == v.first) {
+                bool ok = t.isMax ? v.second <= t.limit : v.second >= t.limit;
+                verdict = ok ? "ok" : "FAIL";
+                if (!ok) {
+                    pass = false;
+                    failures += (failures.empty() ? "\"" : ", \"") + t.name + "\"";
+                }
+                printf("%-16s %9.2f   %s %7.2f  %s\n", v.first, v.second, t.isMax ? "<=" : ">=", t.limit, verdict);
+            }
+        }
+        if (!*verdict) {
+            printf("%-16s %9.2f\n", v.first, v.second);
+        }
+    }
+    printf("runtime          %9.2f s\n", runtime);
+
+    if (jsonPath != nullptr) {
+        FILE* f = fopen(jsonPath, "w");
+        if (f == nullptr) {
+            perror(jsonPath);
+            return 2;
+        }
+        fprintf(f, "{\n \"chain\": [");
+        for (int i = 0; i < chain.count(); i++) {
+            fprintf(f, "%s{\"name\": \"%s\", \"enabled\": %s}", i ? ", " : "", chain.stage(i)->name(),
+                    chain.stage(i)->enabled ? "true" : "false");
+        }
+        fprintf(f, "],\n \"runtime_s\": %.3f,\n \"metrics\": {", runtime);
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            fprintf(f, "%s\"%s\": %.3f", i ? ", " : "", values[i].first, values[i].second);
+        }
+        fprintf(f, "},\n \"response\": [");
+        for (size_t i = 0; i < m.response.size(); i++) {
+            fprintf(f, "%s[%.1f, %.3f]", i ? ", " : "", m.response[i].first, m.response[i].second);
+        }
+        fprintf(f, "],\n \"thresholds\": {");
+        for (size_t i = 0; i < thresholds.size(); i++) {
+            fprintf(f, "%s\"%s_%s\": %.3f", i ? ", " : "", thresholds[i].name.c_str(),
+                    thresholds[i].isMax ? "max" : "min", thresholds[i].limit);
+        }
+        fprintf(f, "},\n \"failures\": [%s],\n \"pass\": %s\n}\n", failures.c_str(), pass ? "true" : "false");
+        fclose(f);
+    }
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,320 @@
+// Offline run of the firmware audio path: WAV in, processed WAV out.
+//
+// A simulated A2DP source cuts the input into data-callback sized packets and
+// delivers them on a virtual clock, ahead of playback by the phone's initial
+// burst, with jitter and optional stalls; each
+// packet goes through the same AudioChain as read_data_stream(), in the same
+// block sizes, into a simulated I2S DMA queue that drains at the sample rate
+// and blocks the writer when full, as i2s.write() does. Processing time is
+// measured on the host and charged to the virtual clock scaled by --cpu-factor
+// (roughly 10 for an ESP32 at 240 MHz against a desktop core).
+//
+// Reports the real-time factor, worst and mean time per block, the lowest
+// DMA queue level and the underruns the timeline produced.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/sim/audio_sim.cpp src/AudioPipeline.cpp src/AudioChain.cpp src/Biquad.cpp src/VirtualBass.cpp src/StereoWidth.cpp src/FirStage.cpp src/Convolver.cpp src/RealFft.cpp src/SpeakerProtection.cpp src/LoudnessMeter.cpp src/ChannelAlign.cpp src/EqPresets.cpp src/EqStage.cpp src/NoiseGate.cpp -o audio_sim
+//   ./audio_sim in.wav out.wav [--packet 4096] [--burst 100] [--jitter 5] [--stall-every 10 --stall 150]
+//               [--buffers 8] [--buffer-size 512 (frames)] [--cpu-factor 10]
+//   ./audio_sim --tone 30 out.wav          # 30 s test tone instead of an input file
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "AudioChain.h"
+#include "BtMemory.h"
+
+struct Wav {
+    uint32_t sampleRate = 44100;
+    std::vector<int16_t> samples;   // interleaved stereo
+};
+
+static uint32_t readLe(const uint8_t* p, int bytes) {
+    uint32_t v = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static bool readWav(const char* path, Wav& wav) {
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) {
+        perror(path);
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+
+    if (data.size() < 12 || memcmp(&data[0], "RIFF", 4) != 0 || memcmp(&data[8], "WAVE", 4) != 0) {
+        fprintf(stderr, "%s: not a RIFF/WAVE file\n", path);
+        return false;
+    }
+    int channels = 0, bits = 0;
+    size_t pos = 12;
+    while (pos + 8 <= data.size()) {
+        uint32_t size = readLe(&data[pos + 4], 4);
+        const uint8_t* body = &data[pos + 8];
+        size_t avail = data.size() - pos - 8;
+        if (size > avail) {
+            size = (uint32_t)avail;
+        }
+        if (memcmp(&data[pos], "fmt ", 4) == 0 && size >= 16) {
+            if (readLe(body, 2) != 1) {
+                fprintf(stderr, "%s: only PCM is supported\n", path);
+                return false;
+            }
+            channels = readLe(body + 2, 2);
+            wav.sampleRate = readLe(body + 4, 4);
+            bits = readLe(body + 14, 2);
+        } else if (memcmp(&data[pos], "data", 4) == 0) {
+            if (bits != 16 || (channels != 1 && channels != 2)) {
+                fprintf(stderr, "%s: need 16-bit mono or stereo\n", path);
+                return false;
+            }
+            size_t frames = size / (2 * channels);
+            wav.samples.resize(frames * 2);
+            for (size_t i = 0; i < frames; i++) {
+                int16_t l = (int16_t)readLe(body + i * 2 * channels, 2);
+                int16_t r = channels == 2 ? (int16_t)readLe(body + i * 4 + 2, 2) : l;
+                wav.samples[2 * i] = l;
+                wav.samples[2 * i + 1] = r;
+            }
+            return true;
+        }
+        pos += 8 + size + (size & 1);
+    }
+    fprintf(stderr, "%s: no data chunk\n", path);
+    return false;
+}
+
+static void putLe(FILE* f, uint32_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        fputc((v >> (8 * i)) & 0xFF, f);
+    }
+}
+
+static bool writeWav(const char* path, const Wav& wav) {
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) {
+        perror(path);
+        return false;
+    }
+    uint32_t dataBytes = (uint32_t)(wav.samples.size() * 2);
+    fwrite("RIFF", 1, 4, f);
+    putLe(f, 36 + dataBytes, 4);
+    fwrite("WAVEfmt ", 1, 8, f);
+    putLe(f, 16, 4);
+    putLe(f, 1, 2);
+    putLe(f, 2, 2);
+    putLe(f, wav.sampleRate, 4);
+    putLe(f, wav.sampleRate * 4, 4);
+    putLe(f, 4, 2);
+    putLe(f, 16, 2);
+    fwrite("data", 1, 4, f);
+    putLe(f, dataBytes, 4);
+    for (int16_t s : wav.samples) {
+        putLe(f, (uint16_t)s, 2);
+    }
+    fclose(f);
+    return true;
+}
+
+static void makeTone(Wav& wav, double seconds) {
+    size_t frames = (size_t)(seconds * wav.sampleRate);
+    wav.samples.resize(frames * 2);
+    for (size_t i = 0; i < frames; i++) {
+        double t = (double)i / wav.sampleRate;
+        // Bass plus a slow sweep across the midrange, -6 dBFS peak
+        double sweep = 200.0 * pow(40.0, fmod(t, 10.0) / 10.0);
+        double x = 0.25 * sin(2 * M_PI * 60.0 * t) + 0.25 * sin(2 * M_PI * sweep * t);
+        wav.samples[2 * i] = (int16_t)(x * 32767);
+        wav.samples[2 * i + 1] = (int16_t)(x * 32767);
+    }
+}
+
+// Deterministic jitter source, same timeline on every run
+struct Lcg {
+    uint32_t state = 12345;
+    double next() {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 16777216.0;
+    }
+};
+
+// I2S DMA queue: drains continuously at the byte rate once started; a write
+// that does not fit blocks until enough has drained
+struct DmaModel {
+    double capacity;
+    double byteRate;
+    double level = 0;
+    double clock = 0;           // time of the last update, us
+    bool running = false;
+    uint32_t underruns = 0;
+    double silentUs = 0;
+    double minLevel = -1;
+
+    void drain(double now) {
+        if (running) {
+            double drained = (now - clock) * byteRate / 1e6;
+            if (drained > level) {
+                underruns++;
+                silentUs += (drained - level) / byteRate * 1e6;
+                level = 0;
+                running = false;
+            } else {
+                level -= drained;
+            }
+        }
+        clock = now;
+    }
+
+    // Returns the time the write completes
+    double write(double now, double bytes) {
+        drain(now);
+        if (running && (minLevel < 0 || level < minLevel)) {
+            minLevel = level;
+        }
+        double done = now;
+        if (level + bytes > capacity) {
+            done += (level + bytes - capacity) / byteRate * 1e6;
+            drain(done);
+        }
+        level += bytes;
+        running = true;
+        return done;
+    }
+};
+
+int main(int argc, char** argv) {
+    const char* inPath = nullptr;
+    const char* outPath = nullptr;
+    double toneSeconds = 0;
+    uint32_t packetBytes = 4096;
+    double burstMs = 100;
+    double jitterMs = 5;
+    double stallEverySec = 0;
+    double stallMs = 0;
+    int buffers = 8;
+    int bufferFrames = AUDIO_DMA_BUFFER_FRAMES;
+    double cpuFactor = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(a, "--tone") && hasValue) toneSeconds = atof(argv[++i]);
+        else if (!strcmp(a, "--packet") && hasValue) packetBytes = (uint32_t)atoi(argv[++i]) & ~3u;
+        else if (!strcmp(a, "--burst") && hasValue) burstMs = atof(argv[++i]);
+        else if (!strcmp(a, "--jitter") && hasValue) jitterMs = atof(argv[++i]);
+        else if (!strcmp(a, "--stall-every") && hasValue) stallEverySec = atof(argv[++i]);
+        else if (!strcmp(a, "--stall") && hasValue) stallMs = atof(argv[++i]);
+        else if (!strcmp(a, "--buffers") && hasValue) buffers = atoi(argv[++i]);
+        else if (!strcmp(a, "--buffer-size") && hasValue) bufferFrames = atoi(argv[++i]);
+        else if (!strcmp(a, "--cpu-factor") && hasValue) cpuFactor = atof(argv[++i]);
+        else if (a[0] != '-' && inPath == nullptr && toneSeconds == 0) inPath = a;
+        else if (a[0] != '-' && outPath == nullptr) outPath = a;
+        else {
+            fprintf(stderr, "usage: %s in.wav|--tone SECONDS out.wav [options], see source header\n", argv[0]);
+            return 2;
+        }
+    }
+    if (outPath == nullptr || (inPath == nullptr && toneSeconds <= 0) || packetBytes == 0) {
+        fprintf(stderr, "usage: %s in.wav|--tone SECONDS out.wav [options], see source header\n", argv[0]);
+        return 2;
+    }
+
+    Wav in;
+    if (inPath != nullptr) {
+        if (!readWav(inPath, in)) {
+            return 1;
+        }
+    } else {
+        makeTone(in, toneSeconds);
+    }
+    Wav out;
+    out.sampleRate = in.sampleRate;
+    out.samples.resize(in.samples.size());
+
+    audioChainBegin(in.sampleRate);
+    AudioPipeline& chain = audioChain();
+
+    DmaModel dma;
+    dma.capacity = (double)buffers * bufferFrames * AUDIO_FRAME_BYTES;
+    dma.byteRate = in.sampleRate * 4.0;
+
+    Lcg rng;
+    const size_t totalFrames = in.samples.size() / 2;
+    const size_t packetFrames = packetBytes / 4;
+    double busyUntil = 0;           // the data callback runs on one task
+    double nextStall = stallEverySec > 0 ? stallEverySec * 1e6 : -1;
+    double stallDelay = 0;
+    double worstBlockUs = 0;
+    double totalProcessUs = 0;
+    uint64_t blocks = 0;
+
+    for (size_t pos = 0; pos < totalFrames; pos += packetFrames) {
+        size_t frames = totalFrames - pos < packetFrames ? totalFrames - pos : packetFrames;
+
+        // Packets leave the phone at the media rate, the first burstMs of
+        // audio at once, and arrive late by jitter plus the accumulated delay
+        // of any stall (the phone then catches up)
+        double media = (double)pos / in.sampleRate * 1e6;
+        if (nextStall >= 0 && media >= nextStall) {
+            stallDelay += stallMs * 1000;
+            nextStall += stallEverySec * 1e6;
+        }
+        double nominal = media > burstMs * 1000 ? media - burstMs * 1000 : 0;
+        double arrival = nominal + rng.next() * jitterMs * 1000;
+        if (stallDelay > 0) {
+            double caughtUp = stallDelay < 20000 ? stallDelay : 20000;
+            arrival += stallDelay;
+            stallDelay -= caughtUp;     // the phone flushes its backlog in bursts
+        }
+        double now = arrival > busyUntil ? arrival : busyUntil;
+
+        // Same block loop as read_data_stream()
+        const int16_t* src = &in.samples[pos * 2];
+        int16_t* dst = &out.samples[pos * 2];
+        for (size_t done = 0; done < frames; done += AUDIO_BLOCK_FRAMES) {
+            size_t n = frames - done < AUDIO_BLOCK_FRAMES ? frames - done : AUDIO_BLOCK_FRAMES;
+            auto t0 = std::chrono::steady_clock::now();
+            chain.process(src + done * 2, dst + done * 2, n);
+            auto t1 = std::chrono::steady_clock::now();
+            double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+            totalProcessUs += us;
+            worstBlockUs = us > worstBlockUs ? us : worstBlockUs;
+            blocks++;
+            now = dma.write(now + us * cpuFactor, n * 4.0);
+        }
+        busyUntil = now;
+    }
+
+    if (!writeWav(outPath, out)) {
+        return 1;
+    }
+
+    double audioSeconds = (double)totalFrames / in.sampleRate;
+    printf("audio          %.2f s at %lu Hz, %d stage(s) in the chain\n", audioSeconds,
+           (unsigned long)in.sampleRate, chain.count());
+    printf("packets        %lu bytes, %.0f ms burst, jitter %.1f ms", (unsigned long)packetBytes, burstMs, jitterMs);
+    if (stallEverySec > 0) {
+        printf(", %.0f ms stall every %.1f s", stallMs, stallEverySec);
+    }
+    printf("\nDMA queue      %d x %d frames (%.1f ms), lowest %.1f ms\n", buffers, bufferFrames,
+           dma.capacity / dma.byteRate * 1000, (dma.minLevel < 0 ? 0 : dma.minLevel) / dma.byteRate * 1000);
+    printf("processing     %.3f s host, real-time factor %.1fx\n", totalProcessUs / 1e6,
+           totalProcessUs > 0 ? audioSeconds * 1e6 / totalProcessUs : 0.0);
+    printf("per block      %lu blocks of <= %d frames, mean %.2f us, worst %.2f us (budget %.0f us)\n",
+           (unsigned long)blocks, AUDIO_BLOCK_FRAMES, blocks ? totalProcessUs / blocks : 0.0, worstBlockUs,
+           AUDIO_BLOCK_FRAMES * 1e6 / in.sampleRate);
+    printf("underruns      %lu, %.1f ms of silence\n", (unsigned long)dma.underruns, dma.silentUs / 1000);
+    printf("clipped        %lu samples\n", (unsigned long)chain.clippedSamples());
+    return 0;
+}
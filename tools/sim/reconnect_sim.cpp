@@ -0,0 +1,129 @@
+// Host simulation of ReconnectPolicy against a fake Bluetooth link.
+//
+// Two remembered phones; the primary one leaves range for a while and comes
+// back, the other one stays away. A page succeeds after a short latency if the
+// target phone is in range; a phone in range also retries on its own every
+// few seconds and gets through whenever the speaker is connectable. Each
+// policy is run over the same timeline and reports reconnect time, attempts
+// and how long the radio was busy while disconnected.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/sim/reconnect_sim.cpp src/ReconnectPolicy.cpp -o reconnect_sim && ./reconnect_sim
+
+#include <stdio.h>
+#include "ReconnectPolicy.h"
+
+struct FakePhone {
+    uint32_t leavesAt;
+    uint32_t returnsAt;
+    uint32_t retryPeriodMs;     // phone-initiated reconnect attempts while in range
+
+    bool inRange(uint32_t t) const { return t < leavesAt || t >= returnsAt; }
+};
+
+struct Scenario {
+    const char* name;
+    FakePhone phones[2];
+    uint32_t durationMs;
+};
+
+struct PolicyCase {
+    const char* name;
+    ReconnectConfig config;
+};
+
+static const uint32_t STEP_MS = 50;
+static const uint32_t PAGE_LATENCY_MS = 1200;
+
+static void run(const Scenario& scenario, const PolicyCase& policyCase) {
+    ReconnectPolicy policy(policyCase.config);
+    const int knownDevices = 2;
+    int connectedTo = 0;            // start connected to the primary phone
+    int paging = -1;
+    uint32_t pageStart = 0;
+    bool reconnectedAfterReturn = false;
+    uint32_t returnToReconnect = 0;
+
+    for (uint32_t t = 0; t < scenario.durationMs; t += STEP_MS) {
+        // Link loss when the connected phone walks away
+        if (connectedTo >= 0 && !scenario.phones[connectedTo].inRange(t)) {
+            connectedTo = -1;
+            paging = -1;
+            policy.onDisconnected(t);
+        }
+
+        if (connectedTo < 0) {
+            int index = policy.poll(t, knownDevices);
+            if (index >= 0) {
+                paging = index;
+                pageStart = t;
+            }
+            if (!policy.isPaging()) {
+                paging = -1;
+            }
+
+            // Our page gets through after the latency if the phone is in range
+            if (paging >= 0 && t - pageStart >= PAGE_LATENCY_MS && scenario.phones[paging].inRange(t)) {
+                connectedTo = paging;
+            }
+
+            // Phone-initiated reconnect while we are connectable
+            for (int p = 0; p < knownDevices && connectedTo < 0; p++) {
+                const FakePhone& phone = scenario.phones[p];
+                if (phone.inRange(t) && t > phone.returnsAt && (t - phone.returnsAt) % phone.retryPeriodMs == 0 &&
+                    policy.radioMode(t).connectable) {
+                    connectedTo = p;
+                }
+            }
+
+            if (connectedTo >= 0) {
+                policy.onConnected(t);
+                paging = -1;
+                if (!reconnectedAfterReturn && t >= scenario.phones[0].returnsAt) {
+                    reconnectedAfterReturn = true;
+                    returnToReconnect = t - scenario.phones[0].returnsAt;
+                }
+            }
+        }
+    }
+
+    const ReconnectStats& st = policy.stats();
+    double busyPct = st.disconnectedMs ? 100.0 * st.radioBusyMs / st.disconnectedMs : 0.0;
+    printf("  %-14s reconnect after return %6.1f s | attempts %4lu timeouts %4lu | radio busy %5.1f%% of %6.1f s\n",
+           policyCase.name, reconnectedAfterReturn ? returnToReconnect / 1000.0 : -1.0, (unsigned long)st.attempts, (unsigned long)st.timeouts,
+           busyPct, st.disconnectedMs / 1000.0);
+}
+
+int main() {
+    ReconnectConfig aggressive;
+    aggressive.initialBackoffMs = 0;
+    aggressive.maxBackoffMs = 0;
+    aggressive.discoverableMs = UINT32_MAX;
+
+    ReconnectConfig standard;
+
+    ReconnectConfig saver;
+    saver.initialBackoffMs = 10000;
+    saver.maxBackoffMs = 300000;
+    saver.discoverableMs = 30000;
+    saver.maxScanDutyPct = 10;
+
+    const PolicyCase policies[] = {
+        { "aggressive", aggressive },
+        { "default", standard },
+        { "battery saver", saver },
+    };
+
+    const Scenario scenarios[] = {
+        { "short walk (away 90 s)", { { 60000, 150000, 10000 }, { 0, UINT32_MAX, 10000 } }, 600000 },
+        { "long absence (away 20 min)", { { 60000, 1260000, 10000 }, { 0, UINT32_MAX, 10000 } }, 1800000 },
+        { "phone never retries (away 5 min)", { { 60000, 360000, UINT32_MAX }, { 0, UINT32_MAX, UINT32_MAX } }, 900000 },
+    };
+
+    for (const Scenario& scenario : scenarios) {
+        printf("%s\n", scenario.name);
+        for (const PolicyCase& policy : policies) {
+            run(scenario, policy);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,286 @@
+// Deterministic replay of an on-device event capture against the Player logic.
+//
+// Reads the CAPTURE-BEGIN ... CAPTURE-END block of a serial log ("capture
+// dump"), restores the captured starting state and feeds every event to the
+// same handlers the firmware calls, on a virtual clock: between events the
+// button levels are polled every 50 ms like loop() does, so long presses
+// resolve the same way. After each event the player state is hashed into a
+// running digest; the replay runs twice and must produce the same digest,
+// and --expect compares the final one against a known-good value.
+// Handler cost is measured per event type.
+//
+//   g++ -O2 -std=gnu++17 -Iinclude tools/sim/replay.cpp src/Player.cpp src/EventLog.cpp -o replay
+//   ./replay capture.log [--verbose] [--expect DIGEST]
+//
+// tools/sim/captures/session.log is a short scripted session; a change to the
+// Player logic that alters its outcome shows up as a digest mismatch:
+//
+//   ./replay tools/sim/captures/session.log --expect 82a719a9ba226981
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Player.h"
+#include "EventLog.h"
+
+#define POLL_INTERVAL_US    50000   // handleButtons() cadence in loop()
+
+static const char* const actionNames[] = {
+    "-", "set-volume", "play", "pause", "stop", "next-track", "previous-track",
+    "next-page", "select-next", "select-previous", "connect-selected",
+    "signal-next", "signal-previous", "signal-toggle", "next-eq-preset",
+};
+
+struct HandlerCost {
+    uint32_t calls = 0;
+    double totalNs = 0;
+    double worstNs = 0;
+};
+
+struct ReplayResult {
+    uint64_t digest = 0;
+    uint32_t events = 0;
+    uint32_t actions = 0;
+    double durationUs = 0;
+    PlayerState state;
+    HandlerCost cost[EVENT_TYPE_COUNT];
+};
+
+static bool readCapture(const char* path, std::vector<uint8_t>& bytes) {
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) {
+        perror(path);
+        return false;
+    }
+    char line[512];
+    bool inBlock = false;
+    bool found = false;
+    std::vector<uint8_t> current;
+    while (fgets(line, sizeof(line), f)) {
+        char* text = line;
+        while (*text == ' ' || *text == '\t') {
+            text++;
+        }
+        if (strncmp(text, "CAPTURE-BEGIN", 13) == 0) {
+            inBlock = true;
+            current.clear();
+        } else if (strncmp(text, "CAPTURE-END", 11) == 0 && inBlock) {
+            // Keep the last block in the log
+            bytes = current;
+            inBlock = false;
+            found = true;
+        } else if (inBlock && text[0] == 'C' && text[1] == ' ') {
+            for (char* p = text + 2; p[0] && p[1] && p[0] != '\n' && p[0] != '\r'; p += 2) {
+                char hex[3] = { p[0], p[1], 0 };
+                current.push_back((uint8_t)strtoul(hex, nullptr, 16));
+            }
+        }
+    }
+    fclose(f);
+    if (!found) {
+        fprintf(stderr, "%s: no CAPTURE-BEGIN/CAPTURE-END block\n", path);
+    }
+    return found;
+}
+
+// FNV-1a over the state, chained through every event
+static uint64_t hashState(uint64_t hash, const PlayerState& state) {
+    const uint8_t* p = (const uint8_t*)&state;
+    for (size_t i = 0; i < sizeof(state); i++) {
+        hash = (hash ^ p[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static void printState(const PlayerState& s) {
+    printf("  connected=%d playing=%d paused=%d volume=%u page=%u\n", s.connected, s.playing, s.paused,
+           s.volume, s.page);
+    printf("  device=\"%s\"\n  title=\"%s\"\n  artist=\"%s\"\n", s.device, s.title, s.artist);
+}
+
+static bool replay(const std::vector<uint8_t>& log, bool verbose, ReplayResult& result) {
+    Player player;
+    player.begin(50);
+    bool volumeButton = false;
+    bool trackButton = false;
+    uint64_t nowUs = 0;
+    uint64_t nextPollUs = POLL_INTERVAL_US;
+    result.digest = 0xcbf29ce484222325ULL;
+
+    auto count = [&](PlayerAction action) {
+        if (action != ACTION_NONE) {
+            result.actions++;
+            if (verbose) {
+                printf("%12.3f ms  -> %s\n", nowUs / 1000.0, actionNames[action]);
+            }
+        }
+    };
+
+    size_t pos = 0;
+    bool first = true;
+    while (pos < log.size()) {
+        EventRecord e;
+        size_t n = eventLogDecode(log.data() + pos, log.size() - pos, e);
+        if (n == 0) {
+            fprintf(stderr, "malformed record at byte %zu\n", pos);
+            return false;
+        }
+        pos += n;
+
+        if (first) {
+            if (e.type != EVENT_START || e.length != 1 + sizeof(PlayerState) || e.payload[0] != EVENT_LOG_VERSION) {
+                fprintf(stderr, "capture does not start with a version %d start record\n", EVENT_LOG_VERSION);
+                return false;
+            }
+            PlayerState start;
+            memcpy(&start, e.payload + 1, sizeof(start));
+            player.restore(start);
+            first = false;
+            continue;
+        }
+
+        // Button polls that fell between the previous event and this one
+        uint64_t eventUs = nowUs + e.deltaUs;
+        while (nextPollUs < eventUs) {
+            nowUs = nextPollUs;
+            count(player.onVolumeButton(volumeButton, (uint32_t)(nowUs / 1000)));
+            count(player.onTrackButton(trackButton, (uint32_t)(nowUs / 1000)));
+            nextPollUs += POLL_INTERVAL_US;
+        }
+        nowUs = eventUs;
+
+        if (verbose) {
+            printf("%12.3f ms  %-13s", nowUs / 1000.0, eventTypeName(e.type));
+            if (e.type == EVENT_METADATA && e.length > 0) {
+                printf(" id=%u \"%.*s\"", e.payload[0], (int)e.length - 1, (const char*)e.payload + 1);
+            } else if (e.type == EVENT_DEVICE_NAME) {
+                printf(" \"%.*s\"", (int)e.length, (const char*)e.payload);
+            } else if (e.type == EVENT_AUDIO && e.length == 2) {
+                printf(" %u bytes", e.payload[0] | (e.payload[1] << 8));
+            } else if (e.length > 0) {
+                printf(" %d", e.type == EVENT_VOLUME_STEP || e.type == EVENT_TRACK_STEP ? (int8_t)e.payload[0]
+                                                                                        : e.payload[0]);
+            }
+            printf("\n");
+        }
+
+        // Text payloads are not NUL terminated in the log
+        char text[EVENT_LOG_MAX_PAYLOAD + 1];
+        PlayerAction action = ACTION_NONE;
+        uint8_t value = e.length > 0 ? e.payload[0] : 0;
+        auto t0 = std::chrono::steady_clock::now();
+        switch (e.type) {
+            case EVENT_CONNECTION:
+                player.onConnection(value);
+                break;
+            case EVENT_AUDIO:
+                player.onAudio();
+                break;
+            case EVENT_METADATA:
+                memcpy(text, e.payload + 1, e.length ? e.length - 1 : 0);
+                text[e.length ? e.length - 1 : 0] = '\0';
+                player.onMetadata(value, text);
+                break;
+            case EVENT_DEVICE_NAME:
+                memcpy(text, e.payload, e.length);
+                text[e.length] = '\0';
+                player.setDeviceName(text);
+                break;
+            case EVENT_VOLUME_SET:
+                player.setVolume(value);
+                break;
+            case EVENT_VOLUME_STEP:
+                action = player.onVolumeStep((int8_t)value);
+                break;
+            case EVENT_TRACK_STEP:
+                action = player.onTrackStep((int8_t)value);
+                break;
+            case EVENT_VOLUME_BUTTON:
+                volumeButton = value != 0;
+                action = player.onVolumeButton(volumeButton, (uint32_t)(nowUs / 1000));
+                break;
+            case EVENT_TRACK_BUTTON:
+                trackButton = value != 0;
+                action = player.onTrackButton(trackButton, (uint32_t)(nowUs / 1000));
+                break;
+            case EVENT_VOLUME_LIMIT:
+                action = player.setVolumeLimit(value);
+                break;
+            default:
+                break;
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        HandlerCost& c = result.cost[e.type];
+        c.calls++;
+        c.totalNs += ns;
+        c.worstNs = ns > c.worstNs ? ns : c.worstNs;
+
+        count(action);
+        result.events++;
+        result.digest = hashState(result.digest, player.state());
+    }
+    if (first) {
+        fprintf(stderr, "empty capture\n");
+        return false;
+    }
+    result.durationUs = (double)nowUs;
+    result.state = player.state();
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    const char* expect = nullptr;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--verbose")) verbose = true;
+        else if (!strcmp(argv[i], "--expect") && i + 1 < argc) expect = argv[++i];
+        else if (argv[i][0] != '-' && path == nullptr) path = argv[i];
+        else {
+            fprintf(stderr, "usage: %s capture.log [--verbose] [--expect DIGEST]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (path == nullptr) {
+        fprintf(stderr, "usage: %s capture.log [--verbose] [--expect DIGEST]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> log;
+    if (!readCapture(path, log)) {
+        return 1;
+    }
+    ReplayResult first, second;
+    if (!replay(log, verbose, first) || !replay(log, false, second)) {
+        return 1;
+    }
+
+    printf("replayed %u events over %.3f s, %u actions, %zu bytes\n", first.events, first.durationUs / 1e6,
+           first.actions, log.size());
+    printf("\n  %-14s %7s %10s %10s\n", "handler", "calls", "mean ns", "worst ns");
+    for (int t = 0; t < EVENT_TYPE_COUNT; t++) {
+        const HandlerCost& c = first.cost[t];
+        if (c.calls) {
+            printf("  %-14s %7u %10.1f %10.1f\n", eventTypeName(t), c.calls, c.totalNs / c.calls, c.worstNs);
+        }
+    }
+    printf("\nfinal state\n");
+    printState(first.state);
+
+    char digest[17];
+    snprintf(digest, sizeof(digest), "%016llx", (unsigned long long)first.digest);
+    printf("\ndigest %s\n", digest);
+    if (first.digest != second.digest) {
+        printf("NOT DETERMINISTIC: second run gave %016llx\n", (unsigned long long)second.digest);
+        return 1;
+    }
+    if (expect != nullptr && strcmp(expect, digest) != 0) {
+        printf("MISMATCH: expected %s\n", expect);
+        return 1;
+    }
+    return 0;
+}
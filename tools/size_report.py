@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+"""Firmware size and static RAM report for ESP32 builds.
+
+Usage:
+    tools/size_report.py firmware.elf [--map firmware.map] [--top N] [--json out.json] [--summary]
+                         [--budget-flash B] [--budget-dram B] [--budget-iram B] [--forbid REGEX ...]
+    tools/size_report.py --compare old.json|old.elf new.json|new.elf
+
+Totals and the per-symbol table come straight from the ELF, the per-library
+table from the linker map (PlatformIO builds one archive per library, so the
+A2DP stack, AudioTools, Adafruit GFX and the IDF components show up by name).
+Exits with status 1 when a budget is exceeded or a symbol matching a --forbid
+pattern is linked (e.g. ^esp_wifi_ to keep Wi-Fi out of the image). --compare diffs two builds;
+each side may be a saved --json report or an ELF (with its .map next to it).
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+# Section name prefix -> memory region
+REGIONS = [
+    (".iram0", "iram"),
+    (".dram0.bss", "dram_bss"),
+    (".noinit", "dram_bss"),
+    (".dram0", "dram_data"),
+    (".flash.text", "flash_code"),
+    (".flash.", "flash_rodata"),
+    (".rtc", "rtc"),
+    (".ext_ram", "psram"),
+]
+
+# Address ranges used to classify input sections from the map file
+ADDRESS_RANGES = [
+    (0x40070000, 0x400A0000, "iram"),
+    (0x3FFAE000, 0x40000000, "dram"),
+    (0x400C2000, 0x40C00000, "flash_code"),
+    (0x3F400000, 0x3F800000, "flash_rodata"),
+    (0x3F800000, 0x3FC00000, "psram"),
+]
+
+SHT_SYMTAB = 2
+STT_OBJECT = 1
+STT_FUNC = 2
+
+
+def region_for_section(name):
+    for prefix, region in REGIONS:
+        if name.startswith(prefix):
+            return region
+    return None
+
+
+def region_for_address(addr):
+    for lo, hi, region in ADDRESS_RANGES:
+        if lo <= addr < hi:
+            return region
+    return None
+
+
+def read_elf(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\x7fELF" or data[4] != 1:
+        sys.exit("%s: not a 32-bit ELF file" % path)
+    (shoff,) = struct.unpack_from("<I", data, 32)
+    shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 46)
+    sections = [struct.unpack_from("<IIIIIIIIII", data, shoff + i * shentsize) for i in range(shnum)]
+    shstr = sections[shstrndx]
+
+    def cstr(offset):
+        end = data.index(b"\0", offset)
+        return data[offset:end].decode("latin-1")
+
+    names = [cstr(shstr[4] + s[0]) for s in sections]
+
+    regions = {}
+    for name, s in zip(names, sections):
+        region = region_for_section(name)
+        if region and s[5]:
+            regions[region] = regions.get(region, 0) + s[5]
+
+    symbols = []
+    for s in sections:
+        if s[1] != SHT_SYMTAB:
+            continue
+        strtab = sections[s[6]]
+        for off in range(s[4], s[4] + s[5], 16):
+            st_name, value, size, info, _other, shndx = struct.unpack_from("<IIIBBH", data, off)
+            if size == 0 or (info & 0xF) not in (STT_OBJECT, STT_FUNC) or shndx >= len(sections):
+                continue
+            region = region_for_section(names[shndx])
+            if region:
+                symbols.append((cstr(strtab[4] + st_name), region, size))
+    return regions, symbols
+
+
+def read_map(path):
+    """Sum input section sizes per archive (library) and memory region."""
+    libraries = {}
+    pending = None
+    line_re = re.compile(r"^\s(\.\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+    in_map = False
+    with open(path, errors="replace") as f:
+        for line in f:
+            if not in_map:
+                in_map = line.startswith("Linker script and memory map")
+                continue
+            stripped = line.rstrip("\n")
+            if re.match(r"^\s\.\S+$", stripped):
+                pending = stripped.strip()
+                continue
+            m = line_re.match(stripped)
+            if not m:
+                pending = None
+                continue
+            section = m.group(1) or pending
+            pending = None
+            if section is None or section.startswith(".debug") or section.startswith(".xt."):
+                continue
+            addr, size, source = int(m.group(2), 16), int(m.group(3), 16), m.group(4).strip()
+            region = region_for_address(addr)
+            if not region or size == 0:
+                continue
+            archive = re.match(r"(.*?)\(.*\)$", source)
+            if archive:
+                lib = os.path.basename(archive.group(1))
+            else:
+                lib = os.path.basename(os.path.dirname(source)) or source
+            entry = libraries.setdefault(lib, {})
+            entry[region] = entry.get(region, 0) + size
+    return libraries
+
+
+def build_report(elf, map_path, top):
+    regions, symbols = read_elf(elf)
+    totals = {
+        "flash": sum(regions.get(r, 0) for r in ("flash_code", "flash_rodata", "iram", "dram_data")),
+        "dram": regions.get("dram_data", 0) + regions.get("dram_bss", 0),
+        "iram": regions.get("iram", 0),
+    }
+    symbols.sort(key=lambda s: s[2], reverse=True)
+    report = {
+        "elf": elf,
+        "totals": totals,
+        "regions": regions,
+        "symbols": [{"name": n, "region": r, "size": s} for n, r, s in symbols[:top]],
+        "libraries": {},
+    }
+    if map_path and os.path.exists(map_path):
+        report["libraries"] = read_map(map_path)
+    return report
+
+
+def load(path, top):
+    if path.endswith(".json"):
+        with open(path) as f:
+            return json.load(f)
+    return build_report(path, os.path.splitext(path)[0] + ".map", top)
+
+
+def lib_total(sizes):
+    return sum(sizes.values())
+
+
+def print_totals(report):
+    t = report["totals"]
+    print("Flash image %9d bytes" % t["flash"])
+    print("Static DRAM %9d bytes" % t["dram"])
+    print("IRAM        %9d bytes" % t["iram"])
+
+
+def print_report(report, top):
+    print_totals(report)
+    print()
+    print("%-14s %9s" % ("region", "bytes"))
+    for region, size in sorted(report["regions"].items()):
+        print("%-14s %9d" % (region, size))
+
+    libs = report["libraries"]
+    if libs:
+        print()
+        print("%-40s %9s %9s %9s %9s %9s" % ("library", "code", "rodata", "iram", "dram", "total"))
+        for lib, sizes in sorted(libs.items(), key=lambda kv: lib_total(kv[1]), reverse=True)[:top]:
+            print("%-40s %9d %9d %9d %9d %9d" % (lib[:40], sizes.get("flash_code", 0), sizes.get("flash_rodata", 0),
+                                                 sizes.get("iram", 0), sizes.get("dram", 0), lib_total(sizes)))
+
+    print()
+    print("%-60s %-13s %7s" % ("symbol", "region", "bytes"))
+    for s in report["symbols"][:top]:
+        print("%-60s %-13s %7d" % (s["name"][:60], s["region"], s["size"]))
+
+
+def print_compare(old, new, top):
+    print("%-14s %10s %10s %9s" % ("total", "old", "new", "delta"))
+    for key in ("flash", "dram", "iram"):
+        a, b = old["totals"].get(key, 0), new["totals"].get(key, 0)
+        print("%-14s %10d %10d %+9d" % (key, a, b, b - a))
+
+    old_libs, new_libs = old.get("libraries", {}), new.get("libraries", {})
+    deltas = []
+    for lib in set(old_libs) | set(new_libs):
+        a, b = lib_total(old_libs.get(lib, {})), lib_total(new_libs.get(lib, {}))
+        if a != b:
+            deltas.append((lib, a, b))
+    if deltas:
+        print()
+        print("%-40s %10s %10s %9s" % ("library", "old", "new", "delta"))
+        for lib, a, b in sorted(deltas, key=lambda d: abs(d[2] - d[1]), reverse=True)[:top]:
+            print("%-40s %10d %10d %+9d" % (lib[:40], a, b, b - a))
+
+    old_syms = {s["name"]: s["size"] for s in old.get("symbols", [])}
+    new_syms = {s["name"]: s["size"] for s in new.get("symbols", [])}
+    deltas = [(n, old_syms.get(n, 0), new_syms.get(n, 0)) for n in set(old_syms) | set(new_syms)
+              if old_syms.get(n, 0) != new_syms.get(n, 0)]
+    if deltas:
+        print()
+        print("%-60s %8s %8s %8s" % ("symbol (top of either build)", "old", "new", "delta"))
+        for n, a, b in sorted(deltas, key=lambda d: abs(d[2] - d[1]), reverse=True)[:top]:
+            print("%-60s %8d %8d %+8d" % (n[:60], a, b, b - a))
+
+
+def check_budgets(report, budgets):
+    failed = False
+    for key, limit in budgets.items():
+        if limit is None:
+            continue
+        used = report["totals"][key]
+        status = "OK" if used <= limit else "OVER BUDGET"
+        print("budget %-5s %9d / %9d bytes (%5.1f%%) %s" % (key, used, limit, 100.0 * used / limit, status))
+        failed |= used > limit
+    return not failed
+
+
+def check_forbidden(elf, patterns):
+    if not patterns:
+        return True
+    _, symbols = read_elf(elf)
+    regexes = [re.compile(p) for p in patterns]
+    hits = sorted({name for name, _, _ in symbols if any(r.search(name) for r in regexes)})
+    for name in hits[:20]:
+        print("forbidden symbol linked: %s" % name)
+    if len(hits) > 20:
+        print("... and %d more" % (len(hits) - 20))
+    return not hits
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", nargs="?", help="firmware ELF to analyse")
+    parser.add_argument("--map", help="linker map (default: <elf>.map)")
+    parser.add_argument("--top", type=int, default=25, help="rows in the library and symbol tables")
+    parser.add_argument("--summary", action="store_true", help="print totals and budgets only")
+    parser.add_argument("--json", metavar="FILE", help="write the report as JSON for later --compare")
+    parser.add_argument("--compare", nargs=2, metavar=("OLD", "NEW"), help="diff two builds")
+    parser.add_argument("--budget-flash", type=int)
+    parser.add_argument("--budget-dram", type=int)
+    parser.add_argument("--budget-iram", type=int)
+    parser.add_argument("--forbid", action="append", metavar="REGEX", help="fail if a matching symbol is linked")
+    args = parser.parse_args()
+
+    if args.compare:
+        print_compare(load(args.compare[0], 200), load(args.compare[1], 200), args.top)
+        return 0
+    if not args.elf:
+        parser.error("an ELF file or --compare is required")
+
+    map_path = args.map or os.path.splitext(args.elf)[0] + ".map"
+    # Keep more symbols in the JSON than are printed so comparisons see small movers
+    report = build_report(args.elf, map_path, max(args.top, 200))
+    if args.summary:
+        print_totals(report)
+    else:
+        print_report(report, args.top)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(report, f, indent=1)
+
+    print()
+    ok = check_budgets(report, {"flash": args.budget_flash, "dram": args.budget_dram, "iram": args.budget_iram})
+    ok &= check_forbidden(args.elf, args.forbid)
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Decode binary trace dumps produced by the firmware "trace" serial command.
+
+Usage:
+    tools/trace_decode.py capture.log                 # readable log on stdout
+    tools/trace_decode.py capture.log --chrome out.json
+
+The capture is any serial log containing a TRACE-BEGIN ... TRACE-END block
+(the last block is decoded). Event names and format strings come from
+include/TraceEvents.def, so the firmware image only carries numeric ids.
+Open the Chrome trace JSON in chrome://tracing or https://ui.perfetto.dev.
+The two cores' cycle counters are not synchronized, so each core is timed
+from its own first event and shown as its own process: ordering within a
+core is exact, ordering across cores is not.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+RECORD = struct.Struct("<IHHII")
+CORE1_FLAG = 0x8000
+DEFAULT_DEF = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "include", "TraceEvents.def")
+FIELD = re.compile(r"\{a([012])(?::([dx]))?\}")
+
+
+def load_events(path):
+    events = []
+    pattern = re.compile(r'^\s*TRACE_EVENT\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+    with open(path) as f:
+        for line in f:
+            m = pattern.match(line)
+            if m:
+                events.append((m.group(1), m.group(2)))
+    return events
+
+
+def read_dump(path):
+    header = None
+    records = []
+    current = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("TRACE-BEGIN"):
+                header = dict(kv.split("=", 1) for kv in line.split()[1:])
+                current = []
+            elif line.startswith("TRACE-END") and current is not None:
+                records = current
+                current = None
+            elif current is not None and line.startswith("T "):
+                current.append(RECORD.unpack(bytes.fromhex(line[2:])))
+    if header is None:
+        sys.exit("no TRACE-BEGIN block found in %s" % path)
+    return header, records
+
+
+def format_args(fmt, args):
+    def field(m):
+        value = args[int(m.group(1))]
+        if m.group(2) == "d":
+            return str(value - (1 << 32) if value >= (1 << 31) else value)
+        if m.group(2) == "x":
+            return "0x%x" % value
+        return str(value)
+    return FIELD.sub(field, fmt)
+
+
+def decode(events, header, records):
+    cycles_per_us = float(header.get("cpu_mhz", 240))
+    last = {}
+    offset = {}
+    base = {}
+    out = []
+    for timestamp, raw_id, a0, a1, a2 in records:
+        core = 1 if raw_id & CORE1_FLAG else 0
+        event_id = raw_id & ~CORE1_FLAG
+        # Each core has its own 32-bit cycle counter, not synchronized with the
+        # other's: unwrap them separately and time each from its own first event.
+        # Only a jump of more than half the range is a wrap; a smaller one is a
+        # record written slightly out of order by a concurrent writer.
+        cycles = timestamp + offset.get(core, 0)
+        if core in last:
+            if cycles < last[core] - (1 << 31):
+                offset[core] = offset.get(core, 0) + (1 << 32)
+                cycles += 1 << 32
+            elif cycles > last[core] + (1 << 31):
+                cycles -= 1 << 32       # late record from before the last wrap
+        last[core] = max(last.get(core, cycles), cycles)
+        base.setdefault(core, cycles)
+        name, fmt = events[event_id] if event_id < len(events) else ("EVENT_%d" % event_id, "{a0} {a1} {a2}")
+        out.append({
+            "us": (cycles - base[core]) / cycles_per_us,
+            "core": core,
+            "name": name,
+            "text": format_args(fmt, (a0, a1, a2)),
+            "args": {"a0": a0, "a1": a1, "a2": a2},
+        })
+    return out
+
+
+def chrome_trace(decoded):
+    # One process per core, since their clocks are not aligned
+    trace = [{"name": "process_name", "ph": "M", "pid": core, "args": {"name": "core %d (own clock)" % core}}
+             for core in sorted({e["core"] for e in decoded})]
+    for e in decoded:
+        name = e["name"]
+        item = {"name": e["text"], "cat": name, "pid": e["core"], "tid": 0, "ts": e["us"], "args": e["args"]}
+        if name.endswith("_BEGIN"):
+            item["ph"] = "B"
+        elif name.endswith("_END"):
+            item["ph"] = "E"
+        else:
+            item["ph"] = "i"
+            item["s"] = "t"
+        trace.append(item)
+    return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", help="serial log containing a trace dump")
+    parser.add_argument("--events", default=DEFAULT_DEF, help="path to TraceEvents.def")
+    parser.add_argument("--chrome", metavar="FILE", help="also write Chrome trace JSON to FILE")
+    args = parser.parse_args()
+
+    events = load_events(args.events)
+    header, records = read_dump(args.capture)
+    decoded = decode(events, header, records)
+
+    if header.get("dropped", "0") != "0":
+        print("# %s older events were overwritten" % header["dropped"])
+    print("# times count from each core's first event; the two cores' clocks are not aligned")
+    for e in decoded:
+        print("%12.3f us  c%d  %-22s %s" % (e["us"], e["core"], e["name"], e["text"]))
+
+    if args.chrome:
+        with open(args.chrome, "w") as f:
+            json.dump(chrome_trace(decoded), f)
+
+
+if __name__ == "__main__":
+    main()